@@ -0,0 +1,31 @@
+# ------------------------------------------------------------------------
+#
+#                     cline_codegen.cmake for cline_utils
+#                                        V 0.01
+#
+#                            (c) Brian Lynch February, 2015
+#
+# ------------------------------------------------------------------------
+
+# cline_generate_options(<target> <schema file> <namespace>)
+#
+# Runs cline_codegen on the schema at build time and makes the generated
+# <namespace>_options.h header available to <target>. The header is
+# regenerated whenever the schema or the generator changes.
+function(cline_generate_options TARGET SCHEMA NAMESPACE)
+   get_filename_component(schema_path ${SCHEMA} ABSOLUTE)
+   set(generated_dir ${CMAKE_CURRENT_BINARY_DIR}/cline_generated)
+   set(generated_header ${generated_dir}/${NAMESPACE}_options.h)
+
+   add_custom_command(
+      OUTPUT  ${generated_header}
+      COMMAND ${CMAKE_COMMAND} -E make_directory ${generated_dir}
+      COMMAND cline_codegen ${schema_path} ${generated_header} ${NAMESPACE}
+      DEPENDS cline_codegen ${schema_path}
+      COMMENT "Generating ${NAMESPACE}_options.h from ${SCHEMA}"
+      VERBATIM
+                     )
+
+   target_sources(${TARGET} PRIVATE ${generated_header})
+   target_include_directories(${TARGET} PRIVATE ${generated_dir})
+endfunction()
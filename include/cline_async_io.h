@@ -0,0 +1,655 @@
+// -----------------------------------------------------------------------
+//
+//                          cline_async_io.h V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#ifndef cline_async_io_h
+#define cline_async_io_h
+
+#include <cerrno>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+#include "cline_thread_pool.h"
+
+namespace cline_utils
+{
+   /************************************************************************/
+   /*
+   * \brief Minimal io_uring ring on the raw system calls (no liburing).
+   *        Single threaded use only. valid() is false if the kernel or a
+   *        seccomp filter refuses io_uring; callers then fall back to threads.
+   *
+   */
+   class io_uring_ring
+   {
+      private:
+
+         int fd = -1;
+         unsigned features = 0;
+
+         void *sq_ring = MAP_FAILED;
+         void *cq_ring = MAP_FAILED;
+         size_t sq_ring_size = 0;
+         size_t cq_ring_size = 0;
+         io_uring_sqe *sqes = (io_uring_sqe *)MAP_FAILED;
+         size_t sqes_size = 0;
+
+         unsigned *sq_head = NULL, *sq_tail = NULL, *sq_mask = NULL, *sq_array = NULL;
+         unsigned *cq_head = NULL, *cq_tail = NULL, *cq_mask = NULL;
+         io_uring_cqe *cqes = NULL;
+
+         unsigned entries = 0;
+         unsigned queued = 0; /**< Prepared but not yet submitted */
+
+      public:
+
+         /************************************************************************/
+         /*
+         * \brief Create a ring
+         *
+         *     @param[in] unsigned entries_: Submission queue size (rounded up to a power of 2 by the kernel)
+         *
+         */
+         explicit io_uring_ring(unsigned entries_)
+         {
+            io_uring_params params;
+            memset(&params, 0, sizeof(params));
+            this->fd = syscall(__NR_io_uring_setup, entries_, &params);
+            if(0 > this->fd)
+            {
+               this->fd = -1;
+               return;
+            }
+            this->features = params.features;
+            this->entries = params.sq_entries;
+
+            this->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            this->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            if(params.features & IORING_FEAT_SINGLE_MMAP)
+            {
+               this->sq_ring_size = this->cq_ring_size = std::max(this->sq_ring_size, this->cq_ring_size);
+            }
+
+            this->sq_ring = mmap(NULL, this->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->fd, IORING_OFF_SQ_RING);
+            this->cq_ring = (params.features & IORING_FEAT_SINGLE_MMAP) ? this->sq_ring :
+               mmap(NULL, this->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->fd, IORING_OFF_CQ_RING);
+            this->sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+            this->sqes = (io_uring_sqe *)mmap(NULL, this->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->fd, IORING_OFF_SQES);
+            if(MAP_FAILED == this->sq_ring || MAP_FAILED == this->cq_ring || MAP_FAILED == (void *)this->sqes)
+            {
+               this->release();
+               return;
+            }
+
+            char *sq = (char *)this->sq_ring;
+            this->sq_head  = (unsigned *)(sq + params.sq_off.head);
+            this->sq_tail  = (unsigned *)(sq + params.sq_off.tail);
+            this->sq_mask  = (unsigned *)(sq + params.sq_off.ring_mask);
+            this->sq_array = (unsigned *)(sq + params.sq_off.array);
+
+            char *cq = (char *)this->cq_ring;
+            this->cq_head = (unsigned *)(cq + params.cq_off.head);
+            this->cq_tail = (unsigned *)(cq + params.cq_off.tail);
+            this->cq_mask = (unsigned *)(cq + params.cq_off.ring_mask);
+            this->cqes    = (io_uring_cqe *)(cq + params.cq_off.cqes);
+         }
+
+         io_uring_ring(const io_uring_ring &) = delete;
+         io_uring_ring &operator=(const io_uring_ring &) = delete;
+
+         ~io_uring_ring()
+         {
+            this->release();
+         }
+
+         bool valid() const { return(0 <= this->fd); }
+         unsigned capacity() const { return(this->entries); }
+
+         /** Reads and writes at offset -1 use the file position */
+         bool has_current_position() const { return(0 != (this->features & IORING_FEAT_RW_CUR_POS)); }
+
+         /************************************************************************/
+         /*
+         * \brief Next free submission entry, zeroed, or NULL if the queue is full
+         *
+         */
+         io_uring_sqe *get_sqe()
+         {
+            unsigned head = __atomic_load_n(this->sq_head, __ATOMIC_ACQUIRE);
+            unsigned tail = *this->sq_tail + this->queued;
+            if(tail - head >= this->entries)
+            {
+               return(NULL);
+            }
+            unsigned index = tail & *this->sq_mask;
+            this->sq_array[index] = index;
+            ++this->queued;
+            memset(&this->sqes[index], 0, sizeof(io_uring_sqe));
+            return(&this->sqes[index]);
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Submit the prepared entries, optionally waiting for completions
+         *
+         *     @param[in] unsigned wait_for: Completions to wait for (0 returns at once)
+         *     @return int: Entries submitted, or -errno
+         *
+         */
+         int submit(unsigned wait_for = 0)
+         {
+            __atomic_store_n(this->sq_tail, *this->sq_tail + this->queued, __ATOMIC_RELEASE);
+            unsigned to_submit = this->queued;
+            this->queued = 0;
+
+            while(true)
+            {
+               int result = syscall(__NR_io_uring_enter, this->fd, to_submit, wait_for, (0 < wait_for) ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+               if(0 <= result || EINTR != errno)
+               {
+                  return((0 <= result) ? result : -errno);
+               }
+               to_submit = 0;
+            }
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Take one completion if there is one
+         *
+         */
+         bool pop(io_uring_cqe &cqe)
+         {
+            unsigned head = *this->cq_head;
+            if(head == __atomic_load_n(this->cq_tail, __ATOMIC_ACQUIRE))
+            {
+               return(false);
+            }
+            cqe = this->cqes[head & *this->cq_mask];
+            __atomic_store_n(this->cq_head, head + 1, __ATOMIC_RELEASE);
+            return(true);
+         }
+
+      private:
+
+         void release()
+         {
+            if(MAP_FAILED != (void *)this->sqes) munmap(this->sqes, this->sqes_size);
+            if(MAP_FAILED != this->cq_ring && this->cq_ring != this->sq_ring) munmap(this->cq_ring, this->cq_ring_size);
+            if(MAP_FAILED != this->sq_ring) munmap(this->sq_ring, this->sq_ring_size);
+            this->sqes = (io_uring_sqe *)MAP_FAILED;
+            this->cq_ring = this->sq_ring = MAP_FAILED;
+            if(0 <= this->fd) close(this->fd);
+            this->fd = -1;
+         }
+   };
+
+   /************************************************************************/
+   /*
+   * \brief Whole file read by a file_batch
+   *
+   */
+   struct loaded_file
+   {
+      typedef std::pmr::polymorphic_allocator<char> allocator_type;
+
+      std::pmr::string path;
+      std::pmr::string data;
+      int error = 0; /**< errno of the failed open or read, 0 on success */
+
+      explicit loaded_file(const allocator_type &alloc = allocator_type()) : path(alloc), data(alloc) {}
+      loaded_file(const loaded_file &other, const allocator_type &alloc = allocator_type())
+         : path(other.path, alloc), data(other.data, alloc), error(other.error) {}
+      loaded_file(loaded_file &&other) = default;
+      loaded_file(loaded_file &&other, const allocator_type &alloc)
+         : path(std::move(other.path), alloc), data(std::move(other.data), alloc), error(other.error) {}
+      loaded_file &operator=(const loaded_file &other) = default;
+      loaded_file &operator=(loaded_file &&other) = default;
+   };
+
+   /************************************************************************/
+   /*
+   * \brief Reads a set of whole files concurrently. The constructor issues
+   *        every open and stat at once and returns, so the caller can do other
+   *        work (tokenizing argv) while the kernel waits on the disk or the
+   *        network; wait() reads the contents and returns them in request
+   *        order. Uses io_uring, or blocking reads on the shared thread pool
+   *        where io_uring is unavailable or disabled.
+   *
+   *        Paths, buffers and ring state come from the memory resource, which
+   *        is only used on the thread that owns the batch. The thread pool
+   *        workers read into buffers of their own on the global heap.
+   *
+   */
+   class file_batch
+   {
+      public:
+
+         enum backend_kind
+         {
+            backend_io_uring    = 0,
+            backend_thread_pool = 1
+         };
+
+      private:
+
+         /** Per file progress through open + statx -> read ... -> close */
+         struct file_state
+         {
+            int fd = -1;
+            int pending = 0;        /**< Operations in flight */
+            bool started = false;
+            bool finished = false;
+            bool regular = true;
+            size_t filled = 0;
+            struct statx stat;
+         };
+
+         enum operation : uint64_t
+         {
+            op_open  = 0,
+            op_statx = 1,
+            op_read  = 2
+         };
+
+         std::pmr::vector<cline_utils::loaded_file> files;
+         backend_kind backend_used = backend_thread_pool;
+
+         std::optional<cline_utils::io_uring_ring> ring;
+         std::pmr::vector<file_state> states;
+         size_t next_to_start = 0;
+         size_t unfinished = 0;
+         size_t in_flight = 0; /**< Operations submitted or queued, bounded by the ring size so completions never overflow */
+
+         std::vector<std::future<void>> blocking_reads;
+         std::vector<std::string> blocking_data; /**< Contents read by the workers, copied into files by wait() */
+
+         /************************************************************************/
+         /*
+         * \brief Blocking read of one whole file
+         *
+         *     @param[in] const char *path: File to read
+         *     @param[out] Buffer &data: Contents
+         *     @return int: errno of the failed open or read, 0 on success
+         *
+         */
+         template <typename Buffer>
+         static int read_blocking(const char *path, Buffer &data)
+         {
+            int fd = open(path, O_RDONLY | O_CLOEXEC);
+            if(0 > fd)
+            {
+               return(errno);
+            }
+
+            struct stat st;
+            size_t chunk = (0 == fstat(fd, &st) && S_ISREG(st.st_mode)) ? size_t(st.st_size) + 1 : 4096;
+            size_t filled = 0;
+            int error = 0;
+            while(true)
+            {
+               data.resize(filled + chunk);
+               ssize_t got = read(fd, &data[filled], chunk);
+               if(0 > got && EINTR == errno) continue;
+               if(0 > got)
+               {
+                  error = errno;
+                  break;
+               }
+               if(0 == got) break;
+               filled += got;
+               chunk = std::max(chunk, filled);
+            }
+            data.resize(filled);
+            close(fd);
+            return(error);
+         }
+
+         static uint64_t tag(size_t index, operation op) { return((uint64_t(index) << 2) | op); }
+
+         /************************************************************************/
+         /*
+         * \brief Queue open and statx for as many files as the ring has room for
+         *
+         */
+         void start_files()
+         {
+            while(this->next_to_start < this->files.size())
+            {
+               if(this->in_flight + 2 > this->ring->capacity())
+               {
+                  return;
+               }
+
+               const size_t index = this->next_to_start;
+               io_uring_sqe *open_sqe = this->ring->get_sqe();
+               io_uring_sqe *statx_sqe = (NULL == open_sqe) ? NULL : this->ring->get_sqe();
+               if(NULL == statx_sqe)
+               {
+                  return;
+               }
+
+               open_sqe->opcode = IORING_OP_OPENAT;
+               open_sqe->fd = AT_FDCWD;
+               open_sqe->addr = (uint64_t)this->files[index].path.c_str();
+               open_sqe->open_flags = O_RDONLY | O_CLOEXEC;
+               open_sqe->user_data = tag(index, op_open);
+
+               statx_sqe->opcode = IORING_OP_STATX;
+               statx_sqe->fd = AT_FDCWD;
+               statx_sqe->addr = (uint64_t)this->files[index].path.c_str();
+               statx_sqe->len = STATX_TYPE | STATX_SIZE;
+               statx_sqe->off = (uint64_t)&this->states[index].stat;
+               statx_sqe->user_data = tag(index, op_statx);
+
+               this->states[index].pending = 2;
+               this->in_flight += 2;
+               this->states[index].started = true;
+               ++this->next_to_start;
+            }
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Queue the next read of an opened file into the spare capacity
+         *        of its buffer, growing it first if it is full
+         *
+         */
+         void queue_read(size_t index)
+         {
+            file_state &state = this->states[index];
+            std::pmr::string &data = this->files[index].data;
+            if(state.filled == data.size())
+            {
+               data.resize(std::max(2 * data.size(), size_t(4096)));
+            }
+
+            io_uring_sqe *sqe = this->ring->get_sqe();
+            if(NULL == sqe)
+            {
+               // Cannot happen while in_flight is bounded by the ring size
+               this->finish(index, EBUSY);
+               return;
+            }
+            sqe->opcode = IORING_OP_READ;
+            sqe->fd = state.fd;
+            sqe->addr = (uint64_t)&data[state.filled];
+            sqe->len = data.size() - state.filled;
+            sqe->off = this->ring->has_current_position() ? uint64_t(-1) : state.filled;
+            sqe->user_data = tag(index, op_read);
+            ++state.pending;
+            ++this->in_flight;
+         }
+
+         void finish(size_t index, int error)
+         {
+            file_state &state = this->states[index];
+            if(state.finished) return;
+            state.finished = true;
+            if(0 <= state.fd) close(state.fd);
+            state.fd = -1;
+            this->files[index].error = error;
+            this->files[index].data.resize((0 == error) ? state.filled : 0);
+            --this->unfinished;
+         }
+
+         void complete(const io_uring_cqe &cqe)
+         {
+            const size_t index = cqe.user_data >> 2;
+            const operation op = operation(cqe.user_data & 3);
+            file_state &state = this->states[index];
+            --state.pending;
+            --this->in_flight;
+
+            if(state.finished)
+            {
+               // The other half of a failed open / statx pair
+               if(op_open == op && 0 <= cqe.res) close(cqe.res);
+               return;
+            }
+
+            switch(op)
+            {
+               case op_open:
+                  if(0 > cqe.res)
+                  {
+                     this->finish(index, -cqe.res);
+                     return;
+                  }
+                  state.fd = cqe.res;
+                  break;
+
+               case op_statx:
+                  if(0 > cqe.res)
+                  {
+                     this->finish(index, -cqe.res);
+                     return;
+                  }
+                  state.regular = S_ISREG(state.stat.stx_mode);
+                  this->files[index].data.resize(state.regular ? size_t(state.stat.stx_size) + 1 : 4096);
+                  break;
+
+               case op_read:
+                  if(0 > cqe.res)
+                  {
+                     // Pipes and the like without a file position on old kernels
+                     if(ESPIPE == -cqe.res || EINVAL == -cqe.res)
+                     {
+                        close(state.fd);
+                        state.fd = -1;
+                        cline_utils::loaded_file &file = this->files[index];
+                        file.data.clear();
+                        file.error = read_blocking(file.path.c_str(), file.data);
+                        state.filled = file.data.size();
+                        this->finish(index, file.error);
+                        return;
+                     }
+                     this->finish(index, -cqe.res);
+                     return;
+                  }
+                  state.filled += cqe.res;
+                  // A short read of a regular file is its end
+                  if(0 == cqe.res || (state.regular && state.filled < this->files[index].data.size()))
+                  {
+                     this->finish(index, 0);
+                     return;
+                  }
+                  break;
+            }
+
+            // Read once both the descriptor and the size are known
+            if(0 == state.pending && 0 <= state.fd)
+            {
+               this->queue_read(index);
+            }
+         }
+
+      public:
+
+         /************************************************************************/
+         /*
+         * \brief Start reading files
+         *
+         *     @param[in] std::pmr::vector<std::pmr::string> &paths: Files to read
+         *     @param[in] bool allow_io_uring: False forces the thread pool backend
+         *     @param[in] std::pmr::memory_resource *resource: Backs the paths, buffers and ring state
+         *
+         */
+         explicit file_batch(const std::pmr::vector<std::pmr::string> &paths, bool allow_io_uring = true,
+                             std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+            : files(resource), states(resource)
+         {
+            this->files.resize(paths.size());
+            for(size_t i = 0; i < paths.size(); ++i)
+            {
+               this->files[i].path = paths[i];
+            }
+            if(this->files.empty())
+            {
+               return;
+            }
+
+            if(allow_io_uring)
+            {
+               unsigned entries = 8;
+               while(entries < 2 * this->files.size() && entries < 1024) entries *= 2;
+               this->ring.emplace(entries);
+               if(false == this->ring->valid())
+               {
+                  this->ring.reset();
+               }
+            }
+
+            if(this->ring.has_value())
+            {
+               this->backend_used = backend_io_uring;
+               this->states.resize(this->files.size());
+               this->unfinished = this->files.size();
+               this->start_files();
+               if(0 > this->ring->submit())
+               {
+                  // Refused at submit time: nothing is in flight, use threads
+                  this->ring.reset();
+                  this->states.clear();
+               }
+            }
+
+            if(false == this->ring.has_value())
+            {
+               this->backend_used = backend_thread_pool;
+               cline_utils::thread_pool &pool = cline_utils::thread_pool::shared();
+               this->blocking_data.resize(this->files.size());
+               for(size_t i = 0; i < this->files.size(); ++i)
+               {
+                  this->blocking_reads.push_back(pool.submit([this, i] { this->files[i].error = read_blocking(this->files[i].path.c_str(), this->blocking_data[i]); }));
+               }
+            }
+         }
+
+         file_batch(const file_batch &) = delete;
+         file_batch &operator=(const file_batch &) = delete;
+
+         ~file_batch()
+         {
+            // Buffers must outlive the kernel's and the workers' use of them
+            this->wait();
+         }
+
+         backend_kind backend() const { return(this->backend_used); }
+
+         /************************************************************************/
+         /*
+         * \brief Wait for every file
+         *
+         *     @return std::pmr::vector<loaded_file> &: One entry per path, in request order
+         *
+         */
+         std::pmr::vector<cline_utils::loaded_file> &wait()
+         {
+            for(std::future<void> &read : this->blocking_reads)
+            {
+               read.wait();
+            }
+            this->blocking_reads.clear();
+            for(size_t i = 0; i < this->blocking_data.size(); ++i)
+            {
+               this->files[i].data.assign(this->blocking_data[i]);
+            }
+            this->blocking_data.clear();
+
+            while(this->ring.has_value() && 0 < this->unfinished)
+            {
+               io_uring_cqe cqe;
+               bool any = false;
+               while(this->ring->pop(cqe))
+               {
+                  this->complete(cqe);
+                  any = true;
+               }
+               this->start_files();
+               if(0 == this->unfinished)
+               {
+                  break;
+               }
+               int result = this->ring->submit(any ? 0 : 1);
+               if(0 > result)
+               {
+                  // The ring broke down: finish what is left the blocking way
+                  for(size_t i = 0; i < this->files.size(); ++i)
+                  {
+                     if(this->states[i].finished) continue;
+                     if(0 < this->states[i].pending) continue; // Still owned by the kernel
+                     this->files[i].data.clear();
+                     this->files[i].error = read_blocking(this->files[i].path.c_str(), this->files[i].data);
+                     this->states[i].filled = this->files[i].data.size();
+                     this->finish(i, this->files[i].error);
+                  }
+                  if(0 < this->unfinished) this->ring->submit(1);
+               }
+            }
+
+            return(this->files);
+         }
+   };
+
+   /************************************************************************/
+   /*
+   * \brief Returns a file_batch to the memory resource it was allocated from
+   *
+   */
+   struct file_batch_deleter
+   {
+      std::pmr::memory_resource *resource = NULL;
+
+      void operator()(cline_utils::file_batch *batch) const
+      {
+         batch->~file_batch();
+         this->resource->deallocate(batch, sizeof(cline_utils::file_batch), alignof(cline_utils::file_batch));
+      }
+   };
+
+   typedef std::unique_ptr<cline_utils::file_batch, cline_utils::file_batch_deleter> file_batch_ptr;
+
+   /************************************************************************/
+   /*
+   * \brief Start a file_batch that lives in the memory resource
+   *
+   *     @param[in] std::pmr::vector<std::pmr::string> &paths: Files to read
+   *     @param[in] bool allow_io_uring: False forces the thread pool backend
+   *     @param[in] std::pmr::memory_resource *resource: Backs the batch and everything it holds
+   *     @return file_batch_ptr: Reads in flight
+   *
+   */
+   inline cline_utils::file_batch_ptr make_file_batch(const std::pmr::vector<std::pmr::string> &paths, bool allow_io_uring,
+                                                      std::pmr::memory_resource *resource)
+   {
+      void *memory = resource->allocate(sizeof(cline_utils::file_batch), alignof(cline_utils::file_batch));
+      try
+      {
+         return(cline_utils::file_batch_ptr(new(memory) cline_utils::file_batch(paths, allow_io_uring, resource), cline_utils::file_batch_deleter{resource}));
+      }
+      catch(...)
+      {
+         resource->deallocate(memory, sizeof(cline_utils::file_batch), alignof(cline_utils::file_batch));
+         throw;
+      }
+   }
+}
+
+#endif
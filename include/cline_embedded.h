@@ -0,0 +1,559 @@
+// -----------------------------------------------------------------------
+//
+//                          cline_embedded.h V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#ifndef cline_embedded_h
+#define cline_embedded_h
+
+// Deliberately free of cline_utils.h, iostreams, containers and exceptions:
+// builds with -fno-exceptions -fno-rtti and never touches the heap
+#include <charconv>
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+namespace cline_utils
+{
+   /************************************************************************/
+   /*
+   * \brief Result of an embedded_parser call
+   *
+   */
+   enum embedded_status : uint8_t
+   {
+      embedded_ok                   = 0,
+      embedded_help                 = 1, /**< -h or --help was given and is not a registered option */
+      embedded_unknown_option       = 2,
+      embedded_missing_argument     = 3,
+      embedded_unexpected_argument  = 4, /**< --flag=value */
+      embedded_bad_value            = 5, /**< Not a number, or out of range for the bound type */
+      embedded_duplicate_option     = 6,
+      embedded_missing_required     = 7,
+      embedded_too_many_positionals = 8,
+      embedded_too_many_options     = 9, /**< add_option() beyond MaxOptions */
+      embedded_duplicate_name       = 10 /**< add_option() with a name or character already in use */
+   };
+
+   /************************************************************************/
+   /*
+   * \brief Text of a status, for messages
+   *
+   */
+   inline const char *embedded_status_text(cline_utils::embedded_status status)
+   {
+      switch(status)
+      {
+         case embedded_ok:                   return("ok");
+         case embedded_help:                 return("help requested");
+         case embedded_unknown_option:       return("unknown option");
+         case embedded_missing_argument:     return("missing argument for option");
+         case embedded_unexpected_argument:  return("option does not take an argument");
+         case embedded_bad_value:            return("invalid value for option");
+         case embedded_duplicate_option:     return("option given more than once");
+         case embedded_missing_required:     return("missing required option");
+         case embedded_too_many_positionals: return("too many arguments");
+         case embedded_too_many_options:     return("too many options configured");
+         case embedded_duplicate_name:       return("option configured twice");
+      }
+      return("error");
+   }
+
+   /************************************************************************/
+   /*
+   * \brief Small fixed buffer in front of write(2)
+   *
+   */
+   class embedded_writer
+   {
+      private:
+
+         int fd;
+         size_t used = 0;
+         char buffer[256];
+
+      public:
+
+         explicit embedded_writer(int fd_) : fd(fd_) {}
+
+         ~embedded_writer() { this->flush(); }
+
+         embedded_writer(const embedded_writer &) = delete;
+         embedded_writer &operator=(const embedded_writer &) = delete;
+
+         embedded_writer &put(const char *text)
+         {
+            return(this->put(text, strlen(text)));
+         }
+
+         embedded_writer &put(const char *text, size_t length)
+         {
+            while(0 < length)
+            {
+               if(this->used == sizeof(this->buffer))
+               {
+                  this->flush();
+               }
+               size_t count = sizeof(this->buffer) - this->used;
+               count = (count < length) ? count : length;
+               memcpy(this->buffer + this->used, text, count);
+               this->used += count;
+               text += count;
+               length -= count;
+            }
+            return(*this);
+         }
+
+         embedded_writer &put(char c)
+         {
+            return(this->put(&c, 1));
+         }
+
+         /** Pad with spaces to width characters after having written length */
+         embedded_writer &pad(size_t length, size_t width)
+         {
+            for(; length < width; ++length) this->put(' ');
+            return(*this);
+         }
+
+         void flush()
+         {
+            size_t written = 0;
+            while(written < this->used)
+            {
+               ssize_t bytes = write(this->fd, this->buffer + written, this->used - written);
+               if(0 > bytes && EINTR == errno) continue;
+               if(0 >= bytes) break;
+               written += bytes;
+            }
+            this->used = 0;
+         }
+   };
+
+   /************************************************************************/
+   /*
+   * \brief Command line parser for small static tools and early boot code:
+   *        all storage is sized by the template parameters and lives in the
+   *        object, nothing is allocated, nothing is thrown and nothing goes
+   *        through iostreams. Options are bound to int, long long, double,
+   *        bool (a flag) or const char * (pointing into argv). Errors come
+   *        back as embedded_status codes; usage and error messages are
+   *        written with write(2).
+   *
+   *           static int count = 1; static const char *output = "out.txt"; static bool verbose = false;
+   *           cline_utils::embedded_parser<8, 4> cline;
+   *           cline.add_option("count", 'n', count, "Number of repetitions");
+   *           cline.add_option("output", 'o', output, "Output file", true);
+   *           cline.add_option("verbose", 'v', verbose, "Verbose output");
+   *           if(cline_utils::embedded_ok != cline.parse(argc, argv))
+   *           {
+   *              cline.print_error();
+   *              cline.print_usage(argv[0]);
+   *              return(1);
+   *           }
+   *
+   *        Accepts -n 3, -n3, -vn3, --count 3, --count=3, "--" and
+   *        positional arguments (at most MaxPositionals).
+   *
+   */
+   template <size_t MaxOptions, size_t MaxPositionals = 8>
+   class embedded_parser
+   {
+      public:
+
+         enum value_type : uint8_t
+         {
+            value_flag   = 0,
+            value_int    = 1,
+            value_long   = 2,
+            value_double = 3,
+            value_string = 4
+         };
+
+      private:
+
+         struct option_entry
+         {
+            const char *name;
+            const char *description;
+            void *data;
+            char short_name;    /**< '\0' for long only options */
+            value_type type;
+            bool required;
+            bool seen;
+         };
+
+         option_entry options[MaxOptions ? MaxOptions : 1];
+         size_t option_count = 0;
+
+         const char *positionals[MaxPositionals ? MaxPositionals : 1];
+         size_t positional_count = 0;
+
+         embedded_status last_status = embedded_ok;
+         const char *error_text = NULL;      /**< Token or option the last error is about */
+         size_t error_length = 0;
+
+         embedded_status fail(embedded_status status, const char *text, size_t length)
+         {
+            this->last_status = status;
+            this->error_text = text;
+            this->error_length = length;
+            return(status);
+         }
+
+         embedded_status fail(embedded_status status, const char *text)
+         {
+            return(this->fail(status, text, (NULL == text) ? 0 : strlen(text)));
+         }
+
+         embedded_status add(const char *name, char short_name, value_type type, void *data, const char *description, bool required)
+         {
+            if(MaxOptions <= this->option_count)
+            {
+               return(this->fail(embedded_too_many_options, name));
+            }
+            for(size_t i = 0; i < this->option_count; ++i)
+            {
+               if(0 == strcmp(this->options[i].name, name) || ('\0' != short_name && this->options[i].short_name == short_name))
+               {
+                  return(this->fail(embedded_duplicate_name, name));
+               }
+            }
+            this->options[this->option_count++] = {name, description, data, short_name, type, required, false};
+            return(embedded_ok);
+         }
+
+         option_entry *find_long(const char *name, size_t length)
+         {
+            for(size_t i = 0; i < this->option_count; ++i)
+            {
+               if(0 == strncmp(this->options[i].name, name, length) && '\0' == this->options[i].name[length])
+               {
+                  return(&this->options[i]);
+               }
+            }
+            return(NULL);
+         }
+
+         option_entry *find_short(char short_name)
+         {
+            for(size_t i = 0; i < this->option_count; ++i)
+            {
+               if(this->options[i].short_name == short_name)
+               {
+                  return(&this->options[i]);
+               }
+            }
+            return(NULL);
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Convert text into the variable bound to option
+         *
+         */
+         embedded_status store(option_entry &option, const char *text)
+         {
+            if(option.seen)
+            {
+               return(this->fail(embedded_duplicate_option, option.name));
+            }
+            option.seen = true;
+
+            const char *last = text + strlen(text);
+            switch(option.type)
+            {
+               case value_flag:
+                  *(bool *)option.data = true;
+                  return(embedded_ok);
+
+               case value_string:
+                  *(const char **)option.data = text;
+                  return(embedded_ok);
+
+               case value_int:    return(this->convert<int>(option, text, last));
+               case value_long:   return(this->convert<long long>(option, text, last));
+               case value_double: return(this->convert<double>(option, text, last));
+            }
+            return(embedded_ok);
+         }
+
+         /** The bound variable keeps its value unless all of text converts */
+         template <typename T>
+         embedded_status convert(option_entry &option, const char *text, const char *last)
+         {
+            T value{};
+            std::from_chars_result result = std::from_chars(text, last, value);
+            if(text == last || std::errc() != result.ec || last != result.ptr)
+            {
+               return(this->fail(embedded_bad_value, option.name));
+            }
+            *(T *)option.data = value;
+            return(embedded_ok);
+         }
+
+         embedded_status parse_long(int argc, char **argv, int &argv_index)
+         {
+            const char *name = argv[argv_index] + 2;
+            const char *equals = strchr(name, '=');
+            const size_t length = (NULL == equals) ? strlen(name) : size_t(equals - name);
+
+            option_entry *option = this->find_long(name, length);
+            if(NULL == option)
+            {
+               if(length == 4 && 0 == strncmp(name, "help", 4))
+               {
+                  return(this->fail(embedded_help, argv[argv_index]));
+               }
+               return(this->fail(embedded_unknown_option, argv[argv_index], length + 2));
+            }
+
+            if(value_flag == option->type)
+            {
+               if(NULL != equals)
+               {
+                  return(this->fail(embedded_unexpected_argument, option->name));
+               }
+               return(this->store(*option, ""));
+            }
+            if(NULL != equals)
+            {
+               return(this->store(*option, equals + 1));
+            }
+            if(argv_index + 1 >= argc)
+            {
+               return(this->fail(embedded_missing_argument, option->name));
+            }
+            return(this->store(*option, argv[++argv_index]));
+         }
+
+         embedded_status parse_short(int argc, char **argv, int &argv_index)
+         {
+            // A cluster of flags, the last character may take an argument: -vn3, -vn 3
+            for(const char *c = argv[argv_index] + 1; '\0' != *c; ++c)
+            {
+               option_entry *option = this->find_short(*c);
+               if(NULL == option)
+               {
+                  if('h' == *c)
+                  {
+                     return(this->fail(embedded_help, c, 1));
+                  }
+                  return(this->fail(embedded_unknown_option, c, 1));
+               }
+               if(value_flag == option->type)
+               {
+                  embedded_status status = this->store(*option, "");
+                  if(embedded_ok != status) return(status);
+                  continue;
+               }
+               if('\0' != c[1])
+               {
+                  return(this->store(*option, c + 1));
+               }
+               if(argv_index + 1 >= argc)
+               {
+                  return(this->fail(embedded_missing_argument, option->name));
+               }
+               return(this->store(*option, argv[++argv_index]));
+            }
+            return(embedded_ok);
+         }
+
+      public:
+
+         embedded_parser() = default;
+
+         /************************************************************************/
+         /*
+         * \brief Bind an option to a variable, which holds the default until parsed
+         *
+         *     @param[in] const char *name: Long name (not copied, must outlive the parser)
+         *     @param[in] char short_name: Option character, '\0' for long only options
+         *     @param[in] T &value: int, long long, double, bool (flag) or const char *
+         *     @param[in] const char *description: Usage text (not copied)
+         *     @param[in] bool required: Parse fails if the option is not given
+         *     @return embedded_status: embedded_ok, embedded_too_many_options or embedded_duplicate_name
+         *
+         */
+         embedded_status add_option(const char *name, char short_name, int &value, const char *description, bool required = false)
+         {
+            return(this->add(name, short_name, value_int, &value, description, required));
+         }
+
+         embedded_status add_option(const char *name, char short_name, long long &value, const char *description, bool required = false)
+         {
+            return(this->add(name, short_name, value_long, &value, description, required));
+         }
+
+         embedded_status add_option(const char *name, char short_name, double &value, const char *description, bool required = false)
+         {
+            return(this->add(name, short_name, value_double, &value, description, required));
+         }
+
+         embedded_status add_option(const char *name, char short_name, bool &value, const char *description, bool required = false)
+         {
+            return(this->add(name, short_name, value_flag, &value, description, required));
+         }
+
+         embedded_status add_option(const char *name, char short_name, const char *&value, const char *description, bool required = false)
+         {
+            return(this->add(name, short_name, value_string, &value, description, required));
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Parse the command line into the bound variables. Stops at the
+         *        first error; error_option() and print_error() describe it.
+         *
+         *     @param[in] int argc: Number of arguments (including the program name)
+         *     @param[in] char **argv: Arguments, must outlive the parsed values
+         *     @return embedded_status: embedded_ok or the first error
+         *
+         */
+         embedded_status parse(int argc, char **argv)
+         {
+            this->last_status = embedded_ok;
+            this->error_text = NULL;
+            this->error_length = 0;
+            this->positional_count = 0;
+            for(size_t i = 0; i < this->option_count; ++i)
+            {
+               this->options[i].seen = false;
+            }
+
+            bool options_done = false;
+            for(int argv_index = 1; argv_index < argc; ++argv_index)
+            {
+               const char *token = argv[argv_index];
+               embedded_status status = embedded_ok;
+               if(options_done || '-' != token[0] || '\0' == token[1])
+               {
+                  if(MaxPositionals <= this->positional_count)
+                  {
+                     return(this->fail(embedded_too_many_positionals, token));
+                  }
+                  this->positionals[this->positional_count++] = token;
+               }
+               else if('-' == token[1] && '\0' == token[2])
+               {
+                  options_done = true;
+               }
+               else if('-' == token[1])
+               {
+                  status = this->parse_long(argc, argv, argv_index);
+               }
+               else
+               {
+                  status = this->parse_short(argc, argv, argv_index);
+               }
+               if(embedded_ok != status)
+               {
+                  return(status);
+               }
+            }
+
+            for(size_t i = 0; i < this->option_count; ++i)
+            {
+               if(this->options[i].required && false == this->options[i].seen)
+               {
+                  return(this->fail(embedded_missing_required, this->options[i].name));
+               }
+            }
+            return(embedded_ok);
+         }
+
+         embedded_status status() const { return(this->last_status); }
+
+         size_t size() const { return(this->option_count); }
+
+         size_t positional_size() const { return(this->positional_count); }
+
+         const char *positional(size_t index) const { return(this->positionals[index]); }
+
+         /************************************************************************/
+         /*
+         * \brief True if the option with this long name was given in the last parse
+         *
+         */
+         bool given(const char *name) const
+         {
+            for(size_t i = 0; i < this->option_count; ++i)
+            {
+               if(0 == strcmp(this->options[i].name, name)) return(this->options[i].seen);
+            }
+            return(false);
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Write "error: <status text> '<option or token>'" of the last error
+         *
+         *     @param[in] int fd: Output descriptor, stderr by default
+         *     @return None.
+         *
+         */
+         void print_error(int fd = STDERR_FILENO) const
+         {
+            if(embedded_ok == this->last_status)
+            {
+               return;
+            }
+            embedded_writer out(fd);
+            out.put("error: ").put(embedded_status_text(this->last_status));
+            if(NULL != this->error_text)
+            {
+               out.put(" '").put(this->error_text, this->error_length).put('\'');
+            }
+            out.put('\n');
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Write one line per option: characters, names, required flag and
+         *        description
+         *
+         *     @param[in] const char *program: Program name for the first line
+         *     @param[in] int fd: Output descriptor, stdout by default
+         *     @return None.
+         *
+         */
+         void print_usage(const char *program, int fd = STDOUT_FILENO) const
+         {
+            static const char *const placeholders[] = {"", " <int>", " <int>", " <number>", " <text>"};
+
+            embedded_writer out(fd);
+            out.put("usage: ").put(program).put(" [options]");
+            if(0 < MaxPositionals)
+            {
+               out.put(" [arguments]");
+            }
+            out.put('\n');
+
+            for(size_t i = 0; i < this->option_count; ++i)
+            {
+               const option_entry &option = this->options[i];
+               out.put("  ");
+               if('\0' != option.short_name)
+               {
+                  out.put('-').put(option.short_name).put(", ");
+               }
+               else
+               {
+                  out.put("    ");
+               }
+               const size_t name_length = strlen(option.name) + strlen(placeholders[option.type]);
+               out.put("--").put(option.name).put(placeholders[option.type]).pad(name_length, 24);
+               out.put(option.required ? " (required) " : " ");
+               out.put((NULL == option.description) ? "" : option.description).put('\n');
+            }
+         }
+   };
+}
+
+#endif
@@ -0,0 +1,387 @@
+// -----------------------------------------------------------------------
+//
+//                            cline_glob.h V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#ifndef cline_glob_h
+#define cline_glob_h
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <dirent.h>    /* for the DT_ entry types of getdents64 */
+#include <fnmatch.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+#include "cline_thread_pool.h"
+
+namespace cline_utils
+{
+   /************************************************************************/
+   /*
+   * \brief Order of the paths a glob pattern expands to
+   *
+   */
+   enum glob_order : uint8_t
+   {
+      glob_sorted   = 0, /**< Byte wise sorted, like the shell */
+      glob_unsorted = 1  /**< Order of discovery, delivered as soon as found */
+   };
+
+   /************************************************************************/
+   /*
+   * \brief True if text contains a glob character (* ? [ or a \ escape)
+   *
+   */
+   inline bool has_glob_magic(std::string_view text)
+   {
+      return(std::string_view::npos != text.find_first_of("*?[\\"));
+   }
+
+   /************************************************************************/
+   /*
+   * \brief Expands one glob pattern by walking the directories it can reach
+   *        on the shared thread pool. Components are matched with fnmatch()
+   *        (a leading '.' must be matched explicitly); a "**" component
+   *        matches zero or more directories without following symbolic
+   *        links, a trailing "**" matches everything below; a trailing '/'
+   *        only matches directories. Literal components are stepped over
+   *        without reading their directory.
+   *
+   *        Directories are read with getdents64 into one fixed buffer per
+   *        worker. Pending directories are kept on a shared stack, so the
+   *        walk is mostly depth first: the stack holds the unvisited
+   *        subdirectories of the directories on the paths being walked. Each
+   *        worker also holds all matches and subdirectories of the directory
+   *        it is reading. Memory therefore grows with the number of entries
+   *        per directory along those paths, not just with the depth; a
+   *        directory of a million files is held whole. Matches of each
+   *        directory are handed to the sink in one batch, one batch at a
+   *        time. Unreadable directories are skipped, as the shell does.
+   *
+   */
+   class glob_walker
+   {
+      public:
+
+         typedef std::function<void(std::vector<std::string> &matches)> sink_function;
+
+      private:
+
+         std::string root;                    /**< Prefix of every result ("" for relative patterns) */
+         std::vector<std::string> components; /**< Pattern components below root */
+         std::vector<bool> literal;           /**< Component has no glob characters */
+         bool directories_only = false;
+
+         struct walk_state
+         {
+            std::mutex mutex;
+            std::condition_variable ready;
+            std::vector<std::pair<std::string, size_t>> pending; /**< (directory prefix, component) */
+            size_t busy = 0;
+            std::exception_ptr error;
+         };
+
+         struct linux_dirent64
+         {
+            uint64_t       d_ino;
+            int64_t        d_off;
+            unsigned short d_reclen;
+            unsigned char  d_type;
+            char           d_name[];
+         };
+
+         bool is_globstar(size_t index) const
+         {
+            return(index < this->components.size() && "**" == this->components[index]);
+         }
+
+         static bool is_directory(int dir_fd, const char *name, unsigned char type, bool follow)
+         {
+            if(DT_DIR == type) return(true);
+            if(DT_UNKNOWN != type && (DT_LNK != type || false == follow)) return(false);
+            struct stat info;
+            return(0 == fstatat(dir_fd, name, &info, follow ? 0 : AT_SYMLINK_NOFOLLOW) && S_ISDIR(info.st_mode));
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Entry name matched component index of directory prefix: emit it
+         *        or descend
+         *
+         */
+         void matched(int dir_fd, const std::string &prefix, const char *name, unsigned char type, size_t index,
+                      std::vector<std::string> &matches, std::vector<std::pair<std::string, size_t>> &descend) const
+         {
+            if(index + 1 == this->components.size())
+            {
+               if(false == this->directories_only || is_directory(dir_fd, name, type, true))
+               {
+                  matches.push_back(prefix + name);
+               }
+            }
+            else if(is_directory(dir_fd, name, type, true))
+            {
+               descend.push_back({prefix + name + "/", index + 1});
+            }
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Match one directory (or literal step) against one component
+         *
+         */
+         void visit(const std::string &prefix, size_t index, std::vector<char> &buffer,
+                    std::vector<std::string> &matches, std::vector<std::pair<std::string, size_t>> &descend) const
+         {
+            const std::string &component = this->components[index];
+            if(this->literal[index])
+            {
+               const std::string path = prefix + component;
+               struct stat info;
+               if(0 != stat(path.c_str(), &info))
+               {
+                  return;
+               }
+               if(index + 1 == this->components.size())
+               {
+                  if(false == this->directories_only || S_ISDIR(info.st_mode)) matches.push_back(path);
+               }
+               else if(S_ISDIR(info.st_mode))
+               {
+                  descend.push_back({path + "/", index + 1});
+               }
+               return;
+            }
+
+            int dir_fd = open(prefix.empty() ? "." : prefix.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if(0 > dir_fd)
+            {
+               return;
+            }
+
+            const bool globstar = this->is_globstar(index);
+            const bool trailing_globstar = globstar && index + 1 == this->components.size();
+            while(true)
+            {
+               long bytes = syscall(SYS_getdents64, dir_fd, buffer.data(), buffer.size());
+               if(0 >= bytes)
+               {
+                  break;
+               }
+               for(long offset = 0; offset < bytes;)
+               {
+                  const linux_dirent64 *entry = (const linux_dirent64 *)(buffer.data() + offset);
+                  offset += entry->d_reclen;
+                  const char *name = entry->d_name;
+                  if('.' == name[0] && ('\0' == name[1] || ('.' == name[1] && '\0' == name[2])))
+                  {
+                     continue;
+                  }
+
+                  if(globstar)
+                  {
+                     // ** never matches hidden names and never follows links
+                     if('.' == name[0])
+                     {
+                        if(false == trailing_globstar && 0 == fnmatch(this->components[index + 1].c_str(), name, FNM_PERIOD))
+                        {
+                           this->matched(dir_fd, prefix, name, entry->d_type, index + 1, matches, descend);
+                        }
+                        continue;
+                     }
+                     const bool directory = is_directory(dir_fd, name, entry->d_type, false);
+                     if(trailing_globstar)
+                     {
+                        if(false == this->directories_only || directory) matches.push_back(prefix + name);
+                     }
+                     else if(0 == fnmatch(this->components[index + 1].c_str(), name, FNM_PERIOD))
+                     {
+                        this->matched(dir_fd, prefix, name, entry->d_type, index + 1, matches, descend);
+                     }
+                     if(directory)
+                     {
+                        descend.push_back({prefix + name + "/", index});
+                     }
+                  }
+                  else if(0 == fnmatch(component.c_str(), name, FNM_PERIOD))
+                  {
+                     this->matched(dir_fd, prefix, name, entry->d_type, index, matches, descend);
+                  }
+               }
+            }
+            close(dir_fd);
+         }
+
+         void work(walk_state &state, const sink_function &sink) const
+         {
+            std::vector<char> buffer(32768);
+            std::vector<std::string> matches;
+            std::vector<std::pair<std::string, size_t>> descend;
+
+            std::unique_lock<std::mutex> lock(state.mutex);
+            while(true)
+            {
+               if(state.pending.empty() || NULL != state.error)
+               {
+                  if(0 == state.busy)
+                  {
+                     state.ready.notify_all();
+                     return;
+                  }
+                  state.ready.wait(lock);
+                  continue;
+               }
+
+               std::pair<std::string, size_t> item = std::move(state.pending.back());
+               state.pending.pop_back();
+               ++state.busy;
+               lock.unlock();
+
+               matches.clear();
+               descend.clear();
+               std::exception_ptr error;
+               try
+               {
+                  this->visit(item.first, item.second, buffer, matches, descend);
+               }
+               catch(...)
+               {
+                  error = std::current_exception();
+               }
+
+               lock.lock();
+               --state.busy;
+               if(NULL != error && NULL == state.error)
+               {
+                  state.error = error;
+               }
+               for(auto &next : descend)
+               {
+                  state.pending.push_back(std::move(next));
+               }
+               if(false == matches.empty() && NULL == state.error)
+               {
+                  try
+                  {
+                     sink(matches);
+                  }
+                  catch(...)
+                  {
+                     state.error = std::current_exception();
+                  }
+               }
+               state.ready.notify_all();
+            }
+         }
+
+      public:
+
+         /************************************************************************/
+         /*
+         * \brief Compile a pattern
+         *
+         *     @param[in] std::string pattern: Glob pattern, relative or absolute
+         *
+         */
+         explicit glob_walker(const std::string &pattern)
+         {
+            size_t first = 0;
+            if(false == pattern.empty() && '/' == pattern[0])
+            {
+               this->root = "/";
+               first = pattern.find_first_not_of('/');
+            }
+            size_t last = pattern.find_last_not_of('/');
+            this->directories_only = (std::string::npos != last && last + 1 < pattern.size());
+
+            while(std::string::npos != first && first <= last)
+            {
+               size_t slash = std::min(pattern.find('/', first), last + 1);
+               std::string component = pattern.substr(first, slash - first);
+               // "**/**" is the same as "**"
+               if(false == component.empty() && false == ("**" == component && this->is_globstar(this->components.size() - 1)))
+               {
+                  this->literal.push_back(false == has_glob_magic(component));
+                  this->components.push_back(component);
+               }
+               first = pattern.find_first_not_of('/', slash);
+            }
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Walk the file system, handing matches to sink in batches
+         *
+         *     @param[in] sink_function sink: Receives the matches of one directory at a time, never concurrently
+         *     @return None.
+         *
+         */
+         void run(const sink_function &sink) const
+         {
+            if(this->components.empty())
+            {
+               std::vector<std::string> matches;
+               struct stat info;
+               if(false == this->root.empty() && 0 == stat(this->root.c_str(), &info))
+               {
+                  matches.push_back(this->root);
+                  sink(matches);
+               }
+               return;
+            }
+
+            walk_state state;
+            state.pending.push_back({this->root, 0});
+            cline_utils::thread_pool &pool = cline_utils::thread_pool::shared();
+            pool.parallel_for(pool.size() + 1, [this, &state, &sink](size_t) { this->work(state, sink); });
+            if(NULL != state.error)
+            {
+               std::rethrow_exception(state.error);
+            }
+         }
+   };
+
+   /************************************************************************/
+   /*
+   * \brief Append the paths matching pattern to out
+   *
+   *     @param[in] std::string pattern: Glob pattern
+   *     @param[in,out] std::vector<std::string> &out: Receives the matches
+   *     @param[in] glob_order order: glob_sorted sorts the appended paths
+   *     @return size_t: Number of paths appended
+   *
+   */
+   inline size_t glob_expand(const std::string &pattern, std::vector<std::string> &out, cline_utils::glob_order order = glob_sorted)
+   {
+      const size_t first = out.size();
+      cline_utils::glob_walker(pattern).run([&out](std::vector<std::string> &matches)
+         {
+            for(std::string &match : matches)
+            {
+               out.push_back(std::move(match));
+            }
+         });
+      if(glob_sorted == order)
+      {
+         std::sort(out.begin() + first, out.end());
+      }
+      return(out.size() - first);
+   }
+}
+
+#endif
@@ -0,0 +1,141 @@
+// -----------------------------------------------------------------------
+//
+//                          cline_namespace.h V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#ifndef cline_namespace_h
+#define cline_namespace_h
+
+#include <string>
+#include <vector>
+
+#include "cline_utils.h"
+
+namespace cline_utils
+{
+   /************************************************************************/
+   /*
+   * \brief Registers the members of a parameter struct as the long only
+   *        options of a dotted namespace. Option names are the namespace
+   *        followed by the member name; nested structs open a namespace
+   *        below this one. Option values are allocated by the parser, so
+   *        there is no short character to pick or keep unique.
+   *
+   *           struct solver_params { double tol = 1e-6; int max_iter = 100; };
+   *           struct plasma_params { solver_params solver; mesh_params mesh; };
+   *
+   *           plasma_params p;
+   *           cline_utils::option_namespace<plasma_params> root(cline, "", p);
+   *           root.nest("solver", &plasma_params::solver)
+   *               .option("tol", &solver_params::tol, " Solver tolerance")
+   *               .option("max_iter", &solver_params::max_iter, " Iteration limit");
+   *
+   *        gives --solver.tol and --solver.max_iter, bound to p.solver.tol and
+   *        p.solver.max_iter. The object must outlive the parser's use of it.
+   *
+   */
+   template <typename S>
+   class option_namespace
+   {
+      private:
+
+         cline_utils::CommandLineParser &parser;
+         std::string prefix; /**< "" or the namespace followed by '.' */
+         S &object;
+
+         std::string full_name(const char *name) const
+         {
+            return(this->prefix + name);
+         }
+
+      public:
+
+         /************************************************************************/
+         /*
+         * \brief Open a namespace over object
+         *
+         *     @param[in] CommandLineParser &parser_: Parser the options are added to
+         *     @param[in] std::string name_: Dotted namespace ("solver", "diag.probe"), "" for top level names
+         *     @param[in] S &object_: Struct whose members are bound
+         *
+         */
+         option_namespace(cline_utils::CommandLineParser &parser_, const std::string &name_, S &object_)
+            : parser(parser_), prefix(name_.empty() ? name_ : name_ + "."), object(object_)
+         {
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Add an option bound to one member, typed as by make_option()
+         *
+         *     @param[in] const char *name: Member name within the namespace
+         *     @param[in] T S::*member: Bound member
+         *     @param[in] std::string description: Description printed in the usage table
+         *     @param[in] int is_mandatory_opt: required_option or optional_option
+         *     @param[in] std::vector<option_constraint> constraints: Optional value checks
+         *     @return option_namespace &: This namespace
+         *
+         */
+         template <typename T>
+         option_namespace &option(const char *name, T S::*member, std::string description,
+                                  int is_mandatory_opt = optional_option, std::vector<cline_utils::option_constraint> constraints = {})
+         {
+            const std::string full = this->full_name(name);
+            this->parser.add_option(cline_utils::make_option(full.c_str(), this->parser.allocate_option_val(), this->object.*member,
+                                                             description, is_mandatory_opt, constraints));
+            return(*this);
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Add an enumeration option bound to one member
+         *
+         *     @param[in] const char *name: Member name within the namespace
+         *     @param[in] E S::*member: Bound member
+         *     @param[in] enum_table &names: Names of the enumerators
+         *     @param[in] std::string description: Description printed in the usage table
+         *     @param[in] int is_mandatory_opt: required_option or optional_option
+         *     @return option_namespace &: This namespace
+         *
+         */
+         template <typename E>
+         option_namespace &option(const char *name, E S::*member, const cline_utils::enum_table &names, std::string description,
+                                  int is_mandatory_opt = optional_option)
+         {
+            const std::string full = this->full_name(name);
+            this->parser.add_option(cline_utils::make_option(full.c_str(), this->parser.allocate_option_val(), this->object.*member,
+                                                             names, description, is_mandatory_opt));
+            return(*this);
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Open the namespace of a nested struct member
+         *
+         *     @param[in] const char *name: Name of the nested namespace
+         *     @param[in] U S::*member: Nested struct
+         *     @return option_namespace<U>: Namespace "this.name" over the member
+         *
+         */
+         template <typename U>
+         cline_utils::option_namespace<U> nest(const char *name, U S::*member) const
+         {
+            return(cline_utils::option_namespace<U>(this->parser, this->full_name(name), this->object.*member));
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Dotted name of this namespace, "" at the top level
+         *
+         */
+         std::string name() const
+         {
+            return(this->prefix.empty() ? this->prefix : this->prefix.substr(0, this->prefix.size() - 1));
+         }
+   };
+}
+
+#endif
@@ -0,0 +1,255 @@
+// -----------------------------------------------------------------------
+//
+//                        cline_numeric_array.h V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#ifndef cline_numeric_array_h
+#define cline_numeric_array_h
+
+#include <algorithm>
+#include <charconv>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "cline_thread_pool.h"
+
+namespace cline_utils
+{
+   /************************************************************************/
+   /*
+   * \brief Why a numeric array could not be read; empty what on success
+   *
+   */
+   struct numeric_array_error
+   {
+      std::string what;
+      std::string token; /**< Offending text, if any */
+      size_t line = 0;   /**< 1 based line of token, 0 if not about a token */
+
+      bool failed() const { return(false == this->what.empty()); }
+   };
+
+   /************************************************************************/
+   /*
+   * \brief Converts text holding numbers separated by white space, ',' or ';'
+   *        into one contiguous array. The text is cut into chunks at separator
+   *        boundaries and converted on the shared thread pool in two passes:
+   *        the first counts the numbers of each chunk, so the array is sized
+   *        once and the second converts every chunk with std::from_chars
+   *        straight into its slice of it.
+   *
+   */
+   class numeric_array_parser
+   {
+      private:
+
+         const char *data;
+         size_t size;
+         size_t min_chunk;
+
+         static bool is_separator(char c)
+         {
+            return(' ' == c || '\n' == c || '\t' == c || '\r' == c || ',' == c || ';' == c || '\v' == c || '\f' == c);
+         }
+
+         /** First separator at or after position, so no number spans two chunks */
+         size_t align(size_t position) const
+         {
+            while(position < this->size && false == is_separator(this->data[position])) ++position;
+            return(position);
+         }
+
+         size_t count_numbers(size_t first, size_t last) const
+         {
+            size_t count = 0;
+            bool in_number = false;
+            for(size_t i = first; i < last; ++i)
+            {
+               const bool separator = is_separator(this->data[i]);
+               count += (false == separator && false == in_number);
+               in_number = false == separator;
+            }
+            return(count);
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Convert the numbers of [first, last) into out
+         *
+         *     @return size_t: Offset of the first bad number, SIZE_MAX if there is none
+         *
+         */
+         size_t convert_numbers(size_t first, size_t last, double *out) const
+         {
+            const char *text = this->data;
+            size_t i = first;
+            while(true)
+            {
+               while(i < last && is_separator(text[i])) ++i;
+               if(i == last)
+               {
+                  return(SIZE_MAX);
+               }
+
+               size_t end = i;
+               while(end < last && false == is_separator(text[end])) ++end;
+
+               // from_chars takes no leading '+'
+               const size_t start = ('+' == text[i] && i + 1 < end && '-' != text[i + 1]) ? i + 1 : i;
+               std::from_chars_result result = std::from_chars(text + start, text + end, *out);
+               if(std::errc() != result.ec || text + end != result.ptr)
+               {
+                  return(i);
+               }
+               ++out;
+               i = end;
+            }
+         }
+
+      public:
+
+         /************************************************************************/
+         /*
+         * \brief Parser over text that must stay valid while parse() runs
+         *
+         *     @param[in] const char *data_: Text, need not be NUL terminated
+         *     @param[in] size_t size_: Bytes of text
+         *     @param[in] size_t min_chunk_: Smallest chunk handed to one worker
+         *
+         */
+         numeric_array_parser(const char *data_, size_t size_, size_t min_chunk_ = 1 << 20)
+            : data(data_), size(size_), min_chunk(std::max<size_t>(min_chunk_, 1))
+         {
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Convert every number
+         *
+         *     @param[out] std::vector<double> &out: Replaced by the numbers in text order
+         *     @return numeric_array_error: What failed first in text order, if anything did
+         *
+         */
+         cline_utils::numeric_array_error parse(std::vector<double> &out) const
+         {
+            cline_utils::thread_pool &pool = cline_utils::thread_pool::shared();
+            const size_t chunks = std::max<size_t>(1, std::min((this->size + this->min_chunk - 1) / this->min_chunk, 4 * (pool.size() + 1)));
+
+            std::vector<size_t> bounds(chunks + 1, this->size);
+            bounds[0] = 0;
+            for(size_t chunk = 1; chunk < chunks; ++chunk)
+            {
+               bounds[chunk] = std::max(bounds[chunk - 1], this->align(this->size / chunks * chunk));
+            }
+
+            // First pass: numbers per chunk, turned into each chunk's first index
+            std::vector<size_t> first_index(chunks + 1, 0);
+            pool.parallel_for(chunks, [this, &bounds, &first_index](size_t chunk)
+               {
+                  first_index[chunk + 1] = this->count_numbers(bounds[chunk], bounds[chunk + 1]);
+               });
+            for(size_t chunk = 0; chunk < chunks; ++chunk)
+            {
+               first_index[chunk + 1] += first_index[chunk];
+            }
+
+            // Second pass: convert each chunk into its slice
+            out.resize(first_index[chunks]);
+            std::vector<size_t> bad(chunks, SIZE_MAX);
+            pool.parallel_for(chunks, [this, &bounds, &first_index, &bad, &out](size_t chunk)
+               {
+                  bad[chunk] = this->convert_numbers(bounds[chunk], bounds[chunk + 1], out.data() + first_index[chunk]);
+               });
+
+            cline_utils::numeric_array_error error;
+            auto first_bad = std::find_if(bad.begin(), bad.end(), [](size_t offset) { return(SIZE_MAX != offset); });
+            if(first_bad != bad.end())
+            {
+               const size_t offset = *first_bad;
+               size_t end = offset;
+               while(end < this->size && false == is_separator(this->data[end])) ++end;
+               error.what = "is not a number";
+               error.token.assign(this->data + offset, std::min<size_t>(end - offset, 64));
+               error.line = 1 + std::count(this->data, this->data + offset, '\n');
+               out.clear();
+            }
+            return(error);
+         }
+   };
+
+   /************************************************************************/
+   /*
+   * \brief Read every number of a file into out with numeric_array_parser.
+   *        Regular files are memory mapped; anything else (a pipe,
+   *        /dev/stdin) is read into memory first.
+   *
+   *     @param[in] std::string path: File name
+   *     @param[out] std::vector<double> &out: Replaced by the numbers of the file
+   *     @param[in] size_t min_chunk: Smallest chunk handed to one worker
+   *     @return numeric_array_error: Why the file could not be read, if it could not
+   *
+   */
+   inline cline_utils::numeric_array_error load_numeric_array(const std::string &path, std::vector<double> &out, size_t min_chunk = 1 << 20)
+   {
+      cline_utils::numeric_array_error error;
+      int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+      if(0 > fd)
+      {
+         error.what = std::string("cannot be opened (") + strerror(errno) + ")";
+         return(error);
+      }
+
+      struct stat info;
+      if(0 == fstat(fd, &info) && S_ISREG(info.st_mode))
+      {
+         if(0 == info.st_size)
+         {
+            close(fd);
+            out.clear();
+            return(error);
+         }
+         void *mapping = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+         close(fd);
+         if(MAP_FAILED == mapping)
+         {
+            error.what = std::string("cannot be mapped (") + strerror(errno) + ")";
+            return(error);
+         }
+         error = cline_utils::numeric_array_parser((const char *)mapping, info.st_size, min_chunk).parse(out);
+         munmap(mapping, info.st_size);
+         return(error);
+      }
+
+      std::string text;
+      char buffer[65536];
+      while(true)
+      {
+         ssize_t bytes = read(fd, buffer, sizeof(buffer));
+         if(0 > bytes && EINTR == errno) continue;
+         if(0 > bytes)
+         {
+            error.what = std::string("cannot be read (") + strerror(errno) + ")";
+            close(fd);
+            return(error);
+         }
+         if(0 == bytes) break;
+         text.append(buffer, bytes);
+      }
+      close(fd);
+      return(cline_utils::numeric_array_parser(text.data(), text.size(), min_chunk).parse(out));
+   }
+}
+
+#endif
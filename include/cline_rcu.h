@@ -0,0 +1,252 @@
+// -----------------------------------------------------------------------
+//
+//                            cline_rcu.h V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#ifndef cline_rcu_h
+#define cline_rcu_h
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <utility>
+#include <stdint.h>
+
+namespace cline_utils
+{
+   /************************************************************************/
+   /*
+   * \brief Pointer to an immutable object that one writer replaces while many
+   *        reader threads keep using it. Readers never lock, loop or touch a
+   *        shared reference count: a read costs two stores and two loads.
+   *        Replaced objects are reclaimed epoch style once no reader that could
+   *        have seen them is still inside a read section.
+   *
+   *        Every reader thread claims its own slot with register_reader() and
+   *        must not nest read sections on the same slot.
+   *
+   */
+   template <typename T, size_t max_readers = 128>
+   class rcu_cell
+   {
+      private:
+
+         /************************************************************************/
+         /*
+         * \brief Epoch a reader entered its read section in, 0 if quiescent.
+         *        Padded to a cache line so readers do not share lines.
+         *
+         */
+         struct alignas(64) reader_slot
+         {
+            std::atomic<uint64_t> epoch{0};
+            std::atomic<bool> in_use{false};
+         };
+
+         std::atomic<const T *> current{nullptr};
+         std::atomic<uint64_t> global_epoch{1};
+         reader_slot slots[max_readers];
+
+         std::mutex writer_mutex;                          /**< Serializes publishers */
+         std::vector<std::pair<const T *, uint64_t>> retired; /**< Object, epoch it was replaced in */
+
+      public:
+
+         /************************************************************************/
+         /*
+         * \brief Scope of one read. The object stays valid until it is destroyed.
+         *
+         */
+         class read_guard
+         {
+            private:
+
+               reader_slot *slot;
+               const T *object;
+
+            public:
+
+            read_guard(reader_slot *slot_, const T *object_) : slot(slot_), object(object_)
+            {
+            }
+
+            read_guard(const read_guard &) = delete;
+            read_guard &operator=(const read_guard &) = delete;
+
+            ~read_guard()
+            {
+               this->slot->epoch.store(0, std::memory_order_release);
+            }
+
+            const T *get() const { return(this->object); }
+            const T *operator->() const { return(this->object); }
+            const T &operator*() const { return(*this->object); }
+            explicit operator bool() const { return(nullptr != this->object); }
+         };
+
+         /************************************************************************/
+         /*
+         * \brief Handle owning one reader slot. Keep one per reader thread.
+         *
+         */
+         class reader
+         {
+            private:
+
+               rcu_cell *cell;
+               reader_slot *slot;
+
+            public:
+
+            reader(rcu_cell *cell_, reader_slot *slot_) : cell(cell_), slot(slot_)
+            {
+            }
+
+            reader(reader &&other) : cell(other.cell), slot(other.slot)
+            {
+               other.slot = nullptr;
+            }
+
+            reader(const reader &) = delete;
+            reader &operator=(const reader &) = delete;
+
+            ~reader()
+            {
+               if(nullptr != this->slot)
+               {
+                  this->slot->in_use.store(false, std::memory_order_release);
+               }
+            }
+
+            bool valid() const { return(nullptr != this->slot); }
+
+            /************************************************************************/
+            /*
+            * \brief Wait-free access to the current object
+            *
+            */
+            read_guard read() const
+            {
+               // Announce the epoch before loading the pointer: a writer that
+               // replaced the object afterwards will see this slot as busy
+               this->slot->epoch.store(this->cell->global_epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+               return(read_guard(this->slot, this->cell->current.load(std::memory_order_seq_cst)));
+            }
+         };
+
+         rcu_cell() = default;
+         rcu_cell(const rcu_cell &) = delete;
+         rcu_cell &operator=(const rcu_cell &) = delete;
+
+         ~rcu_cell()
+         {
+            // Readers must be gone by now
+            for(auto &entry : this->retired)
+            {
+               delete entry.first;
+            }
+            delete this->current.load();
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Claim a reader slot
+         *
+         *     @return reader: Handle, or a handle for which valid() is false if all slots are taken
+         *
+         */
+         reader register_reader()
+         {
+            for(size_t i = 0; i < max_readers; ++i)
+            {
+               bool expected = false;
+               if(this->slots[i].in_use.compare_exchange_strong(expected, true))
+               {
+                  return(reader(this, &this->slots[i]));
+               }
+            }
+            return(reader(this, nullptr));
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Replace the current object. Takes ownership of object.
+         *
+         *     @param[in] const T *object: New immutable object allocated with new
+         *     @return None.
+         *
+         */
+         void publish(const T *object)
+         {
+            std::lock_guard<std::mutex> lock(this->writer_mutex);
+
+            const T *previous = this->current.exchange(object, std::memory_order_seq_cst);
+            uint64_t epoch = this->global_epoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+            if(nullptr != previous)
+            {
+               this->retired.push_back({previous, epoch});
+            }
+
+            this->reclaim_locked();
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Free replaced objects no reader can still be using
+         *
+         *     @return size_t: Number of objects still waiting for readers
+         *
+         */
+         size_t reclaim()
+         {
+            std::lock_guard<std::mutex> lock(this->writer_mutex);
+            return(this->reclaim_locked());
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Current object for single threaded use (no read section)
+         *
+         */
+         const T *unsafe_get() const
+         {
+            return(this->current.load(std::memory_order_acquire));
+         }
+
+      private:
+
+         size_t reclaim_locked()
+         {
+            // Oldest epoch any reader is still inside of
+            uint64_t oldest = UINT64_MAX;
+            for(size_t i = 0; i < max_readers; ++i)
+            {
+               uint64_t epoch = this->slots[i].epoch.load(std::memory_order_seq_cst);
+               if(0 != epoch && epoch < oldest)
+               {
+                  oldest = epoch;
+               }
+            }
+
+            size_t kept = 0;
+            for(size_t i = 0; i < this->retired.size(); ++i)
+            {
+               if(this->retired[i].second <= oldest)
+               {
+                  delete this->retired[i].first;
+               }
+               else
+               {
+                  this->retired[kept++] = this->retired[i];
+               }
+            }
+            this->retired.resize(kept);
+            return(kept);
+         }
+   };
+}
+
+#endif
@@ -0,0 +1,293 @@
+// -----------------------------------------------------------------------
+//
+//                          cline_scenario.h V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#ifndef cline_scenario_h
+#define cline_scenario_h
+
+#include <chrono>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "cline_utils.h"
+
+namespace cline_utils
+{
+   /************************************************************************/
+   /*
+   * \brief Outcome of one scenario that did not behave as expected
+   *
+   */
+   struct scenario_failure
+   {
+      std::string name;
+      std::string detail;
+   };
+
+   /************************************************************************/
+   /*
+   * \brief Totals of a ScenarioRunner::run()
+   *
+   */
+   struct scenario_report
+   {
+      size_t run = 0;
+      size_t passed = 0;
+      double seconds = 0.0;
+      std::vector<cline_utils::scenario_failure> failures;
+
+      bool ok() const { return(this->failures.empty()); }
+
+      void print(std::ostream &out) const
+      {
+         for(const cline_utils::scenario_failure &failure : this->failures)
+         {
+            out << "FAILED " << failure.name << ": " << failure.detail << std::endl;
+         }
+         out << this->passed << " of " << this->run << " scenario(s) passed in " << this->seconds << " s";
+         if(0 < this->run)
+         {
+            out << " (" << 1e6 * this->seconds / this->run << " us per scenario)";
+         }
+         out << std::endl;
+      }
+   };
+
+   /************************************************************************/
+   /*
+   * \brief Runs many argv / expectation rows in one process, each against a
+   *        fresh CommandLineParser and a value initialized Values struct
+   *        holding the bound variables. configure() adds the options of the
+   *        schema under test; rows either must parse (and pass an optional
+   *        check) or must throw a message containing a given text.
+   *
+   *           cline_utils::ScenarioRunner<my_options> runner([](auto &cline, my_options &v) { add_my_options(cline, v); });
+   *           runner.expect_pass("defaults", "-b 4");
+   *           runner.expect_error("no file", "", "Missing required option");
+   *           runner.load_table(table_stream);
+   *           cline_utils::scenario_report report = runner.run();
+   *
+   *        Parsers share one pool resource, so after the first rows a
+   *        scenario costs the parse itself rather than process start up.
+   *
+   */
+   template <typename Values>
+   class ScenarioRunner
+   {
+      public:
+
+         typedef std::function<void(cline_utils::CommandLineParser &, Values &)> configure_function;
+
+         /** Returns an empty string if the parsed values are as expected, the reason otherwise */
+         typedef std::function<std::string(cline_utils::CommandLineParser &, const Values &)> check_function;
+
+      private:
+
+         struct scenario
+         {
+            std::string name;
+            cline_utils::ArgvBuilder arguments;
+            bool must_pass;
+            std::string expected_error; /**< Substring of the exception message if !must_pass */
+            check_function check;
+         };
+
+         configure_function configure;
+         std::string program;
+         std::vector<scenario> scenarios;
+
+         cline_utils::ArgvBuilder command(std::string_view command_line) const
+         {
+            cline_utils::ArgvBuilder arguments{this->program};
+            arguments.append(command_line);
+            return(arguments);
+         }
+
+         static void throw_table_error(const std::string &where, const std::string &what)
+         {
+            std::stringstream ss("");
+            ss << "*************************************************************************" << std::endl;
+            ss << "ScenarioRunner::load_table(...) - " << where << ": " << what << std::endl;
+            ss << "*************************************************************************" << std::endl;
+            throw cline_utils::cline_exception(std::string(ss.str()));
+         }
+
+      public:
+
+         /************************************************************************/
+         /*
+         * \brief Create a runner for one option schema
+         *
+         *     @param[in] configure_function configure_: Adds the options to a fresh parser, binding them to Values
+         *     @param[in] std::string program_: argv[0] of every scenario
+         *
+         */
+         explicit ScenarioRunner(configure_function configure_, std::string program_ = "scenario")
+            : configure(configure_), program(program_)
+         {
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Add a row that must parse
+         *
+         *     @param[in] std::string name: Reported on failure
+         *     @param[in] std::string_view command_line: Arguments after argv[0], split like a shell
+         *     @param[in] check_function check: Optional check of the parsed values
+         *     @return ScenarioRunner &: This runner
+         *
+         */
+         ScenarioRunner &expect_pass(std::string name, std::string_view command_line, check_function check = check_function())
+         {
+            this->scenarios.push_back({name, this->command(command_line), true, std::string(), check});
+            return(*this);
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Add a row that must throw
+         *
+         *     @param[in] std::string name: Reported on failure
+         *     @param[in] std::string_view command_line: Arguments after argv[0], split like a shell
+         *     @param[in] std::string expected_error: Text the exception message must contain
+         *     @return ScenarioRunner &: This runner
+         *
+         */
+         ScenarioRunner &expect_error(std::string name, std::string_view command_line, std::string expected_error)
+         {
+            this->scenarios.push_back({name, this->command(command_line), false, expected_error, check_function()});
+            return(*this);
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Add the rows of a text table, one per line:
+         *
+         *           pass | -b 4 --longName1=5 -d hello.txt
+         *           fail Missing required option | -b 4
+         *
+         *        Blank lines and lines starting with # are skipped. Rows are
+         *        named after the source and the line number.
+         *
+         *     @param[in] std::istream &table: Table text
+         *     @param[in] std::string source: Name used in row names and errors
+         *     @return size_t: Number of rows added
+         *
+         */
+         size_t load_table(std::istream &table, const std::string &source = "table")
+         {
+            size_t added = 0;
+            size_t line_number = 0;
+            std::string line;
+            while(std::getline(table, line))
+            {
+               ++line_number;
+               const std::string where = source + ":" + std::to_string(line_number);
+
+               size_t first = line.find_first_not_of(" \t\r");
+               if(std::string::npos == first || '#' == line[first])
+               {
+                  continue;
+               }
+
+               size_t bar = line.find('|');
+               if(std::string::npos == bar)
+               {
+                  throw_table_error(where, "Expected '<pass | fail message> | arguments'");
+               }
+
+               std::string expectation = line.substr(first, bar - first);
+               expectation.erase(expectation.find_last_not_of(" \t") + 1);
+               std::string_view command_line = std::string_view(line).substr(bar + 1);
+
+               if("pass" == expectation)
+               {
+                  this->expect_pass(where, command_line);
+               }
+               else if(0 == expectation.compare(0, 5, "fail ") || "fail" == expectation)
+               {
+                  size_t message = expectation.find_first_not_of(" \t", 4);
+                  this->expect_error(where, command_line, (std::string::npos == message) ? std::string() : expectation.substr(message));
+               }
+               else
+               {
+                  throw_table_error(where, "Unknown expectation '" + expectation + "'");
+               }
+               ++added;
+            }
+            return(added);
+         }
+
+         size_t size() const { return(this->scenarios.size()); }
+
+         /************************************************************************/
+         /*
+         * \brief Run every row
+         *
+         *     @return scenario_report: Totals and the rows that failed
+         *
+         */
+         cline_utils::scenario_report run()
+         {
+            cline_utils::scenario_report report;
+            std::pmr::unsynchronized_pool_resource pool;
+
+            auto start = std::chrono::steady_clock::now();
+            for(scenario &row : this->scenarios)
+            {
+               std::string detail;
+               {
+                  Values values{};
+                  cline_utils::CommandLineParser cline(row.arguments.argc(), row.arguments.argv(), &pool);
+
+                  try
+                  {
+                     this->configure(cline, values);
+                     cline.parse_command_line();
+                     if(false == row.must_pass)
+                     {
+                        detail = "parsed, expected an error containing '" + row.expected_error + "'";
+                     }
+                     else if(row.check)
+                     {
+                        detail = row.check(cline, values);
+                     }
+                  }
+                  catch(const std::exception &e)
+                  {
+                     if(row.must_pass)
+                     {
+                        detail = std::string("unexpected error: ") + e.what();
+                     }
+                     else if(std::string::npos == std::string(e.what()).find(row.expected_error))
+                     {
+                        detail = "error does not contain '" + row.expected_error + "': " + e.what();
+                     }
+                  }
+               }
+
+               ++report.run;
+               if(detail.empty())
+               {
+                  ++report.passed;
+               }
+               else
+               {
+                  report.failures.push_back({row.name, detail});
+               }
+            }
+            report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            return(report);
+         }
+   };
+}
+
+#endif
@@ -0,0 +1,222 @@
+// -----------------------------------------------------------------------
+//
+//                          cline_thread_pool.h V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#ifndef cline_thread_pool_h
+#define cline_thread_pool_h
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace cline_utils
+{
+   /************************************************************************/
+   /*
+   * \brief Fixed set of worker threads draining one task queue. Used for the
+   *        blocking fallbacks of the asynchronous loaders and for parallel
+   *        validation; shared() is created on first use.
+   *
+   */
+   class thread_pool
+   {
+      private:
+
+         std::vector<std::thread> workers;
+         std::deque<std::function<void()>> tasks;
+         std::mutex queue_mutex;
+         std::condition_variable queue_ready;
+         bool stopping = false;
+
+         void work()
+         {
+            while(true)
+            {
+               std::function<void()> task;
+               {
+                  std::unique_lock<std::mutex> lock(this->queue_mutex);
+                  this->queue_ready.wait(lock, [this] { return(this->stopping || false == this->tasks.empty()); });
+                  if(this->tasks.empty())
+                  {
+                     return;
+                  }
+                  task = std::move(this->tasks.front());
+                  this->tasks.pop_front();
+               }
+               task();
+            }
+         }
+
+      public:
+
+         /************************************************************************/
+         /*
+         * \brief Start the workers
+         *
+         *     @param[in] size_t threads: Number of worker threads (at least 1)
+         *
+         */
+         explicit thread_pool(size_t threads = default_threads())
+         {
+            threads = std::max(threads, size_t(1));
+            for(size_t i = 0; i < threads; ++i)
+            {
+               this->workers.emplace_back([this] { this->work(); });
+            }
+         }
+
+         thread_pool(const thread_pool &) = delete;
+         thread_pool &operator=(const thread_pool &) = delete;
+
+         /************************************************************************/
+         /*
+         * \brief Run the queued tasks, then join the workers
+         *
+         */
+         ~thread_pool()
+         {
+            {
+               std::lock_guard<std::mutex> lock(this->queue_mutex);
+               this->stopping = true;
+            }
+            this->queue_ready.notify_all();
+            for(std::thread &worker : this->workers)
+            {
+               worker.join();
+            }
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Threads used by default: one per core, at least 4 so blocking
+         *        I/O on a small machine still overlaps
+         *
+         */
+         static size_t default_threads()
+         {
+            return(std::max(std::thread::hardware_concurrency(), 4u));
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Pool shared by the library, created on first use
+         *
+         */
+         static thread_pool &shared()
+         {
+            static thread_pool pool;
+            return(pool);
+         }
+
+         size_t size() const { return(this->workers.size()); }
+
+         /************************************************************************/
+         /*
+         * \brief Queue a task
+         *
+         *     @param[in] F task: Callable without arguments
+         *     @return std::future: Result or exception of the task
+         *
+         */
+         template <typename F>
+         std::future<std::invoke_result_t<F>> submit(F &&task)
+         {
+            auto packaged = std::make_shared<std::packaged_task<std::invoke_result_t<F>()>>(std::forward<F>(task));
+            std::future<std::invoke_result_t<F>> result = packaged->get_future();
+            {
+               std::lock_guard<std::mutex> lock(this->queue_mutex);
+               this->tasks.emplace_back([packaged] { (*packaged)(); });
+            }
+            this->queue_ready.notify_one();
+            return(result);
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Call body(i) for i in [0, count) on the workers and the calling
+         *        thread. Returns when every call has finished; the first
+         *        exception thrown by body is rethrown. Safe to call from a
+         *        worker: the caller does the work itself if no worker is free.
+         *
+         *     @param[in] size_t count: Number of indices
+         *     @param[in] std::function<void(size_t)> body: Work for one index
+         *     @return None.
+         *
+         */
+         void parallel_for(size_t count, const std::function<void(size_t)> &body)
+         {
+            struct shared_state
+            {
+               std::atomic<size_t> next{0};
+               std::mutex mutex;
+               std::condition_variable done;
+               size_t active = 0;
+               bool closed = false;
+               std::exception_ptr error;
+            };
+            auto state = std::make_shared<shared_state>();
+
+            auto drain = [state, count, &body]()
+               {
+                  for(size_t i = state->next++; i < count; i = state->next++)
+                  {
+                     try
+                     {
+                        body(i);
+                     }
+                     catch(...)
+                     {
+                        std::lock_guard<std::mutex> lock(state->mutex);
+                        if(NULL == state->error) state->error = std::current_exception();
+                        state->next = count;
+                     }
+                  }
+               };
+
+            const size_t helpers = std::min(count, this->size() + 1) - ((0 < count) ? 1 : 0);
+            for(size_t i = 0; i < helpers; ++i)
+            {
+               std::lock_guard<std::mutex> lock(this->queue_mutex);
+               this->tasks.emplace_back([state, drain]()
+                  {
+                     {
+                        // Helpers that start after the caller finished have nothing to do
+                        std::lock_guard<std::mutex> lock(state->mutex);
+                        if(state->closed) return;
+                        ++state->active;
+                     }
+                     drain();
+                     std::lock_guard<std::mutex> lock(state->mutex);
+                     --state->active;
+                     state->done.notify_all();
+                  });
+            }
+            this->queue_ready.notify_all();
+
+            drain();
+
+            std::unique_lock<std::mutex> lock(state->mutex);
+            state->closed = true;
+            state->done.wait(lock, [&state] { return(0 == state->active); });
+            if(NULL != state->error)
+            {
+               std::rethrow_exception(state->error);
+            }
+         }
+   };
+}
+
+#endif
@@ -19,11 +19,32 @@
 #include <algorithm>
 #include <bits/stdc++.h>
 
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <memory_resource>
+#include <string_view>
+#include <thread>
+#include <variant>
+
 #include <stdlib.h>    /* for exit */
 #include <getopt.h>    /* for getopt_long; POSIX standard getopt is in unistd.h */
 #include <limits.h>
+#include <fcntl.h>
+#include <poll.h>      /* for watching the config file */
+#include <unistd.h>
+#include <sys/inotify.h>
+#include <sys/mman.h>    /* for memfd_create and mmap of shared configurations */
+#include <sys/stat.h>
 
 #include "table_printer.h"
+#include "cline_rcu.h"
+#include "cline_async_io.h"
+#include "cline_glob.h"
+#include "cline_numeric_array.h"
 
 namespace cline_utils
 {
@@ -47,6 +68,181 @@ namespace cline_utils
          }
       };
 
+   /************************************************************************/
+   /*
+   * \brief Compact code for the data type stored behind option_longer::dataVal.
+   *        Used wherever the type must be recorded outside of the process
+   *        (e.g. binary configuration snapshots).
+   *
+   */
+   enum option_type : uint8_t
+   {
+      type_none   = 0,
+      type_string = 1,
+      type_double = 2,
+      type_int    = 3,
+      type_float  = 4,
+      type_range  = 5,
+      type_shard  = 6,
+      type_int64  = 7,  /**< Any signed 64 bit integer (int64_t, long long) */
+      type_uint64 = 8,  /**< Any unsigned 64 bit integer (uint64_t, size_t) */
+      type_bool   = 9,
+      type_enum   = 10, /**< Enumeration with an enum_table of names */
+      type_duration = 11, /**< std::chrono::duration with a 64 bit count */
+      type_string_list = 12, /**< std::vector<std::string>, one element per occurrence of the option */
+      type_double_array = 13 /**< std::vector<double> read from "1,2,3" or from a file with "@path" */
+   };
+
+   /************************************************************************/
+   /*
+   * \brief Where the current value of an option came from.
+   *
+   */
+   enum option_source : uint8_t
+   {
+      source_default      = 0, /**< Value was never touched by the parser */
+      source_command_line = 1, /**< Value converted from argv */
+      source_snapshot     = 2, /**< Value loaded from a binary snapshot without a recorded source */
+      source_config_file  = 3  /**< Value converted from the config file */
+   };
+
+   /************************************************************************/
+   /*
+   * \brief Machine readable layouts of the resolved options
+   *
+   */
+   enum summary_format : uint8_t
+   {
+      summary_json = 0, /**< {"options":[{...}, ...], "positional":[...]} */
+      summary_csv  = 1  /**< RFC 4180, one header row and one row per option */
+   };
+
+   /************************************************************************/
+   /*
+   * \brief Declarative check on the value of an option. Attach any number of
+   *        these to an option_longer; they are compiled into a flat table when
+   *        the option is registered and evaluated after conversion.
+   *
+   *        Numeric options (double, float, int, range end points) are checked
+   *        against the bounds, strings against their length. one_of() compares
+   *        numerically for numeric options and textually for strings. chars()
+   *        restricts string options to a union of character classes.
+   *
+   */
+   struct option_constraint
+   {
+      enum constraint_kind : uint8_t
+      {
+         constraint_bounds  = 0, /**< lower <= value <= upper (or lower < value) */
+         constraint_allowed = 1, /**< value is one of allowed */
+         constraint_chars   = 2, /**< every character belongs to char_classes */
+         constraint_path    = 3  /**< value names a file system entry passing path_checks */
+      };
+
+      enum char_class : unsigned
+      {
+         chars_lower      = 1 << 0, /**< a-z */
+         chars_upper      = 1 << 1, /**< A-Z */
+         chars_digit      = 1 << 2, /**< 0-9 */
+         chars_underscore = 1 << 3, /**< _ */
+         chars_dash       = 1 << 4, /**< - */
+         chars_dot        = 1 << 5, /**< . */
+         chars_slash      = 1 << 6, /**< / */
+         chars_space      = 1 << 7, /**< ' ' */
+         chars_alpha      = chars_lower | chars_upper,
+         chars_alnum      = chars_alpha | chars_digit,
+         chars_identifier = chars_alnum | chars_underscore,
+         chars_path       = chars_alnum | chars_underscore | chars_dash | chars_dot | chars_slash
+      };
+
+      enum path_check : unsigned
+      {
+         path_exists     = 1 << 0, /**< statx() succeeds */
+         path_file       = 1 << 1, /**< Regular file (after following links) */
+         path_directory  = 1 << 2, /**< Directory */
+         path_readable   = 1 << 3, /**< Readable by the effective user */
+         path_writable   = 1 << 4, /**< Writable by the effective user */
+         path_executable = 1 << 5  /**< Executable (searchable for directories) by the effective user */
+      };
+
+      constraint_kind kind;
+      double lower;
+      double upper;
+      bool lower_exclusive;
+      std::vector<std::string> allowed;
+      unsigned char_classes;
+      unsigned path_checks = 0;
+
+      static option_constraint between(double lower_, double upper_)
+      {
+         return(option_constraint{constraint_bounds, lower_, upper_, false, {}, 0});
+      }
+
+      static option_constraint min(double lower_)
+      {
+         return(between(lower_, HUGE_VAL));
+      }
+
+      static option_constraint max(double upper_)
+      {
+         return(between(-HUGE_VAL, upper_));
+      }
+
+      static option_constraint positive()
+      {
+         return(option_constraint{constraint_bounds, 0.0, HUGE_VAL, true, {}, 0});
+      }
+
+      static option_constraint one_of(const std::vector<std::string> &allowed_)
+      {
+         return(option_constraint{constraint_allowed, 0.0, 0.0, false, allowed_, 0});
+      }
+
+      static option_constraint chars(unsigned char_classes_)
+      {
+         return(option_constraint{constraint_chars, 0.0, 0.0, false, {}, char_classes_});
+      }
+
+      /************************************************************************/
+      /*
+      * \brief The value (every element of a list) must name an existing file
+      *        system entry with the given properties. All path constraints of
+      *        a parse are checked together, in parallel, after conversion.
+      *
+      *     @param[in] unsigned checks_: path_check bits, path_exists is implied
+      *     @return option_constraint: The constraint
+      * 
+      */
+      static option_constraint path(unsigned checks_ = path_exists)
+      {
+         return(option_constraint{constraint_path, 0.0, 0.0, false, {}, 0, checks_ | path_exists});
+      }
+   };
+
+   /************************************************************************/
+   /*
+   * \brief Rules relating the presence of several options on the command line
+   *
+   */
+   enum group_kind : uint8_t
+   {
+      group_exactly_one = 0, /**< Exactly one member must be given */
+      group_at_most_one = 1, /**< Members are mutually exclusive */
+      group_all_or_none = 2, /**< Members must be given together or not at all */
+      group_requires    = 3  /**< If the trigger option is given, all members must be given too */
+   };
+
+   /************************************************************************/
+   /*
+   * \brief True if val is a short option character rather than the value of
+   *        a long only option (which lies outside the character range)
+   *
+   */
+   inline bool is_short_option_val(int val)
+   {
+      return(0 < val && val < 128 && isgraph(val));
+   }
+
    /************************************************************************/
    /*
    * \brief Store additional relevation data beyond the POSIX option struct
@@ -66,6 +262,12 @@ namespace cline_utils
 
       std::string desc_string;
 
+      std::vector<cline_utils::option_constraint> constraints; /**< Value checks applied after conversion */
+
+      cline_utils::option_type type_code = type_none; /**< Set by make_option(), otherwise derived from type_string */
+      const void *ctx = NULL;                         /**< Type specific data (enum_table, duration_unit) set by make_option() */
+      std::shared_ptr<const void> ctx_owner;          /**< Keeps ctx alive when make_option() owns a copy of it */
+
       /************************************************************************/
       /*
       * \brief An option struct with a bit of additional information derived from POSIX option
@@ -77,6 +279,8 @@ namespace cline_utils
       *   @param[in] int is_mandatory_opt: required_option or optional_option
       *   @param[in] std::string type_string_: typeid(...).name() to match stored data with void dataVal
       *   @param[in] void *dataVal: Arbitrary data array or otherwise stored in the struct
+      *   @param[in] std::string description_: Description printed in the usage table
+      *   @param[in] std::vector<option_constraint> constraints_: Optional value checks
       *   
       *   @return None
       * 
@@ -85,7 +289,8 @@ namespace cline_utils
          std::vector<struct option_longer> longer_options = 
             {
                {"filename"              , required_argument, NULL, 'f', required_option, typeid(input_filename.data()).name(), &input_filename, "Descriptive statement 1"},
-               {"ion_saturation_current", required_argument, NULL, 'i', required_option, typeid(Is_guess).name()             , &Is_guess, "Descriptive statement 2"}
+               {"ion_saturation_current", required_argument, NULL, 'i', required_option, typeid(Is_guess).name()             , &Is_guess, "Descriptive statement 2",
+                {cline_utils::option_constraint::positive()}}
             };
       */
       option_longer(
@@ -96,14 +301,15 @@ namespace cline_utils
          int is_mandatory_opt_,
          std::string type_string_,
          void *dataVal_,
-         std::string description_
+         std::string description_,
+         std::vector<cline_utils::option_constraint> constraints_ = {}
                   ) 
          : name(name_), has_arg(has_arg_), flag(flag_), val(val_), 
            is_mandatory_opt(is_mandatory_opt_), type_string(type_string_), dataVal(dataVal_),
-           desc_string(description_)
+           desc_string(description_), constraints(constraints_)
       {}
 
-      static std::vector<option> pack_into_option_array(std::vector<option_longer> input_)
+      static std::vector<option> pack_into_option_array(const std::vector<option_longer> &input_)
       {
          std::vector<option> result;
          for(size_t i = 0; i < input_.size(); ++i)
@@ -116,543 +322,7146 @@ namespace cline_utils
 
    /************************************************************************/
    /*
-   * \brief Class for parsing command line options. Not fully generic at all 
-   *        but gets the job done with no memory leaks.
+   * \brief Interned, NUL terminated strings packed back to back in one block.
+   *        A string is identified by its 32 bit offset; adding a string that
+   *        is already in the pool returns the existing offset. Lookups use an
+   *        open addressing table of offsets, so there is no node per string.
    *
    */
-   class CommandLineParser
+   class string_pool
    {
       private:
 
-         int argc_;
-         char **argv_;
-
-         std::map<int, std::string> optarg_map; /**< Stores option argument string characters when parsing */
-         //std::vector<int> optvec_; /**< Stores option characters as integer */
-         //std::vector<int> optind_; /**< Long name of the option (no spaces) */
-         //std::vector<int> opterr_; /**< Long name of the option (no spaces) */
-         
-         //std::vector<int> opt_strings;
-         //std::vector<std::string> arg_strings;
+         static constexpr uint32_t empty_slot = UINT32_MAX;
 
-         std::vector<cline_utils::option_longer> opt_cfg;
+         std::pmr::vector<char>     chars; /**< All strings, each followed by its NUL */
+         std::pmr::vector<uint32_t> slots; /**< Hash table of offsets into chars, power of two sized */
+         size_t                     count = 0;
 
-         std::string fmt_string;
+         static uint32_t hash(const char *text)
+         {
+            uint32_t h = 2166136261u;
+            for(; '\0' != *text; ++text)
+            {
+               h = (h ^ (unsigned char)*text) * 16777619u;
+            }
+            return(h);
+         }
 
-        // std::vector<std::tuple<char, int, int>> optChar2 
+         void insert_slot(uint32_t offset)
+         {
+            const size_t mask = this->slots.size() - 1;
+            size_t slot = hash(&this->chars[offset]) & mask;
+            while(empty_slot != this->slots[slot])
+            {
+               slot = (slot + 1) & mask;
+            }
+            this->slots[slot] = offset;
+         }
 
       public:
 
-      /************************************************************************/
-      /*
-      * \brief No empty constructor.
-      *
-      */
-      CommandLineParser() = delete;
+         explicit string_pool(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+            : chars(resource), slots(resource)
+         {
+         }
 
-      /************************************************************************/
-      /*
-      * \brief Create a CommandLineParser object.
-      *
-      *     @param[in] int argc: Integer variable storing number of command line arguments (including executable name)    
-      *     @param[in] char **argv: Array of character pointers listing all the arguments    
-      *     @param[in] std::vector<struct option_longer> &option_config: Vector of option_longer structs
-      *     @return None.
-      * 
-      */
-      CommandLineParser(
-         int argc,
-         char **argv,
-         const std::vector<cline_utils::option_longer> &option_config
-                       )
-            : argc_(argc), argv_(argv), opt_cfg(option_config)
-      {
-         this->opt_cfg.push_back({NULL, 0, NULL, 0, required_option, "", NULL, ""});
-      }
+         /************************************************************************/
+         /*
+         * \brief Add a string to the pool unless it is already there
+         *
+         *     @param[in] const char *text: String to intern (NULL is stored as "")
+         *     @return uint32_t: Offset of the string in the pool
+         * 
+         */
+         uint32_t intern(const char *text)
+         {
+            if(NULL == text)
+            {
+               text = "";
+            }
 
-      /************************************************************************/
-      /*
-      * \brief Create a CommandLineParser object. Options MUST be added later!
-      *
-      *     @param[in] int argc: Integer variable storing number of command line arguments (including executable name)    
-      *     @param[in] char **argv: Array of character pointers listing all the arguments    
-      *     @return None.
-      * 
-      */
-     CommandLineParser(
-      int argc,
-      char **argv
-                    )
-         : argc_(argc), argv_(argv)
-      {
-         this->opt_cfg.push_back({NULL, 0, NULL, 0, required_option, "", NULL, ""});
-      }
+            // Keep the load factor at or below one half
+            if(2 * (this->count + 1) > this->slots.size())
+            {
+               this->slots.assign(std::max<size_t>(16, 2 * this->slots.size()), empty_slot);
+               for(size_t offset = 0; offset < this->chars.size(); offset += strlen(&this->chars[offset]) + 1)
+               {
+                  this->insert_slot(offset);
+               }
+            }
 
-      /************************************************************************/
-      /*
-      * \brief Add an option to the internal option structure
-      *
-      *     @param[in] cline_utils::option_longer &option_: option_longer struct
-      *     @return None.
-      * 
-      */
-      void add_option(const cline_utils::option_longer &option_)
-      {
-         this->opt_cfg.pop_back(); // Removes current back element of zeros that is required per getopt_long
-         this->opt_cfg.push_back(option_);
-         this->opt_cfg.push_back({NULL, 0, NULL, 0, required_option, "", NULL, ""});
-      }
+            const size_t mask = this->slots.size() - 1;
+            size_t slot = hash(text) & mask;
+            while(empty_slot != this->slots[slot])
+            {
+               if(0 == strcmp(&this->chars[this->slots[slot]], text))
+               {
+                  return(this->slots[slot]);
+               }
+               slot = (slot + 1) & mask;
+            }
 
-      /************************************************************************/
-      /*
-      * \brief Add a bunch of options to the internal option structure
-      *
-      *     @param[in] std::vector<cline_utils::option_longer> &option_: option_longer structs
-      *     @return None.
-      * 
-      */
-      void add_options(const std::vector<cline_utils::option_longer> &options_)
-      {
-         for(size_t i = 0; i < options_.size(); ++i)
-         {
-            this->add_option(options_[i]);
+            const uint32_t offset = this->chars.size();
+            this->chars.insert(this->chars.end(), text, text + strlen(text) + 1);
+            this->slots[slot] = offset;
+            ++this->count;
+            return(offset);
          }
-      }
 
-      /************************************************************************/
-      /*
-      * \brief Create a CommandLineParser object.
-      *
-      *     @param[in] cline_utils::option_longer &option_: option_longer struct
-      *     @return None.
-      * 
-      */
-      void delete_all_options()
-      {
-         while(1 < this->opt_cfg.size())
+         const char *get(uint32_t offset) const
          {
-            this->opt_cfg.pop_back();
+            return(&this->chars[offset]);
          }
-         // Add current back element of zeros that is required per getopt_long
-         this->opt_cfg.push_back({NULL, 0, NULL, 0, required_option, "", NULL, ""});
-      }
 
-      /************************************************************************/
-      /*
-      * \brief Ensure that all required_options are present
-      *
-      *     @return None
-      * 
-      */
-      void check_required_options()
-      {
-         // Exclude the last element from for loop iteration since getopt_long requires
-         // last member of option structs array be all zeroes
-         for(size_t option_index = 0; option_index < this->opt_cfg.size() - 1; ++option_index)
+         void clear()
          {
-            if(required_option == this->opt_cfg[option_index].is_mandatory_opt)
-            {
-               auto itr = this->optarg_map.find(this->opt_cfg[option_index].val);
+            this->chars.clear();
+            this->slots.clear();
+            this->count = 0;
+         }
 
-               if (itr == this->optarg_map.end())
-               {
-                  std::stringstream ss("");
-                  ss << "******************************************************************************************" << std::endl;
-                  ss << "check_required_options(...) - Missing required option in command line args: -" << char(this->opt_cfg[option_index].val) << std::endl;
-                  ss << "******************************************************************************************" << std::endl;
-                  throw cline_utils::cline_exception(std::string(ss.str()));
-                  break;
-               }
-            }
+         size_t memory_usage() const
+         {
+            return(this->chars.capacity() + this->slots.capacity() * sizeof(uint32_t));
          }
-      }
+   };
 
-      /************************************************************************/
-      /*
-      * \brief Ensure no options long or short names are duplicates in input
-      *        configuration struct.
-      *
-      *     @return None
-      * 
-      */
-      void check_duplicate_option_config_names()
-      {
-         std::vector<std::string> long_names;
-         std::vector<int> short_names;
+   /************************************************************************/
+   /*
+   * \brief Prefix tree over dotted long names ("solver.tol", "diag.probe.rate"),
+   *        one level per component. Edges are appended to one array and found
+   *        through a hash of (parent, component), so adding n names costs
+   *        O(n) and a lookup is one hash probe per component. Component text
+   *        is kept in one block. Listing a namespace sorts the edges once per
+   *        call, which keeps the names in order.
+   *
+   */
+   class name_trie
+   {
+      private:
+
+         struct edge
+         {
+            uint32_t parent;
+            uint32_t offset; /**< Component text in chars */
+            uint32_t length;
+            uint32_t child;
+         };
 
-         // Exclude the last element from for loop iteration since getopt_long requires
-         // last member of option structs array be all zeroes
-         for(size_t option_index = 0; option_index < this->opt_cfg.size() - 1; ++option_index)
+         std::pmr::vector<edge>    edges;        /**< In insertion order */
+         std::pmr::vector<int32_t> node_options; /**< Option index of each node, -1 for a bare prefix; node 0 is the root */
+         std::pmr::string          chars;
+         std::pmr::unordered_multimap<size_t, uint32_t> edge_index; /**< hash_edge() -> edge */
+
+         std::string_view component(const edge &e) const
          {
-            long_names.push_back(this->opt_cfg[option_index].name);
-            short_names.push_back(this->opt_cfg[option_index].val);
+            return(std::string_view(this->chars).substr(e.offset, e.length));
          }
 
-         // Check option long name configuration for duplicates
-         std::unordered_set<std::string> usln;
-         for (auto i : long_names) 
+         static size_t hash_edge(uint32_t parent, std::string_view text)
+         {
+            return(std::hash<std::string_view>()(text) ^ (size_t(parent) * 0x9E3779B97F4A7C15ull));
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Child of parent along component text, -1 if there is none
+         *
+         */
+         int64_t find_child(uint32_t parent, std::string_view text) const
          {
-            if (usln.find(i) != usln.end())
+            auto range = this->edge_index.equal_range(hash_edge(parent, text));
+            for(auto it = range.first; it != range.second; ++it)
             {
-               std::stringstream ss("");
-               ss << "****************************************************************************************************************" << std::endl;
-               ss << "check_duplicate_options(...) - Struct option.name field const char* configured with duplicate entries: " << i << std::endl;
-               ss << "****************************************************************************************************************" << std::endl;
-               throw cline_utils::cline_exception(std::string(ss.str()));
+               const edge &e = this->edges[it->second];
+               if(e.parent == parent && this->component(e) == text)
+               {
+                  return(e.child);
+               }
             }
-            else
+            return(-1);
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Node reached by the components of name, -1 if there is none
+         *
+         */
+         int64_t walk(std::string_view name) const
+         {
+            int64_t node = 0;
+            while(true)
             {
-               usln.insert(i);
+               const size_t dot = name.find('.');
+               node = this->find_child(node, name.substr(0, dot));
+               if(0 > node || std::string_view::npos == dot)
+               {
+                  return(node);
+               }
+               name.remove_prefix(dot + 1);
             }
          }
 
-         // Check option short name configuration for duplicates
-         std::unordered_set<int> ussn;
-         for (auto i : short_names) 
+         /************************************************************************/
+         /*
+         * \brief Append the options of node and its descendants in name order
+         *
+         *     @param[in] std::vector<uint32_t> &order: Edge indices sorted by parent, then component
+         *
+         */
+         void collect(uint32_t node, const std::vector<uint32_t> &order, std::vector<size_t> &out) const
          {
-            if (ussn.find(i) != ussn.end())
+            if(0 <= this->node_options[node])
             {
-               std::stringstream ss("");
-               ss << "****************************************************************************************************************" << std::endl;
-               ss << "check_duplicate_options(...) - Struct option->flag field int* configured with duplicate entries: " << char(i) << std::endl;
-               ss << "****************************************************************************************************************" << std::endl;
-               throw cline_utils::cline_exception(std::string(ss.str()));
+               out.push_back(this->node_options[node]);
             }
-            else
+            auto first = std::lower_bound(order.begin(), order.end(), node,
+               [this](uint32_t e, uint32_t parent) { return(this->edges[e].parent < parent); });
+            for(auto e = first; e != order.end() && this->edges[*e].parent == node; ++e)
             {
-               ussn.insert(i);
+               this->collect(this->edges[*e].child, order, out);
             }
          }
-      }
 
+      public:
 
-      /************************************************************************/
-      /*
-      * \brief Create a format string to be fed into get_opt
-      *           
-      *     @return None
-      * 
-      */
-      void create_option_format_string()
-      {
-         // Loop through the option_longer struct and construct the
-         std::string result(":");
-
-         // Exclude the last element from for loop iteration since getopt_long requires
-         // last member of option structs array be all zeroes
-         for(size_t option_index = 0; option_index < this->opt_cfg.size() - 1; ++option_index)
+         explicit name_trie(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+            : edges(resource), node_options(1, -1, resource), chars(resource), edge_index(resource)
          {
-            result += char(this->opt_cfg[option_index].val);
+         }
 
-            switch(this->opt_cfg[option_index].has_arg)
+         /************************************************************************/
+         /*
+         * \brief Add a name. A name added twice keeps its first option index;
+         *        duplicates are reported when the parser checks its options.
+         *
+         *     @param[in] std::string_view name: Long name, components separated by '.'
+         *     @param[in] size_t option_index: Index of the option in its table
+         *     @return None.
+         * 
+         */
+         void insert(std::string_view name, size_t option_index)
+         {
+            uint32_t node = 0;
+            while(true)
             {
-               case (required_argument):
-                  result.append(":");
+               const size_t dot = name.find('.');
+               const std::string_view text = name.substr(0, dot);
+               const int64_t child = this->find_child(node, text);
+               if(0 <= child)
+               {
+                  node = child;
+               }
+               else
+               {
+                  const uint32_t added = this->node_options.size();
+                  this->node_options.push_back(-1);
+                  this->edge_index.emplace(hash_edge(node, text), uint32_t(this->edges.size()));
+                  this->edges.push_back(edge{node, uint32_t(this->chars.size()), uint32_t(text.size()), added});
+                  this->chars.append(text);
+                  node = added;
+               }
+               if(std::string_view::npos == dot)
+               {
                   break;
+               }
+               name.remove_prefix(dot + 1);
+            }
+            if(0 > this->node_options[node])
+            {
+               this->node_options[node] = option_index;
+            }
+         }
 
-               case (optional_argument):
-                  result.append("::");
-                  break;
+         /************************************************************************/
+         /*
+         * \brief Option index of an exact name, -1 if there is none
+         *
+         */
+         int find(std::string_view name) const
+         {
+            const int64_t node = this->walk(name);
+            return((0 > node) ? -1 : this->node_options[node]);
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Option indices of prefix and every name below it, in name order
+         *
+         *     @param[in] std::string_view prefix: Namespace ("solver", "diag.probe"), "" for all options
+         *     @param[out] std::vector<size_t> &out: Receives the option indices
+         *     @return bool: False if no name starts with prefix
+         * 
+         */
+         bool subtree(std::string_view prefix, std::vector<size_t> &out) const
+         {
+            const int64_t node = prefix.empty() ? 0 : this->walk(prefix);
+            if(0 > node)
+            {
+               return(false);
+            }
+
+            std::vector<uint32_t> order(this->edges.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b)
+               {
+                  const edge &x = this->edges[a], &y = this->edges[b];
+                  return(x.parent < y.parent || (x.parent == y.parent && this->component(x) < this->component(y)));
+               });
+            this->collect(node, order, out);
+            return(true);
+         }
+
+         void clear()
+         {
+            this->edges.clear();
+            this->node_options.assign(1, -1);
+            this->chars.clear();
+            this->edge_index.clear();
+         }
+
+         size_t memory_usage() const
+         {
+            return(this->edges.capacity() * sizeof(edge) + this->node_options.capacity() * sizeof(int32_t) + this->chars.capacity() +
+                   this->edge_index.bucket_count() * sizeof(void *) + this->edge_index.size() * (sizeof(size_t) + sizeof(uint32_t) + 2 * sizeof(void *)));
+         }
+   };
+
+   /************************************************************************/
+   /*
+   * \brief Structure of arrays holding the options registered with a parser.
+   *        The fields read while parsing are kept in dense arrays of their own
+   *        (values, argument kinds, type codes, data pointers, long names);
+   *        the help text and type names used only for usage and summaries are
+   *        kept apart in a second pool. Strings are interned, so the per option
+   *        cost is a handful of array entries plus the unique characters.
+   *
+   */
+   class option_table
+   {
+      private:
+
+         // Hot: read while parsing
+         std::pmr::vector<int>      vals;
+         std::pmr::vector<int8_t>   has_args;
+         std::pmr::vector<uint8_t>  mandatory;
+         std::pmr::vector<uint8_t>  types;
+         std::pmr::vector<void *>   data_ptrs;
+         std::pmr::vector<uint32_t> name_offsets;
+         cline_utils::string_pool   names;
+         cline_utils::name_trie     name_index;
+
+         // Cold: usage, summary tables and error messages
+         std::pmr::vector<const void *> contexts;
+         std::vector<std::shared_ptr<const void>> context_owners; /**< Copies of tables the contexts point into */
+         std::pmr::vector<uint32_t> type_offsets;
+         std::pmr::vector<uint32_t> desc_offsets;
+         cline_utils::string_pool   text;
+
+      public:
+
+         explicit option_table(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+            : vals(resource), has_args(resource), mandatory(resource), types(resource), data_ptrs(resource),
+              name_offsets(resource), names(resource), name_index(resource), contexts(resource), type_offsets(resource), desc_offsets(resource), text(resource)
+         {
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Append an option
+         *
+         *     @param[in] cline_utils::option_longer &option_: Option to copy in
+         *     @param[in] cline_utils::option_type type_: Type code of option_.type_string
+         *     @return None.
+         * 
+         */
+         void push_back(const cline_utils::option_longer &option_, cline_utils::option_type type_)
+         {
+            this->vals.push_back(option_.val);
+            this->has_args.push_back(option_.has_arg);
+            this->mandatory.push_back(option_.is_mandatory_opt);
+            this->types.push_back(type_);
+            this->data_ptrs.push_back(option_.dataVal);
+            this->name_offsets.push_back(this->names.intern(option_.name));
+            this->contexts.push_back(option_.ctx);
+            if(option_.ctx_owner)
+            {
+               this->context_owners.push_back(option_.ctx_owner);
+            }
+            this->type_offsets.push_back(this->text.intern(option_.type_string.c_str()));
+            this->desc_offsets.push_back(this->text.intern(option_.desc_string.c_str()));
+            this->name_index.insert(this->name(this->size() - 1), this->size() - 1);
+         }
+
+         void clear()
+         {
+            this->vals.clear();
+            this->has_args.clear();
+            this->mandatory.clear();
+            this->types.clear();
+            this->data_ptrs.clear();
+            this->name_offsets.clear();
+            this->names.clear();
+            this->name_index.clear();
+            this->contexts.clear();
+            this->context_owners.clear();
+            this->type_offsets.clear();
+            this->desc_offsets.clear();
+            this->text.clear();
+         }
+
+         size_t size() const { return(this->vals.size()); }
+
+         int val(size_t option_index) const { return(this->vals[option_index]); }
+         int has_arg(size_t option_index) const { return(this->has_args[option_index]); }
+         int is_mandatory_opt(size_t option_index) const { return(this->mandatory[option_index]); }
+         cline_utils::option_type type(size_t option_index) const { return(cline_utils::option_type(this->types[option_index])); }
+         void *data(size_t option_index) const { return(this->data_ptrs[option_index]); }
+         const char *name(size_t option_index) const { return(this->names.get(this->name_offsets[option_index])); }
+         const void *context(size_t option_index) const { return(this->contexts[option_index]); }
+         const char *type_string(size_t option_index) const { return(this->text.get(this->type_offsets[option_index])); }
+         const char *description(size_t option_index) const { return(this->text.get(this->desc_offsets[option_index])); }
+
+         /************************************************************************/
+         /*
+         * \brief Index of the option with short character (or long only value) val
+         *
+         *     @param[in] int val: Value returned by getopt_long for the option
+         *     @return int: Option index, -1 if there is none
+         * 
+         */
+         int find(int val) const
+         {
+            const int *found = std::find(this->vals.data(), this->vals.data() + this->vals.size(), val);
+            return((found == this->vals.data() + this->vals.size()) ? -1 : int(found - this->vals.data()));
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Index of the option with the given long name, -1 if there is none
+         *
+         */
+         int find_name(std::string_view name) const
+         {
+            return(this->name_index.find(name));
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Indices of the options in a dotted namespace, see name_trie::subtree()
+         *
+         */
+         bool find_namespace(std::string_view prefix, std::vector<size_t> &out) const
+         {
+            return(this->name_index.subtree(prefix, out));
+         }
+
+         /************************************************************************/
+         /*
+         * \brief getopt_long option array, terminated by the all zero entry. The
+         *        names point into the table and stay valid until it is modified.
+         *
+         */
+         std::pmr::vector<option> getopt_table() const
+         {
+            std::pmr::vector<option> result(this->vals.get_allocator());
+            result.reserve(this->size() + 1);
+            for(size_t option_index = 0; option_index < this->size(); ++option_index)
+            {
+               result.push_back({this->name(option_index), this->has_arg(option_index), NULL, this->val(option_index)});
+            }
+            result.push_back({NULL, 0, NULL, 0});
+            return(result);
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Heap bytes held by the table
+         *
+         */
+         size_t memory_usage() const
+         {
+            return(this->vals.capacity() * sizeof(int) + this->has_args.capacity() + this->mandatory.capacity() +
+                   this->types.capacity() + (this->data_ptrs.capacity() + this->contexts.capacity()) * sizeof(void *) +
+                   (this->name_offsets.capacity() + this->type_offsets.capacity() + this->desc_offsets.capacity()) * sizeof(uint32_t) +
+                   this->names.memory_usage() + this->name_index.memory_usage() + this->text.memory_usage());
+         }
+   };
+
+   /************************************************************************/
+   /*
+   * \brief Precomputed parser tables emitted by the cline_codegen tool. When
+   *        attached to a CommandLineParser, the format string, getopt_long
+   *        option array, short character lookup and usage text are used as is
+   *        instead of being rebuilt at runtime.
+   *
+   */
+   struct static_option_tables
+   {
+      const char    *format_string; /**< Same as create_option_format_string() output */
+      const option  *getopt_table;  /**< NULL terminated getopt_long option array */
+      const int16_t *short_index;   /**< 256 entries mapping option character -> option index, -1 if unused */
+      const char    *usage;         /**< Usage text printed by print_usage() */
+      size_t         option_count;  /**< Number of options the tables were generated for */
+   };
+
+   /************************************************************************/
+   /*
+   * \brief Read only view of the positional (non-option) arguments. Nothing is
+   *        copied: when the positionals sit next to each other in argv (the
+   *        usual "tool -v *.h5") the view points straight into argv, otherwise
+   *        it holds one pointer per argument into argv. Arguments are kept in
+   *        command line order; argv itself is never permuted.
+   *
+   */
+   class positional_view
+   {
+      private:
+
+         friend class CommandLineParser;
+
+         const char *const *contiguous = NULL;  /**< First positional in argv if they are adjacent */
+         size_t count = 0;
+         std::pmr::vector<const char *> gathered; /**< Pointers into argv if they are not */
+
+      public:
+
+         explicit positional_view(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+            : gathered(resource)
+         {
+         }
+
+         size_t size() const { return(this->count); }
+         bool empty() const { return(0 == this->count); }
+         const char *const *data() const { return(this->gathered.empty() ? this->contiguous : this->gathered.data()); }
+         const char *const *begin() const { return(this->data()); }
+         const char *const *end() const { return(this->data() + this->count); }
+         const char *operator[](size_t index) const { return(this->data()[index]); }
+
+         /************************************************************************/
+         /*
+         * \brief Positional argument converted to T (std::string, const char *,
+         *        double, float or any integer type). The whole argument must be
+         *        a valid number that fits in T.
+         *
+         *     @param[in] size_t index: Index of the positional argument
+         *     @return T: Converted value
+         * 
+         */
+         template <typename T>
+         T as(size_t index) const
+         {
+            if(index >= this->count)
+            {
+               throw_conversion_error(index, "", "index out of range");
+            }
+
+            const char *text = (*this)[index];
+            char *endPtr = NULL;
+            errno = 0;
+            if constexpr (std::is_same_v<T, const char *>)
+            {
+               return(text);
+            }
+            else if constexpr (std::is_same_v<T, std::string>)
+            {
+               return(std::string(text));
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+               long double value = strtold(text, &endPtr);
+               if(endPtr == text || '\0' != *endPtr || ERANGE == errno)
+               {
+                  throw_conversion_error(index, text, "not a number");
+               }
+               return(T(value));
+            }
+            else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+            {
+               long long value = strtoll(text, &endPtr, 0);
+               if(endPtr == text || '\0' != *endPtr || ERANGE == errno ||
+                  value < std::numeric_limits<T>::min() || value > std::numeric_limits<T>::max())
+               {
+                  throw_conversion_error(index, text, "not an integer in range");
+               }
+               return(T(value));
+            }
+            else
+            {
+               static_assert(std::is_integral_v<T>, "positional_view::as<T>() supports strings, floating point and integer types");
+               unsigned long long value = strtoull(text, &endPtr, 0);
+               if(endPtr == text || '\0' != *endPtr || ERANGE == errno || '-' == text[0] ||
+                  value > std::numeric_limits<T>::max())
+               {
+                  throw_conversion_error(index, text, "not an unsigned integer in range");
+               }
+               return(T(value));
+            }
+         }
+
+      private:
+
+         /************************************************************************/
+         /*
+         * \brief Record argv[argv_index] as the next positional argument
+         *
+         */
+         void append(char **argv, int argv_index)
+         {
+            if(this->gathered.empty() && (0 == this->count || this->contiguous + this->count == argv + argv_index))
+            {
+               if(0 == this->count)
+               {
+                  this->contiguous = argv + argv_index;
+               }
+            }
+            else
+            {
+               if(this->gathered.empty())
+               {
+                  this->gathered.assign(this->contiguous, this->contiguous + this->count);
+               }
+               this->gathered.push_back(argv[argv_index]);
+            }
+            ++this->count;
+         }
+
+         void clear()
+         {
+            this->contiguous = NULL;
+            this->count = 0;
+            this->gathered.clear();
+         }
+
+         static void throw_conversion_error(size_t index, const char *text, const char *what)
+         {
+            std::stringstream ss("");
+            ss << "*************************************************************************" << std::endl;
+            ss << "positional_view::as(...) - Positional argument " << index << " '" << text << "': " << what << std::endl;
+            ss << "*************************************************************************" << std::endl;
+            throw cline_utils::cline_exception(std::string(ss.str()));
+         }
+   };
+
+   /************************************************************************/
+   /*
+   * \brief Lazy sequence of entries: a few leading ones (usually positional
+   *        arguments, not copied) followed by NUL or newline delimited
+   *        entries read from a file descriptor (a --files-from list, often
+   *        a pipe). The descriptor is read on demand into one fixed buffer,
+   *        so the first entry is available as soon as the producer wrote it
+   *        and memory does not grow with the length of the list. In newline
+   *        mode a trailing '\r' is dropped; empty entries are skipped.
+   *
+   *           for(std::string_view file : cline.get_positional_stream('F')) { ... }
+   *
+   *        Entries are views valid until the next one is requested.
+   *
+   */
+   class files_from_reader
+   {
+      private:
+
+         std::vector<const char *> leading; /**< Entries delivered before the descriptor is read */
+         size_t leading_next = 0;
+
+         int fd = -1;
+         bool owns_fd = false;
+         bool at_eof = false;
+         char delimiter = '\n';
+
+         std::unique_ptr<char[]> buffer;
+         size_t buffer_size = 0;
+         size_t begin_pos = 0; /**< First unconsumed byte */
+         size_t scan_pos = 0;  /**< Bytes before this hold no delimiter (from begin_pos) */
+         size_t end_pos = 0;   /**< One past the last byte read */
+         size_t delivered = 0;
+
+         static void throw_reader_error(const std::string &what)
+         {
+            std::stringstream ss("");
+            ss << "*************************************************************************" << std::endl;
+            ss << "files_from_reader(...) - " << what << std::endl;
+            ss << "*************************************************************************" << std::endl;
+            throw cline_utils::cline_exception(std::string(ss.str()));
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Move the unconsumed bytes to the front and read more behind them
+         *
+         *     @return bool: False at end of input
+         *
+         */
+         bool fill()
+         {
+            if(0 < this->begin_pos)
+            {
+               memmove(this->buffer.get(), this->buffer.get() + this->begin_pos, this->end_pos - this->begin_pos);
+               this->end_pos -= this->begin_pos;
+               this->scan_pos -= this->begin_pos;
+               this->begin_pos = 0;
+            }
+            if(this->end_pos == this->buffer_size)
+            {
+               throw_reader_error("Entry longer than the " + std::to_string(this->buffer_size) + " byte buffer");
+            }
+
+            while(true)
+            {
+               ssize_t bytes = read(this->fd, this->buffer.get() + this->end_pos, this->buffer_size - this->end_pos);
+               if(0 < bytes)
+               {
+                  this->end_pos += bytes;
+                  return(true);
+               }
+               if(0 == bytes)
+               {
+                  this->at_eof = true;
+                  return(false);
+               }
+               if(EINTR != errno)
+               {
+                  throw_reader_error(std::string("Unable to read the entry list: ") + strerror(errno));
+               }
+            }
+         }
+
+      public:
+
+         /************************************************************************/
+         /*
+         * \brief Read entries from a descriptor
+         *
+         *     @param[in] int fd_: Descriptor, -1 for leading entries only
+         *     @param[in] char delimiter_: '\n' or '\0'
+         *     @param[in] size_t capacity: Buffer size, also the longest entry accepted
+         *     @param[in] bool owns_fd_: Close fd_ on destruction
+         *
+         */
+         explicit files_from_reader(int fd_ = -1, char delimiter_ = '\n', size_t capacity = 65536, bool owns_fd_ = false)
+            : fd(fd_), owns_fd(owns_fd_), at_eof(0 > fd_), delimiter(delimiter_),
+              buffer(new char[std::max(capacity, size_t(2))]), buffer_size(std::max(capacity, size_t(2)))
+         {
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Open a list file, "-" reads standard input
+         *
+         */
+         static files_from_reader open(const std::string &path, char delimiter_ = '\n', size_t capacity = 65536)
+         {
+            if("-" == path)
+            {
+               return(files_from_reader(STDIN_FILENO, delimiter_, capacity, false));
+            }
+            int list_fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if(0 > list_fd)
+            {
+               throw_reader_error("Unable to open entry list '" + path + "': " + strerror(errno));
+            }
+            return(files_from_reader(list_fd, delimiter_, capacity, true));
+         }
+
+         files_from_reader(const files_from_reader &) = delete;
+         files_from_reader &operator=(const files_from_reader &) = delete;
+
+         files_from_reader(files_from_reader &&other) noexcept
+            : leading(std::move(other.leading)), leading_next(other.leading_next), fd(other.fd), owns_fd(other.owns_fd),
+              at_eof(other.at_eof), delimiter(other.delimiter), buffer(std::move(other.buffer)), buffer_size(other.buffer_size),
+              begin_pos(other.begin_pos), scan_pos(other.scan_pos), end_pos(other.end_pos), delivered(other.delivered)
+         {
+            other.fd = -1;
+            other.owns_fd = false;
+         }
+
+         ~files_from_reader()
+         {
+            if(this->owns_fd)
+            {
+               close(this->fd);
+            }
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Entries delivered before the descriptor is read. The strings
+         *        must outlive the reader (argv does).
+         *
+         */
+         void add_leading(const char *entry)
+         {
+            this->leading.push_back(entry);
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Next entry
+         *
+         *     @param[out] std::string_view &entry: Valid until the next call
+         *     @return bool: False when the list is exhausted
+         *
+         */
+         bool next(std::string_view &entry)
+         {
+            if(this->leading_next < this->leading.size())
+            {
+               entry = this->leading[this->leading_next++];
+               ++this->delivered;
+               return(true);
+            }
+
+            while(true)
+            {
+               const char *first = this->buffer.get() + this->begin_pos;
+               const char *found = (const char *)memchr(this->buffer.get() + this->scan_pos, this->delimiter, this->end_pos - this->scan_pos);
+               size_t length;
+               if(NULL != found)
+               {
+                  length = found - first;
+                  this->begin_pos += length + 1;
+               }
+               else
+               {
+                  this->scan_pos = this->end_pos;
+                  if(false == this->at_eof && this->fill())
+                  {
+                     continue;
+                  }
+                  first = this->buffer.get() + this->begin_pos; // fill() moved the entry to the front
+                  length = this->end_pos - this->begin_pos;
+                  if(0 == length)
+                  {
+                     return(false);
+                  }
+                  this->begin_pos = this->end_pos; // Last entry without a delimiter
+               }
+               this->scan_pos = this->begin_pos;
+
+               if('\n' == this->delimiter && 0 < length && '\r' == first[length - 1])
+               {
+                  --length;
+               }
+               if(0 < length)
+               {
+                  entry = std::string_view(first, length);
+                  ++this->delivered;
+                  return(true);
+               }
+            }
+         }
+
+         size_t capacity() const { return(this->buffer_size); }
+         size_t count() const { return(this->delivered); }
+
+         /************************************************************************/
+         /*
+         * \brief Single pass input iterator over the remaining entries
+         *
+         */
+         class iterator
+         {
+            private:
+
+               files_from_reader *reader = NULL;
+               std::string_view current;
+
+            public:
+
+               typedef std::input_iterator_tag iterator_category;
+               typedef std::string_view value_type;
+               typedef std::ptrdiff_t difference_type;
+               typedef const std::string_view *pointer;
+               typedef const std::string_view &reference;
+
+               iterator() = default;
+
+               explicit iterator(files_from_reader *reader_) : reader(reader_)
+               {
+                  ++(*this);
+               }
+
+               reference operator*() const { return(this->current); }
+               pointer operator->() const { return(&this->current); }
+
+               iterator &operator++()
+               {
+                  if(false == this->reader->next(this->current))
+                  {
+                     this->reader = NULL;
+                  }
+                  return(*this);
+               }
+
+               bool operator==(const iterator &other) const { return(this->reader == other.reader); }
+               bool operator!=(const iterator &other) const { return(this->reader != other.reader); }
+         };
+
+         iterator begin() { return(iterator(this)); }
+         iterator end() { return(iterator()); }
+   };
+
+   /************************************************************************/
+   /*
+   * \brief Lazy sequence of doubles given as a single option value. Nothing is
+   *        materialized for linear or logarithmic ranges, element i is computed
+   *        on demand in O(1). Accepted expressions:
+   *
+   *           start:step:stop      e.g. 0:0.5:360       (inclusive, like MATLAB)
+   *           start:stop:lin:count e.g. 0:1:lin:11      (count evenly spaced points)
+   *           start:stop:log:count e.g. 1e15:1e18:log:400 (count log spaced points)
+   *           v1,v2,v3             e.g. 1,2,5           (explicit list, stored)
+   *           v                    e.g. 42              (single value)
+   *
+   *        Bind it with typeid(cline_utils::range).name() like any other option.
+   *
+   */
+   class range
+   {
+      public:
+
+         enum range_kind : uint8_t
+         {
+            range_list   = 0, /**< Explicit values stored in list */
+            range_linear = 1, /**< start + i * step */
+            range_log    = 2  /**< start * (stop / start)^(i / (count - 1)) */
+         };
+
+      private:
+
+         range_kind kind;
+         double start;
+         double stop;
+         double step;
+         size_t count;
+         std::vector<double> list;
+         size_t cursor; /**< Point selected by CommandLineParser::next_sweep_point() */
+
+      public:
+
+      /************************************************************************/
+      /*
+      * \brief Empty range
+      *
+      */
+      range() : kind(range_list), start(0.0), stop(0.0), step(0.0), count(0), cursor(0)
+      {
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Linear range with count points starting at start_ spaced by step_
+      *
+      */
+      static range linear(double start_, double step_, size_t count_)
+      {
+         return(linear(start_, step_, count_, start_ + step_ * (count_ - 1)));
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Linear range whose last point is exactly stop_
+      *
+      */
+      static range linear(double start_, double step_, size_t count_, double stop_)
+      {
+         range result;
+         result.kind = range_linear;
+         result.start = start_;
+         result.step = step_;
+         result.stop = stop_;
+         result.count = count_;
+         return(result);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Logarithmic range with count points from start_ to stop_ inclusive
+      *
+      */
+      static range logarithmic(double start_, double stop_, size_t count_)
+      {
+         range result;
+         result.kind = range_log;
+         result.start = start_;
+         result.stop = stop_;
+         result.step = (count_ > 1) ? std::log(stop_ / start_) / (count_ - 1) : 0.0;
+         result.count = count_;
+         return(result);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Explicit list of values
+      *
+      */
+      static range values(const std::vector<double> &values_)
+      {
+         range result;
+         result.list = values_;
+         result.count = values_.size();
+         return(result);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Parse a range expression (see class description)
+      *
+      *     @param[in] std::string expression: Option argument
+      *     @return range: The lazy range
+      * 
+      */
+      static range parse(const std::string &expression)
+      {
+         std::vector<std::string> fields;
+         char separator = (std::string::npos != expression.find(':')) ? ':' : ',';
+         size_t first = 0;
+         while(true)
+         {
+            size_t last = expression.find(separator, first);
+            fields.push_back(expression.substr(first, last - first));
+            if(std::string::npos == last) break;
+            first = last + 1;
+         }
+
+         if(',' == separator)
+         {
+            std::vector<double> parsed;
+            parsed.reserve(fields.size());
+            for(size_t i = 0; i < fields.size(); ++i)
+            {
+               parsed.push_back(parse_number(fields[i], expression));
+            }
+            return(values(parsed));
+         }
+
+         if(3 == fields.size())
+         {
+            double start_ = parse_number(fields[0], expression);
+            double step_ = parse_number(fields[1], expression);
+            double stop_ = parse_number(fields[2], expression);
+
+            if(0.0 == step_ || !std::isfinite(step_) || (stop_ - start_) / step_ < 0.0)
+            {
+               throw_range_error("Step does not reach stop value", expression);
+            }
+
+            // Tolerate round off so that 0:0.1:1 includes 1
+            double intervals = std::floor((stop_ - start_) / step_ * (1.0 + 1e-12) + 1e-12);
+            if(!(intervals < 1e18))
+            {
+               throw_range_error("Too many points", expression);
+            }
+            return(linear(start_, step_, (size_t)intervals + 1));
+         }
+
+         if(4 == fields.size() && ("lin" == fields[2] || "log" == fields[2]))
+         {
+            double start_ = parse_number(fields[0], expression);
+            double stop_ = parse_number(fields[1], expression);
+
+            char *endPtr;
+            unsigned long long count_ = strtoull(fields[3].c_str(), &endPtr, 10);
+            if(fields[3].empty() || '\0' != *endPtr || '-' == fields[3][0] || 0 == count_)
+            {
+               throw_range_error("Point count must be a positive integer", expression);
+            }
+
+            if("lin" == fields[2])
+            {
+               double step_ = (count_ > 1) ? (stop_ - start_) / (count_ - 1) : 0.0;
+               return(linear(start_, step_, count_, (count_ > 1) ? stop_ : start_));
+            }
+
+            if(!(start_ / stop_ > 0.0))
+            {
+               throw_range_error("Logarithmic range limits must be non zero with equal signs", expression);
+            }
+            return(logarithmic(start_, stop_, count_));
+         }
+
+         throw_range_error("Unrecognized range expression", expression);
+         return(range());
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Number of points in the range
+      *
+      */
+      size_t size() const
+      {
+         return(this->count);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Point i of the range, computed in O(1). No bounds check.
+      *
+      */
+      double operator[](size_t i) const
+      {
+         switch(this->kind)
+         {
+            case range_linear:
+               // Exact end points even when step does not divide the interval evenly
+               return((i + 1 == this->count && this->count > 1) ? this->stop : this->start + this->step * i);
+
+            case range_log:
+               return((i + 1 == this->count && this->count > 1) ? this->stop : this->start * std::exp(this->step * i));
+
+            default:
+               return(this->list[i]);
+         }
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Point i of the range with bounds checking
+      *
+      */
+      double at(size_t i) const
+      {
+         if(i >= this->count)
+         {
+            throw_range_error("Index out of range", this->to_string());
+         }
+         return((*this)[i]);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Point of the current sweep configuration
+      *
+      */
+      double current() const
+      {
+         return((*this)[this->cursor]);
+      }
+
+      size_t get_cursor() const { return(this->cursor); }
+      void set_cursor(size_t cursor_) { this->cursor = cursor_; }
+
+      range_kind get_kind() const { return(this->kind); }
+      double get_start() const { return(this->start); }
+      double get_stop() const { return(this->stop); }
+      double get_step() const { return(this->step); }
+      const std::vector<double> &get_list() const { return(this->list); }
+
+      /************************************************************************/
+      /*
+      * \brief Short human readable form used by the summary tables
+      *
+      */
+      std::string to_string() const
+      {
+         std::stringstream ss("");
+         ss.precision(17);
+         switch(this->kind)
+         {
+            case range_linear:
+               ss << this->start << ":" << this->step << ":" << this->stop << " (" << this->count << ")";
+               break;
+
+            case range_log:
+               ss << this->start << ":" << this->stop << ":log:" << this->count;
+               break;
+
+            default:
+               for(size_t i = 0; i < this->list.size(); ++i)
+               {
+                  ss << ((0 == i) ? "" : ",") << this->list[i];
+               }
+               break;
+         }
+         return(ss.str());
+      }
+
+      private:
+
+      static double parse_number(const std::string &field, const std::string &expression)
+      {
+         char *endPtr;
+         double result = strtod(field.c_str(), &endPtr);
+         if(field.empty() || '\0' != *endPtr)
+         {
+            throw_range_error("Invalid number '" + field + "'", expression);
+         }
+         return(result);
+      }
+
+      static void throw_range_error(const std::string &what, const std::string &expression)
+      {
+         std::stringstream ss("");
+         ss << "*************************************************************************" << std::endl;
+         ss << "range::parse(...) - " << what << ": " << expression << std::endl;
+         ss << "*************************************************************************" << std::endl;
+         throw cline_utils::cline_exception(std::string(ss.str()));
+      }
+   };
+
+   /************************************************************************/
+   /*
+   * \brief Share of a parameter sweep given as "i/N": worker i (0 based) out
+   *        of N workers. Bind it with typeid(cline_utils::shard_spec).name() or
+   *        CommandLineParser::add_shard_option().
+   *
+   */
+   struct shard_spec
+   {
+      uint64_t index = 0; /**< Worker number, 0 <= index < count */
+      uint64_t count = 1; /**< Number of workers */
+
+      /************************************************************************/
+      /*
+      * \brief Parse "i/N"
+      *
+      *     @param[in] std::string expression: Option argument
+      *     @return shard_spec.
+      * 
+      */
+      static shard_spec parse(const std::string &expression)
+      {
+         shard_spec result;
+         char *endPtr;
+         const char *text = expression.c_str();
+
+         bool valid = ('\0' != *text && '-' != *text);
+         if(valid)
+         {
+            result.index = strtoull(text, &endPtr, 10);
+            valid = (endPtr != text && '/' == *endPtr && '-' != endPtr[1]);
+            text = endPtr + 1;
+         }
+         if(valid)
+         {
+            result.count = strtoull(text, &endPtr, 10);
+            valid = (endPtr != text && '\0' == *endPtr && 0 < result.count && result.index < result.count);
+         }
+
+         if(false == valid)
+         {
+            std::stringstream ss("");
+            ss << "*************************************************************************" << std::endl;
+            ss << "shard_spec::parse(...) - Expected i/N with 0 <= i < N: " << expression << std::endl;
+            ss << "*************************************************************************" << std::endl;
+            throw cline_utils::cline_exception(std::string(ss.str()));
+         }
+
+         return(result);
+      }
+
+      std::string to_string() const
+      {
+         return(std::to_string(this->index) + "/" + std::to_string(this->count));
+      }
+   };
+
+   /************************************************************************/
+   /*
+   * \brief Names of the values of an enumeration option. Build one with
+   *        enum_table::of(); make_option() keeps its own copy, so the table
+   *        may be a temporary. The names themselves are not copied and must
+   *        outlive the parser (string literals do).
+   *
+   *           static const cline_utils::enum_table modes =
+   *              cline_utils::enum_table::of<mode>({{"fast", mode::fast}, {"exact", mode::exact}});
+   *
+   */
+   struct enum_table
+   {
+      struct entry
+      {
+         const char *name;
+         int64_t value;
+      };
+
+      std::vector<entry> entries;
+      uint8_t width = 0;      /**< sizeof the enumeration */
+      bool is_signed = false; /**< Underlying type is signed */
+
+      template <typename E>
+      static enum_table of(std::initializer_list<std::pair<const char *, E>> names)
+      {
+         static_assert(std::is_enum_v<E>, "enum_table::of<E>() needs an enumeration");
+         enum_table result;
+         result.width = sizeof(E);
+         result.is_signed = std::is_signed_v<std::underlying_type_t<E>>;
+         for(const auto &name : names)
+         {
+            result.entries.push_back({name.first, int64_t(name.second)});
+         }
+         return(result);
+      }
+
+      const char *name_of(int64_t value) const
+      {
+         for(const entry &e : this->entries)
+         {
+            if(e.value == value) return(e.name);
+         }
+         return(NULL);
+      }
+   };
+
+   /************************************************************************/
+   /*
+   * \brief Tick period of a duration option in seconds (num / den)
+   *
+   */
+   struct duration_unit
+   {
+      int64_t num;
+      int64_t den;
+   };
+
+   /************************************************************************/
+   /*
+   * \brief Compile time description of a C++ type an option can be bound to.
+   *        code is the option_type the parser dispatches on. The 64 bit
+   *        integers, bool, enumerations and durations are "scalar" options:
+   *        they travel as 64 bits (to_bits / from_bits) in snapshots, shared
+   *        configurations and parse events.
+   *
+   *        Adding a type means adding a specialization here and a row to
+   *        scalar_type_ops below; the parser indexes the row by type code.
+   *
+   */
+   template <typename T, typename Enable = void>
+   struct option_traits
+   {
+      static constexpr cline_utils::option_type code = type_none;
+   };
+
+   template <> struct option_traits<std::string>             { static constexpr cline_utils::option_type code = type_string; };
+   template <> struct option_traits<double>                  { static constexpr cline_utils::option_type code = type_double; };
+   template <> struct option_traits<int>                     { static constexpr cline_utils::option_type code = type_int; };
+   template <> struct option_traits<float>                   { static constexpr cline_utils::option_type code = type_float; };
+   template <> struct option_traits<cline_utils::range>      { static constexpr cline_utils::option_type code = type_range; };
+   template <> struct option_traits<cline_utils::shard_spec> { static constexpr cline_utils::option_type code = type_shard; };
+   template <> struct option_traits<std::vector<std::string>> { static constexpr cline_utils::option_type code = type_string_list; };
+   template <> struct option_traits<std::vector<double>>      { static constexpr cline_utils::option_type code = type_double_array; };
+
+   template <typename T>
+   struct option_traits<T, std::enable_if_t<std::is_integral_v<T> && 8 == sizeof(T)>>
+   {
+      static constexpr cline_utils::option_type code = std::is_signed_v<T> ? type_int64 : type_uint64;
+      static uint64_t to_bits(T value) { return(uint64_t(value)); }
+      static T from_bits(uint64_t bits) { return(T(bits)); }
+   };
+
+   template <>
+   struct option_traits<bool>
+   {
+      static constexpr cline_utils::option_type code = type_bool;
+      static uint64_t to_bits(bool value) { return(value ? 1 : 0); }
+      static bool from_bits(uint64_t bits) { return(0 != bits); }
+   };
+
+   template <typename E>
+   struct option_traits<E, std::enable_if_t<std::is_enum_v<E>>>
+   {
+      static constexpr cline_utils::option_type code = type_enum;
+      static uint64_t to_bits(E value) { return(uint64_t(int64_t(value))); }
+      static E from_bits(uint64_t bits) { return(E(int64_t(bits))); }
+   };
+
+   template <typename Rep, typename Period>
+   struct option_traits<std::chrono::duration<Rep, Period>, std::enable_if_t<std::is_integral_v<Rep> && 8 == sizeof(Rep)>>
+   {
+      static constexpr cline_utils::option_type code = type_duration;
+      static constexpr cline_utils::duration_unit unit = {Period::num, Period::den};
+      static uint64_t to_bits(std::chrono::duration<Rep, Period> value) { return(uint64_t(value.count())); }
+      static std::chrono::duration<Rep, Period> from_bits(uint64_t bits) { return(std::chrono::duration<Rep, Period>(Rep(bits))); }
+   };
+
+   template <typename T>
+   inline constexpr bool is_scalar_option = (type_int64 <= option_traits<T>::code && type_duration >= option_traits<T>::code);
+
+   /************************************************************************/
+   /*
+   * \brief Value of a scalar option (see option_traits) held outside of its
+   *        bound variable
+   *
+   */
+   struct scalar_value
+   {
+      uint64_t bits;
+      cline_utils::option_type code; /**< Type the bits belong to */
+      const void *ctx;               /**< enum_table or duration_unit of the option */
+   };
+
+
+
+   /************************************************************************/
+   /*
+   * \brief Runtime conversion routines of the scalar option types, one row per
+   *        type code from type_int64 on. Conversions are range checked with
+   *        std::from_chars and fail instead of wrapping.
+   *
+   */
+   struct scalar_type_ops
+   {
+      const char *label;                                                   /**< Type shown by print_usage() */
+      bool (*parse)(const char *text, const void *ctx, uint64_t &bits, std::string &error);
+      void (*store)(void *dataVal, uint64_t bits, const void *ctx);
+      uint64_t (*load)(const void *dataVal, const void *ctx);
+      std::string (*format)(uint64_t bits, const void *ctx);
+
+      /************************************************************************/
+      /*
+      * \brief Row of a scalar type code
+      *
+      *     @param[in] option_type code: Type code of the option
+      *     @return const scalar_type_ops *: NULL if code is not a scalar type
+      * 
+      */
+      static const scalar_type_ops *get(cline_utils::option_type code)
+      {
+         static const scalar_type_ops table[] =
+            {
+               {"int64 ",    parse_int64,    store_word, load_word, format_int64},
+               {"uint64 ",   parse_uint64,   store_word, load_word, format_uint64},
+               {"bool ",     parse_bool,     store_bool, load_bool, format_bool},
+               {"enum ",     parse_enum,     store_enum, load_enum, format_enum},
+               {"duration ", parse_duration, store_word, load_word, format_duration},
+            };
+         return((type_int64 <= code && type_duration >= code) ? &table[code - type_int64] : NULL);
+      }
+
+      template <typename T>
+      static bool parse_integer(const char *text, T &value, std::string &error)
+      {
+         const char *last = text + strlen(text);
+         int base = 10;
+         const char *first = text;
+         bool negative = false;
+         if(std::is_signed_v<T> && '-' == *first)
+         {
+            negative = true;
+            ++first;
+         }
+         if('0' == first[0] && ('x' == first[1] || 'X' == first[1]))
+         {
+            base = 16;
+            first += 2;
+         }
+
+         // Parse the magnitude unsigned so the minimum value is reachable
+         uint64_t magnitude = 0;
+         auto result = std::from_chars(first, last, magnitude, base);
+         if(result.ec == std::errc::invalid_argument || result.ptr != last || first == last)
+         {
+            error = "not an integer";
+            return(false);
+         }
+         const uint64_t limit = negative ? uint64_t(std::numeric_limits<T>::max()) + 1 : uint64_t(std::numeric_limits<T>::max());
+         if(result.ec == std::errc::result_out_of_range || magnitude > limit)
+         {
+            error = "out of range [" + std::to_string(std::numeric_limits<T>::min()) + ", " + std::to_string(std::numeric_limits<T>::max()) + "]";
+            return(false);
+         }
+         value = negative ? T(0 - magnitude) : T(magnitude);
+         return(true);
+      }
+
+      static bool parse_int64(const char *text, const void *, uint64_t &bits, std::string &error)
+      {
+         int64_t value;
+         if(false == parse_integer(text, value, error)) return(false);
+         bits = uint64_t(value);
+         return(true);
+      }
+
+      static bool parse_uint64(const char *text, const void *, uint64_t &bits, std::string &error)
+      {
+         return(parse_integer(text, bits, error));
+      }
+
+      static bool parse_bool(const char *text, const void *, uint64_t &bits, std::string &error)
+      {
+         static const char *truths[] = {"", "1", "true", "yes", "on"};
+         static const char *lies[] = {"0", "false", "no", "off"};
+         for(const char *word : truths) if(0 == strcasecmp(word, text)) { bits = 1; return(true); }
+         for(const char *word : lies) if(0 == strcasecmp(word, text)) { bits = 0; return(true); }
+         error = "not a boolean (true/false, yes/no, on/off, 1/0)";
+         return(false);
+      }
+
+      static bool parse_enum(const char *text, const void *ctx, uint64_t &bits, std::string &error)
+      {
+         const cline_utils::enum_table &names = *(const cline_utils::enum_table *)ctx;
+         for(const auto &e : names.entries)
+         {
+            if(0 == strcmp(e.name, text))
+            {
+               bits = uint64_t(e.value);
+               return(true);
+            }
+         }
+         error = "not one of:";
+         for(const auto &e : names.entries)
+         {
+            error += std::string(" ") + e.name;
+         }
+         return(false);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Integer count with an optional unit (ns, us, ms, s, min, h, d).
+      *        Without a unit the count is in the option's own period. The
+      *        conversion must be exact and fit the 64 bit count.
+      *
+      */
+      static bool parse_duration(const char *text, const void *ctx, uint64_t &bits, std::string &error)
+      {
+         static const struct { const char *suffix; int64_t num, den; } units[] =
+            {{"ns", 1, 1000000000}, {"us", 1, 1000000}, {"ms", 1, 1000}, {"min", 60, 1}, {"s", 1, 1}, {"h", 3600, 1}, {"d", 86400, 1}};
+         const cline_utils::duration_unit &target = *(const cline_utils::duration_unit *)ctx;
+
+         size_t length = strlen(text);
+         size_t digits = length;
+         while(0 < digits && 0 != isalpha((unsigned char)text[digits - 1])) --digits;
+
+         cline_utils::duration_unit unit = target;
+         if(digits < length)
+         {
+            bool found = false;
+            for(const auto &u : units)
+            {
+               if(0 == strcmp(u.suffix, text + digits))
+               {
+                  unit = {u.num, u.den};
+                  found = true;
+               }
+            }
+            if(false == found)
+            {
+               error = "unknown duration unit '" + std::string(text + digits) + "' (ns, us, ms, s, min, h, d)";
+               return(false);
+            }
+         }
+
+         std::string number(text, digits);
+         int64_t count;
+         if(false == parse_integer(number.c_str(), count, error)) return(false);
+
+         // count * unit / target, exactly
+         __int128 numerator = __int128(count) * unit.num * target.den;
+         __int128 denominator = __int128(unit.den) * target.num;
+         if(0 != numerator % denominator)
+         {
+            error = "not a whole number of the option's ticks";
+            return(false);
+         }
+         __int128 ticks = numerator / denominator;
+         if(ticks > std::numeric_limits<int64_t>::max() || ticks < std::numeric_limits<int64_t>::min())
+         {
+            error = "out of range of a 64 bit duration";
+            return(false);
+         }
+         bits = uint64_t(int64_t(ticks));
+         return(true);
+      }
+
+      static void store_word(void *dataVal, uint64_t bits, const void *) { memcpy(dataVal, &bits, sizeof(bits)); }
+      static uint64_t load_word(const void *dataVal, const void *) { uint64_t bits; memcpy(&bits, dataVal, sizeof(bits)); return(bits); }
+      static void store_bool(void *dataVal, uint64_t bits, const void *) { *(bool *)dataVal = (0 != bits); }
+      static uint64_t load_bool(const void *dataVal, const void *) { return(*(const bool *)dataVal ? 1 : 0); }
+
+      static void store_enum(void *dataVal, uint64_t bits, const void *ctx)
+      {
+         switch(((const cline_utils::enum_table *)ctx)->width)
+         {
+            case 1: *(uint8_t *)dataVal = uint8_t(bits); break;
+            case 2: *(uint16_t *)dataVal = uint16_t(bits); break;
+            case 4: *(uint32_t *)dataVal = uint32_t(bits); break;
+            default: *(uint64_t *)dataVal = bits; break;
+         }
+      }
+
+      static uint64_t load_enum(const void *dataVal, const void *ctx)
+      {
+         const cline_utils::enum_table &names = *(const cline_utils::enum_table *)ctx;
+         switch(names.width)
+         {
+            case 1: return(names.is_signed ? uint64_t(int64_t(*(const int8_t *)dataVal)) : *(const uint8_t *)dataVal);
+            case 2: return(names.is_signed ? uint64_t(int64_t(*(const int16_t *)dataVal)) : *(const uint16_t *)dataVal);
+            case 4: return(names.is_signed ? uint64_t(int64_t(*(const int32_t *)dataVal)) : *(const uint32_t *)dataVal);
+            default: return(*(const uint64_t *)dataVal);
+         }
+      }
+
+      static std::string format_int64(uint64_t bits, const void *) { return(std::to_string(int64_t(bits))); }
+      static std::string format_uint64(uint64_t bits, const void *) { return(std::to_string(bits)); }
+      static std::string format_bool(uint64_t bits, const void *) { return((0 != bits) ? "true" : "false"); }
+
+      static std::string format_enum(uint64_t bits, const void *ctx)
+      {
+         const char *name = ((const cline_utils::enum_table *)ctx)->name_of(int64_t(bits));
+         return((NULL != name) ? name : std::to_string(int64_t(bits)));
+      }
+
+      static std::string format_duration(uint64_t bits, const void *ctx)
+      {
+         const cline_utils::duration_unit &unit = *(const cline_utils::duration_unit *)ctx;
+         std::string result = std::to_string(int64_t(bits));
+         if(1 == unit.num && 1000000000 == unit.den) return(result + "ns");
+         if(1 == unit.num && 1000000 == unit.den) return(result + "us");
+         if(1 == unit.num && 1000 == unit.den) return(result + "ms");
+         if(1 == unit.num && 1 == unit.den) return(result + "s");
+         if(60 == unit.num && 1 == unit.den) return(result + "min");
+         if(3600 == unit.num && 1 == unit.den) return(result + "h");
+         return(result + " x " + std::to_string(unit.num) + "/" + std::to_string(unit.den) + "s");
+      }
+   };
+
+   /************************************************************************/
+   /*
+   * \brief Build an option bound to value with the type picked at compile
+   *        time from option_traits<T>. bool options are flags (no argument,
+   *        but --name=false works); every other type needs an argument. A
+   *        std::vector<std::string> collects every occurrence of the option.
+   *
+   *     @param[in] const char *name: Long name of the option
+   *     @param[in] int val: Short character, or a value outside the printable range for long only options
+   *     @param[in] T &value: Bound variable, holds the default until parsed
+   *     @param[in] std::string description: Description printed in the usage table
+   *     @param[in] int is_mandatory_opt: required_option or optional_option
+   *     @param[in] std::vector<option_constraint> constraints: Optional value checks
+   *     @return option_longer: Option ready for add_option()
+   * 
+   */
+   template <typename T>
+   cline_utils::option_longer make_option(const char *name, int val, T &value, std::string description,
+                                          int is_mandatory_opt = optional_option, std::vector<cline_utils::option_constraint> constraints = {})
+   {
+      static_assert(type_none != option_traits<T>::code, "make_option<T>() has no option_traits for T");
+      static_assert(false == std::is_enum_v<T>, "Enumeration options need an enum_table, use make_option(name, val, value, names, description)");
+
+      // Strings keep the typeid the rest of the parser has always used for them
+      const char *type_name = std::is_same_v<T, std::string> ? typeid(char *).name() : typeid(T).name();
+      cline_utils::option_longer result(name, std::is_same_v<T, bool> ? no_argument : required_argument, NULL, val, is_mandatory_opt,
+                                        type_name, &value, description, constraints);
+      result.type_code = option_traits<T>::code;
+      if constexpr (type_duration == option_traits<T>::code)
+      {
+         result.ctx = &option_traits<T>::unit;
+      }
+      return(result);
+   }
+
+   template <typename E>
+   cline_utils::option_longer make_option(const char *name, int val, E &value, const cline_utils::enum_table &names, std::string description,
+                                          int is_mandatory_opt = optional_option)
+   {
+      static_assert(std::is_enum_v<E>, "make_option() with an enum_table needs an enumeration");
+      cline_utils::option_longer result(name, required_argument, NULL, val, is_mandatory_opt, typeid(E).name(), &value, description);
+      result.type_code = type_enum;
+      // Own a copy: the table is often built inline and gone before parsing
+      auto owned = std::make_shared<const cline_utils::enum_table>(names);
+      result.ctx = owned.get();
+      result.ctx_owner = std::move(owned);
+      return(result);
+   }
+
+   /************************************************************************/
+   /*
+   * \brief Typed copy of one option value, independent of the bound variable
+   *
+   */
+   typedef std::variant<std::monostate, std::string, double, int, float, cline_utils::range, cline_utils::shard_spec, cline_utils::scalar_value,
+                        std::vector<std::string>, std::vector<double>> option_value;
+
+   /************************************************************************/
+   /*
+   * \brief Typed access to an option_value. Scalar options are returned by
+   *        value (decoded from their bits), everything else by reference.
+   *
+   */
+   template <typename T>
+   using option_get_t = std::conditional_t<is_scalar_option<T>, T, const T &>;
+
+   /************************************************************************/
+   /*
+   * \brief Check that value holds a T
+   *
+   *     @param[in] const option_value *value: Value, may be NULL
+   *     @return bool: true if get_option_value<T>(value) is valid
+   * 
+   */
+   template <typename T>
+   bool holds_option_value(const cline_utils::option_value *value)
+   {
+      if(NULL == value) return(false);
+      if constexpr (is_scalar_option<T>)
+      {
+         const cline_utils::scalar_value *held = std::get_if<cline_utils::scalar_value>(value);
+         if(NULL == held || option_traits<T>::code != held->code) return(false);
+         if constexpr (type_duration == option_traits<T>::code)
+         {
+            // A count is only meaningful in the period it was parsed for
+            const cline_utils::duration_unit &unit = *(const cline_utils::duration_unit *)held->ctx;
+            return(unit.num == option_traits<T>::unit.num && unit.den == option_traits<T>::unit.den);
+         }
+         return(true);
+      }
+      else
+      {
+         return(std::holds_alternative<T>(*value));
+      }
+   }
+
+   template <typename T>
+   option_get_t<T> get_option_value(const cline_utils::option_value &value)
+   {
+      if constexpr (is_scalar_option<T>)
+      {
+         return(option_traits<T>::from_bits(std::get<cline_utils::scalar_value>(value).bits));
+      }
+      else
+      {
+         return(std::get<T>(value));
+      }
+   }
+
+   /************************************************************************/
+   /*
+   * \brief Immutable copy of every resolved option value, published by
+   *        CommandLineParser::publish_snapshot() and reload_config(). Values
+   *        are in option configuration order; look an index up once with
+   *        find() and use get<T>(index) on the hot path.
+   *
+   */
+   struct config_snapshot
+   {
+      uint64_t version;                                   /**< 1 for the first published snapshot, +1 per reload */
+      std::vector<cline_utils::option_value> values;      /**< One per configured option */
+      std::vector<cline_utils::option_source> sources;    /**< Where each value came from */
+      std::shared_ptr<const std::unordered_map<std::string, size_t>> name_index; /**< Long name -> index */
+
+      /************************************************************************/
+      /*
+      * \brief Index of the option with the given long name
+      *
+      *     @param[in] std::string name: Long name of the option
+      *     @return size_t: Index or std::string::npos if unknown
+      * 
+      */
+      size_t find(const std::string &name) const
+      {
+         auto itr = this->name_index->find(name);
+         return((itr == this->name_index->end()) ? std::string::npos : itr->second);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Typed value of option index
+      *
+      */
+      template <typename T>
+      cline_utils::option_get_t<T> get(size_t index) const
+      {
+         if(index >= this->values.size() || false == cline_utils::holds_option_value<T>(&this->values[index]))
+         {
+            std::stringstream ss("");
+            ss << "*************************************************************************" << std::endl;
+            ss << "config_snapshot::get(...) - No option of the requested type at index " << index << std::endl;
+            ss << "*************************************************************************" << std::endl;
+            throw cline_utils::cline_exception(std::string(ss.str()));
+         }
+         return(cline_utils::get_option_value<T>(this->values[index]));
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Typed value of the option with the given long name
+      *
+      */
+      template <typename T>
+      cline_utils::option_get_t<T> get(const std::string &name) const
+      {
+         return(this->get<T>(this->find(name)));
+      }
+   };
+
+   typedef cline_utils::rcu_cell<cline_utils::config_snapshot>::reader snapshot_reader;
+
+   /************************************************************************/
+   /*
+   * \brief One option or positional argument delivered by the streaming parse
+   *        (CommandLineParser::stream_command_line). Pointers and views are
+   *        only valid during the callback.
+   *
+   */
+   struct parse_event
+   {
+      enum event_kind : uint8_t
+      {
+         event_option     = 0, /**< Option with its converted argument */
+         event_positional = 1  /**< Non-option argument */
+      };
+
+      event_kind kind;
+      int option_index;                    /**< Index of the option, -1 for positionals */
+      int val;                             /**< Short character or long only value, 0 for positionals */
+      const char *name;                    /**< Long name of the option, NULL for positionals */
+      std::string_view text;               /**< Argument text as given */
+      uint64_t position;                   /**< Count of events of the same kind before this one */
+      const cline_utils::option_value *value; /**< Converted argument, NULL for positionals */
+
+      /************************************************************************/
+      /*
+      * \brief Converted option argument
+      *
+      */
+      template <typename T>
+      cline_utils::option_get_t<T> get() const
+      {
+         if(false == cline_utils::holds_option_value<T>(this->value))
+         {
+            std::stringstream ss("");
+            ss << "*************************************************************************" << std::endl;
+            ss << "parse_event::get(...) - Event does not hold a value of the requested type: " << this->text << std::endl;
+            ss << "*************************************************************************" << std::endl;
+            throw cline_utils::cline_exception(std::string(ss.str()));
+         }
+         return(cline_utils::get_option_value<T>(*this->value));
+      }
+   };
+
+   typedef std::function<bool(const cline_utils::parse_event &)> event_callback;
+
+   /************************************************************************/
+   /*
+   * \brief Fixed binary layout of a configuration published to shared memory
+   *        by CommandLineParser::publish_shared_config(). All offsets are from
+   *        the start of the segment.
+   *
+   *           shared_config_header
+   *           shared_config_entry[option_count]
+   *           uint32_t hash_slots[slot_count]   (entry index + 1, 0 if empty)
+   *           names, string values and range records (8 byte aligned)
+   *
+   */
+   struct shared_config_header
+   {
+      char     magic[4];       /**< "CLSM" */
+      uint16_t version;
+      uint16_t bom;            /**< 0xFEFF as written, detects a foreign byte order */
+      uint32_t option_count;
+      uint32_t slot_count;     /**< Power of two */
+      uint64_t total_size;
+      uint64_t entries_offset;
+      uint64_t slots_offset;
+      uint64_t data_offset;
+      uint8_t  reserved[16];
+   };
+
+   struct shared_config_entry
+   {
+      int32_t  val;
+      uint8_t  type;           /**< option_type */
+      uint8_t  source;         /**< option_source */
+      uint16_t name_length;
+      uint64_t name_offset;
+      union
+      {
+         double   real;        /**< type_double */
+         float    single;      /**< type_float */
+         int32_t  integer;     /**< type_int */
+         struct { uint64_t offset, length; } text;  /**< type_string, type_string_list: elements each followed by NUL */
+         struct { uint64_t index, count; } shard;   /**< type_shard */
+         struct { uint64_t offset, count; } points; /**< type_range: record {uint64 kind, double start, stop, step, [list values]}; type_double_array: count doubles */
+         uint64_t bits;        /**< type_int64 and later: option_traits<T>::to_bits() */
+         struct { int64_t count, num, den; } duration; /**< type_duration: count of num/den seconds */
+      } value;
+   };
+
+   static_assert(sizeof(shared_config_header) == 64, "shared_config_header layout");
+   static_assert(sizeof(shared_config_entry) == 40, "shared_config_entry layout");
+
+   /************************************************************************/
+   /*
+   * \brief Read only view of a configuration published to shared memory.
+   *        Attaching maps the segment and checks the header, so it costs the
+   *        same however many options there are; values are read in place and
+   *        each slot, name and value is bounds checked as it is read.
+   *
+   */
+   class shared_config_view
+   {
+      private:
+
+         const char *base = NULL;
+         size_t length = 0;
+
+         const cline_utils::shared_config_header &header() const
+         {
+            return(*(const cline_utils::shared_config_header *)this->base);
+         }
+
+         /** True if [offset, offset + size) lies within [0, limit) */
+         static bool fits(uint64_t offset, uint64_t size, uint64_t limit)
+         {
+            return(offset <= limit && size <= limit - offset);
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Check that the value of an entry lies in the segment. Entries are
+         *        checked as they are read, so attaching stays independent of
+         *        the number of options.
+         *
+         */
+         bool value_in_bounds(const cline_utils::shared_config_entry &e) const
+         {
+            const uint64_t total_size = this->header().total_size;
+            switch(e.type)
+            {
+               case type_string:
+                  return(fits(e.value.text.offset, e.value.text.length, total_size));
+
+               case type_string_list:
+                  // Every element is followed by a NUL, so the last byte must be one
+                  return(fits(e.value.text.offset, e.value.text.length, total_size) &&
+                         (0 == e.value.text.length || '\0' == this->base[e.value.text.offset + e.value.text.length - 1]));
+
+               case type_double_array:
+                  return(e.value.points.count <= total_size / sizeof(double) &&
+                         fits(e.value.points.offset, e.value.points.count * sizeof(double), total_size));
+
+               case type_range:
+               {
+                  const uint64_t record = sizeof(uint64_t) + 3 * sizeof(double);
+                  if(false == fits(e.value.points.offset, record, total_size))
+                  {
+                     return(false);
+                  }
+                  uint64_t kind;
+                  memcpy(&kind, this->base + e.value.points.offset, sizeof(kind));
+                  return(cline_utils::range::range_list != kind ||
+                         (e.value.points.count <= total_size / sizeof(double) &&
+                          fits(e.value.points.offset + record, e.value.points.count * sizeof(double), total_size)));
+               }
+
+               default:
+                  return(true);
+            }
+         }
+
+         static void throw_view_error(const std::string &what)
+         {
+            std::stringstream ss("");
+            ss << "*************************************************************************" << std::endl;
+            ss << "shared_config_view(...) - " << what << std::endl;
+            ss << "*************************************************************************" << std::endl;
+            throw cline_utils::cline_exception(std::string(ss.str()));
+         }
+
+      public:
+
+         static constexpr char magic[4] = {'C', 'L', 'S', 'M'};
+         static constexpr uint16_t layout_version = 3;
+
+         /************************************************************************/
+         /*
+         * \brief FNV-1a of a long name, used for the hash slots
+         *
+         */
+         static uint32_t hash_name(const char *name, size_t name_length)
+         {
+            uint32_t h = 2166136261u;
+            for(size_t i = 0; i < name_length; ++i)
+            {
+               h = (h ^ (unsigned char)name[i]) * 16777619u;
+            }
+            return(h);
+         }
+
+         shared_config_view() = default;
+         shared_config_view(const shared_config_view &) = delete;
+         shared_config_view &operator=(const shared_config_view &) = delete;
+
+         shared_config_view(shared_config_view &&other) : base(other.base), length(other.length)
+         {
+            other.base = NULL;
+            other.length = 0;
+         }
+
+         ~shared_config_view()
+         {
+            if(NULL != this->base)
+            {
+               munmap((void *)this->base, this->length);
+            }
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Map a published configuration
+         *
+         *     @param[in] int fd: Descriptor returned by publish_shared_config(), inherited or received
+         *     @return shared_config_view: View valid while it exists (the fd may be closed)
+         * 
+         */
+         static shared_config_view attach(int fd)
+         {
+            struct stat info;
+            if(0 != fstat(fd, &info) || info.st_size < (off_t)sizeof(cline_utils::shared_config_header))
+            {
+               throw_view_error("Not a shared configuration descriptor: " + std::to_string(fd));
+            }
+
+            void *mapped = mmap(NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+            if(MAP_FAILED == mapped)
+            {
+               throw_view_error(std::string("Unable to map shared configuration: ") + strerror(errno));
+            }
+
+            shared_config_view view;
+            view.base = (const char *)mapped;
+            view.length = info.st_size;
+
+            const cline_utils::shared_config_header &h = view.header();
+            if(0 != memcmp(h.magic, magic, sizeof(magic)) || layout_version != h.version || 0xFEFF != h.bom ||
+               h.total_size != view.length || h.entries_offset < sizeof(h) ||
+               0 != h.entries_offset % alignof(cline_utils::shared_config_entry) || 0 != h.slots_offset % alignof(uint32_t) ||
+               false == fits(h.entries_offset, uint64_t(h.option_count) * sizeof(cline_utils::shared_config_entry), h.slots_offset) ||
+               false == fits(h.slots_offset, uint64_t(h.slot_count) * sizeof(uint32_t), h.data_offset) || h.data_offset > h.total_size)
+            {
+               throw_view_error("Invalid shared configuration layout");
+            }
+
+            // find() masks with slot_count - 1
+            if(0 == h.slot_count || 0 != (h.slot_count & (h.slot_count - 1)))
+            {
+               throw_view_error("Invalid shared configuration hash slots");
+            }
+            return(view);
+         }
+
+         size_t size() const { return(this->header().option_count); }
+
+         const cline_utils::shared_config_entry &entry(size_t index) const
+         {
+            return(((const cline_utils::shared_config_entry *)(this->base + this->header().entries_offset))[index]);
+         }
+
+         std::string_view name(size_t index) const
+         {
+            const cline_utils::shared_config_entry &e = this->entry(index);
+            if(e.name_offset < this->header().data_offset || false == fits(e.name_offset, e.name_length, this->header().total_size))
+            {
+               throw_view_error("Shared configuration entry " + std::to_string(index) + " out of bounds");
+            }
+            return(std::string_view(this->base + e.name_offset, e.name_length));
+         }
+
+         cline_utils::option_type type(size_t index) const { return(cline_utils::option_type(this->entry(index).type)); }
+         cline_utils::option_source source(size_t index) const { return(cline_utils::option_source(this->entry(index).source)); }
+
+         /************************************************************************/
+         /*
+         * \brief Index of the option with the given long name
+         *
+         *     @param[in] std::string_view name: Long name of the option
+         *     @return size_t: Index or std::string::npos if unknown
+         * 
+         */
+         size_t find(std::string_view name) const
+         {
+            const cline_utils::shared_config_header &h = this->header();
+            const uint32_t *slots = (const uint32_t *)(this->base + h.slots_offset);
+            const uint32_t mask = h.slot_count - 1;
+            uint32_t slot = hash_name(name.data(), name.size()) & mask;
+            for(uint32_t probe = 0; probe < h.slot_count && 0 != slots[slot]; ++probe, slot = (slot + 1) & mask)
+            {
+               if(slots[slot] > h.option_count)
+               {
+                  throw_view_error("Invalid shared configuration hash slots");
+               }
+               if(this->name(slots[slot] - 1) == name)
+               {
+                  return(slots[slot] - 1);
+               }
+            }
+            return(std::string::npos);
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Typed value of an option. Strings are returned as views into
+         *        the segment (T = std::string_view) or copied (T = std::string).
+         *
+         */
+         template <typename T>
+         T get(size_t index) const
+         {
+            if(index >= this->size())
+            {
+               throw_view_error("No option at index " + std::to_string(index));
+            }
+
+            const cline_utils::shared_config_entry &e = this->entry(index);
+            const cline_utils::option_type expected =
+               std::is_same_v<T, std::string_view> ? type_string : cline_utils::option_traits<T>::code;
+            bool matches = (expected == e.type);
+            if constexpr (type_duration == cline_utils::option_traits<T>::code)
+            {
+               matches = matches && e.value.duration.num == cline_utils::option_traits<T>::unit.num &&
+                                    e.value.duration.den == cline_utils::option_traits<T>::unit.den;
+            }
+            if(false == matches)
+            {
+               throw_view_error("Option " + std::string(this->name(index)) + " does not hold the requested type");
+            }
+            if(false == this->value_in_bounds(e))
+            {
+               throw_view_error("Shared configuration entry " + std::to_string(index) + " out of bounds");
+            }
+
+            if constexpr (std::is_same_v<T, std::string_view> || std::is_same_v<T, std::string>)
+            {
+               return(T(this->base + e.value.text.offset, e.value.text.length));
+            }
+            else if constexpr (std::is_same_v<T, double>) { return(e.value.real); }
+            else if constexpr (std::is_same_v<T, int>)    { return(e.value.integer); }
+            else if constexpr (std::is_same_v<T, float>)  { return(e.value.single); }
+            else if constexpr (cline_utils::is_scalar_option<T>) { return(cline_utils::option_traits<T>::from_bits(e.value.bits)); }
+            else if constexpr (std::is_same_v<T, std::vector<std::string>>)
+            {
+               std::vector<std::string> list;
+               const char *first = this->base + e.value.text.offset;
+               const char *last = first + e.value.text.length;
+               for(const char *end; first < last; first = end + 1)
+               {
+                  end = (const char *)memchr(first, '\0', last - first);
+                  list.emplace_back(first, end - first);
+               }
+               return(list);
+            }
+            else if constexpr (std::is_same_v<T, std::vector<double>>)
+            {
+               const double *first = (const double *)(this->base + e.value.points.offset);
+               return(std::vector<double>(first, first + e.value.points.count));
+            }
+            else if constexpr (std::is_same_v<T, cline_utils::shard_spec>)
+            {
+               cline_utils::shard_spec shard;
+               shard.index = e.value.shard.index;
+               shard.count = e.value.shard.count;
+               return(shard);
+            }
+            else
+            {
+               static_assert(std::is_same_v<T, cline_utils::range>, "shared_config_view::get<T>() does not support T");
+               const char *record = this->base + e.value.points.offset;
+               uint64_t kind;
+               double parameters[3];
+               memcpy(&kind, record, sizeof(kind));
+               memcpy(parameters, record + sizeof(kind), sizeof(parameters));
+               const uint64_t count = e.value.points.count;
+               if(cline_utils::range::range_list == kind)
+               {
+                  const double *list = (const double *)(record + sizeof(kind) + sizeof(parameters));
+                  return(cline_utils::range::values(std::vector<double>(list, list + count)));
+               }
+               return((cline_utils::range::range_log == kind) ?
+                  cline_utils::range::logarithmic(parameters[0], parameters[1], count) :
+                  cline_utils::range::linear(parameters[0], parameters[2], count, parameters[1]));
+            }
+         }
+
+         template <typename T>
+         T get(std::string_view name) const
+         {
+            size_t index = this->find(name);
+            if(std::string::npos == index)
+            {
+               throw_view_error("Unknown option " + std::string(name));
+            }
+            return(this->get<T>(index));
+         }
+   };
+
+   /************************************************************************/
+   /*
+   * \brief Owned argc/argv built in process, for tests and for re-parsing.
+   *        The NULL terminated pointer array and the argument text share one
+   *        allocation: [char *argv[capacity + 1]][text]. Growing moves both
+   *        and rebases the pointers, so argv() is only valid until the next
+   *        modification.
+   *
+   *           cline_utils::ArgvBuilder args = cline_utils::ArgvBuilder::split("tool -b 4 --name='a b'");
+   *           cline_utils::CommandLineParser cline(args.argc(), args.argv(), options);
+   *
+   */
+   class ArgvBuilder
+   {
+      private:
+
+         char *block = NULL;
+         size_t count = 0;           /**< Arguments held */
+         size_t pointer_capacity = 0; /**< Arguments that fit before growing */
+         size_t text_used = 0;
+         size_t text_capacity = 0;
+
+         char **pointers() const { return((char **)this->block); }
+         char *text() const { return(this->block + (this->pointer_capacity + 1) * sizeof(char *)); }
+
+         /************************************************************************/
+         /*
+         * \brief Make room for arguments and text bytes, moving to a new block
+         *        if needed
+         *
+         */
+         void reserve(size_t arguments, size_t bytes)
+         {
+            if(NULL != this->block && arguments <= this->pointer_capacity && bytes <= this->text_capacity)
+            {
+               return;
+            }
+
+            size_t new_pointers = std::max({arguments, 2 * this->pointer_capacity, size_t(8)});
+            size_t new_text = std::max({bytes, 2 * this->text_capacity, size_t(128)});
+            char *new_block = new char[(new_pointers + 1) * sizeof(char *) + new_text];
+            char *new_text_start = new_block + (new_pointers + 1) * sizeof(char *);
+
+            if(NULL != this->block)
+            {
+               memcpy(new_text_start, this->text(), this->text_used);
+               for(size_t i = 0; i < this->count; ++i)
+               {
+                  ((char **)new_block)[i] = new_text_start + (this->pointers()[i] - this->text());
+               }
+               delete[] this->block;
+            }
+            ((char **)new_block)[this->count] = NULL;
+
+            this->block = new_block;
+            this->pointer_capacity = new_pointers;
+            this->text_capacity = new_text;
+         }
+
+         static void throw_split_error(const std::string &what)
+         {
+            std::stringstream ss("");
+            ss << "*************************************************************************" << std::endl;
+            ss << "ArgvBuilder::split(...) - " << what << std::endl;
+            ss << "*************************************************************************" << std::endl;
+            throw cline_utils::cline_exception(std::string(ss.str()));
+         }
+
+      public:
+
+         ArgvBuilder()
+         {
+         }
+
+         ArgvBuilder(std::initializer_list<std::string_view> arguments)
+         {
+            size_t bytes = 0;
+            for(std::string_view argument : arguments) bytes += argument.size() + 1;
+            this->reserve(arguments.size(), bytes);
+            for(std::string_view argument : arguments) this->push_back(argument);
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Deep copy of an existing argument vector
+         *
+         *     @param[in] int argc: Number of arguments
+         *     @param[in] const char *const *argv: Arguments
+         *
+         */
+         ArgvBuilder(int argc, const char *const *argv)
+         {
+            size_t bytes = 0;
+            for(int i = 0; i < argc; ++i) bytes += strlen(argv[i]) + 1;
+            this->reserve(argc, bytes);
+            for(int i = 0; i < argc; ++i) this->push_back(argv[i]);
+         }
+
+         ArgvBuilder(const ArgvBuilder &other)
+         {
+            this->reserve(other.count, other.text_used);
+            for(size_t i = 0; i < other.count; ++i) this->push_back(other[i]);
+         }
+
+         ArgvBuilder(ArgvBuilder &&other) noexcept
+         {
+            *this = std::move(other);
+         }
+
+         ArgvBuilder &operator=(const ArgvBuilder &other)
+         {
+            if(this != &other)
+            {
+               this->clear();
+               this->reserve(other.count, other.text_used);
+               for(size_t i = 0; i < other.count; ++i) this->push_back(other[i]);
+            }
+            return(*this);
+         }
+
+         ArgvBuilder &operator=(ArgvBuilder &&other) noexcept
+         {
+            std::swap(this->block, other.block);
+            std::swap(this->count, other.count);
+            std::swap(this->pointer_capacity, other.pointer_capacity);
+            std::swap(this->text_used, other.text_used);
+            std::swap(this->text_capacity, other.text_capacity);
+            return(*this);
+         }
+
+         ~ArgvBuilder()
+         {
+            delete[] this->block;
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Append one argument (copied). The argument may be one of this
+         *        builder's own, e.g. b.push_back(b.argv()[1]).
+         *
+         */
+         ArgvBuilder &push_back(std::string_view argument)
+         {
+            // Growing frees the old block, so find an argument held in it first
+            std::less<const char *> before;
+            if(NULL != this->block && false == before(argument.data(), this->text()) && before(argument.data(), this->text() + this->text_used))
+            {
+               const size_t offset = argument.data() - this->text();
+               this->reserve(this->count + 1, this->text_used + argument.size() + 1);
+               argument = std::string_view(this->text() + offset, argument.size());
+            }
+            this->reserve(this->count + 1, this->text_used + argument.size() + 1);
+            char *destination = this->text() + this->text_used;
+            memcpy(destination, argument.data(), argument.size());
+            destination[argument.size()] = '\0';
+            this->text_used += argument.size() + 1;
+            this->pointers()[this->count++] = destination;
+            this->pointers()[this->count] = NULL;
+            return(*this);
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Append the words of a command line. Words are separated by white
+         *        space; single quotes keep everything literally, double quotes
+         *        and a backslash escape the next character like a POSIX shell.
+         *
+         *     @param[in] std::string_view command_line: Text to split
+         *     @return ArgvBuilder &: This builder
+         * 
+         */
+         ArgvBuilder &append(std::string_view command_line)
+         {
+            std::string word;
+            bool in_word = false;
+            char quote = '\0';
+
+            for(size_t i = 0; i < command_line.size(); ++i)
+            {
+               char c = command_line[i];
+               if('\'' == quote)
+               {
+                  if('\'' == c) quote = '\0'; else word += c;
+               }
+               else if('\\' == c && i + 1 < command_line.size() &&
+                       ('\0' == quote || '"' == command_line[i + 1] || '\\' == command_line[i + 1]))
+               {
+                  word += command_line[++i];
+                  in_word = true;
+               }
+               else if('"' == quote)
+               {
+                  if('"' == c) quote = '\0'; else word += c;
+               }
+               else if('\'' == c || '"' == c)
+               {
+                  quote = c;
+                  in_word = true;
+               }
+               else if(isspace((unsigned char)c))
+               {
+                  if(in_word) this->push_back(word);
+                  word.clear();
+                  in_word = false;
+               }
+               else
+               {
+                  word += c;
+                  in_word = true;
+               }
+            }
+
+            if('\0' != quote)
+            {
+               throw_split_error("Unterminated quote in: " + std::string(command_line));
+            }
+            if(in_word) this->push_back(word);
+            return(*this);
+         }
+
+         static ArgvBuilder split(std::string_view command_line)
+         {
+            ArgvBuilder result;
+            result.append(command_line);
+            return(result);
+         }
+
+         /************************************************************************/
+         /*
+         * \brief Forget the arguments, keeping the allocation for reuse
+         *
+         */
+         void clear()
+         {
+            this->count = 0;
+            this->text_used = 0;
+            if(NULL != this->block) this->pointers()[0] = NULL;
+         }
+
+         int argc() const { return(int(this->count)); }
+         size_t size() const { return(this->count); }
+
+         /************************************************************************/
+         /*
+         * \brief NULL terminated argument vector, never NULL itself
+         *
+         */
+         char **argv()
+         {
+            if(NULL == this->block) this->reserve(0, 0);
+            return(this->pointers());
+         }
+
+         const char *operator[](size_t i) const { return(this->pointers()[i]); }
+
+         /************************************************************************/
+         /*
+         * \brief Size of the single allocation in bytes
+         *
+         */
+         size_t memory_usage() const
+         {
+            return((NULL == this->block) ? 0 : (this->pointer_capacity + 1) * sizeof(char *) + this->text_capacity);
+         }
+   };
+
+   /************************************************************************/
+   /*
+   * \brief Class for parsing command line options. Not fully generic at all 
+   *        but gets the job done with no memory leaks.
+   *
+   */
+   class CommandLineParser
+   {
+      private:
+
+         int argc_;
+         char **argv_;
+
+         std::pmr::memory_resource *resource; /**< Backs every container below (declared first so they can use it) */
+
+         std::pmr::map<int, std::pmr::string> optarg_map{this->resource}; /**< Stores option argument string characters when parsing */
+         std::pmr::map<int, cline_utils::option_source> opt_source_map{this->resource}; /**< Records where each non-default value came from */
+         //std::vector<int> optvec_; /**< Stores option characters as integer */
+         //std::vector<int> optind_; /**< Long name of the option (no spaces) */
+         //std::vector<int> opterr_; /**< Long name of the option (no spaces) */
+         
+         //std::vector<int> opt_strings;
+         //std::vector<std::string> arg_strings;
+
+         cline_utils::option_table opt_cfg{this->resource}; /**< Registered options, structure of arrays */
+
+         cline_utils::positional_view positional_args{this->resource}; /**< Non-option arguments of the last parse */
+         size_t positional_min = 0;                    /**< Fewest positional arguments accepted */
+         size_t positional_max = 0;                    /**< Most positional arguments accepted, 0 rejects them all */
+         unsigned positional_path_checks = 0;          /**< option_constraint::path_check bits every positional must pass */
+         std::pmr::map<int, cline_utils::glob_order> glob_options{this->resource}; /**< List options whose elements are expanded as globs, by val */
+         int next_option_val = first_allocated_val;    /**< Next candidate of allocate_option_val() */
+
+         std::pmr::string fmt_string{this->resource};
+
+         const cline_utils::static_option_tables *static_tables = NULL; /**< Optional tables generated by cline_codegen */
+
+         /************************************************************************/
+         /*
+         * \brief One row of the flat constraint table built at registration
+         *
+         */
+         struct compiled_constraint
+         {
+            uint32_t option_index;
+            uint8_t  kind;
+            bool     lower_exclusive;
+            double   lower;
+            double   upper;
+            uint32_t allowed_first; /**< First entry in allowed_values/allowed_strings */
+            uint32_t allowed_count;
+            uint32_t path_checks;   /**< option_constraint::path_check bits of constraint_path */
+            std::bitset<256> charset;
+         };
+
+         std::pmr::vector<compiled_constraint> constraint_table{this->resource};
+         std::pmr::vector<double> allowed_values{this->resource};            /**< Pooled one_of() entries of numeric options */
+         std::pmr::vector<std::pmr::string> allowed_strings{this->resource}; /**< Pooled one_of() entries of string options */
+         std::pmr::vector<std::pair<std::function<bool()>, std::string>> cross_constraints{this->resource}; /**< Predicate, message */
+
+         /************************************************************************/
+         /*
+         * \brief Option group as registered, by option val
+         *
+         */
+         struct option_group
+         {
+            cline_utils::group_kind kind;
+            int trigger;              /**< group_requires only */
+            std::pmr::vector<int> members;
+         };
+
+         std::pmr::vector<option_group> option_groups{this->resource};
+         std::pmr::vector<uint64_t> presence_bits{this->resource}; /**< Bit i set if option i was given on the command line */
+         std::pmr::vector<uint64_t> required_bits{this->resource}; /**< Bit i set if option i is a required_option */
+         std::pmr::vector<uint64_t> group_masks{this->resource};   /**< Two masks (trigger, members) of presence_bits.size() words per group */
+         std::pmr::vector<int> short_to_index = std::pmr::vector<int>(256, -1, this->resource); /**< Option character -> option index, -1 if unused */
+         std::pmr::unordered_map<int, int> long_val_to_index{this->resource}; /**< Any other val -> option index */
+
+         std::string config_filename;                              /**< Optional file of "long name = value" lines */
+         std::pmr::vector<std::pair<std::pmr::string, bool>> config_layers{this->resource}; /**< Lower precedence config files (name, optional) */
+         bool io_uring_enabled = true;                             /**< False loads config files on the thread pool */
+         cline_utils::file_batch_ptr pending_config;               /**< Config reads in flight while argv is tokenized */
+         std::atomic<int> config_backend{cline_utils::file_batch::backend_thread_pool}; /**< Backend of the last config load */
+         std::pmr::vector<cline_utils::option_value> default_values{this->resource}; /**< Bound values before the first parse */
+
+         std::string config_cache_path;                            /**< Compiled configuration cache, "" if disabled */
+         std::pmr::vector<std::pmr::string> config_cache_env{this->resource};    /**< Environment variables that are part of the cache key */
+         std::pmr::vector<std::pmr::string> config_cache_inputs{this->resource}; /**< Config and array files read by the last full parse */
+         bool config_cache_used = false;                           /**< Last parse was loaded from the cache */
+
+         /************************************************************************/
+         /*
+         * \brief Published snapshots and the config file watch thread
+         *
+         */
+         struct snapshot_state
+         {
+            cline_utils::rcu_cell<cline_utils::config_snapshot> cell;
+            std::shared_ptr<const std::unordered_map<std::string, size_t>> name_index;
+            std::mutex publish_mutex;  /**< Serializes publish_snapshot() and reload_config() */
+            uint64_t version = 0;
+
+            std::thread watch_thread;
+            int stop_pipe[2] = {-1, -1};
+            std::vector<std::string> config_paths; /**< Files of the last good load, guarded by publish_mutex */
+            std::mutex error_mutex;
+            std::string last_error;
+            std::atomic<uint64_t> reloads{0};
+         };
+
+         std::unique_ptr<snapshot_state> snapshots;
+
+         std::pmr::vector<size_t> sweep_axes{this->resource}; /**< Option indices of the range options being swept */
+         uint64_t sweep_begin = 0;       /**< First configuration of this shard */
+         uint64_t sweep_next  = 0;       /**< Index of the next configuration to bind */
+         uint64_t sweep_end   = 0;       /**< One past the last configuration of this shard */
+
+        // std::vector<std::tuple<char, int, int>> optChar2 
+
+      public:
+
+      /************************************************************************/
+      /*
+      * \brief No empty constructor.
+      *
+      */
+      CommandLineParser() = delete;
+
+      /************************************************************************/
+      /*
+      * \brief Stops the config file watch thread if one is running.
+      *
+      */
+      ~CommandLineParser()
+      {
+         this->stop_config_watch();
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Create a CommandLineParser object.
+      *
+      *     @param[in] int argc: Integer variable storing number of command line arguments (including executable name)    
+      *     @param[in] char **argv: Array of character pointers listing all the arguments    
+      *     @param[in] std::vector<struct option_longer> &option_config: Vector of option_longer structs
+      *     @param[in] std::pmr::memory_resource *resource_: Allocates all internal storage
+      *     @return None.
+      * 
+      */
+      CommandLineParser(
+         int argc,
+         char **argv,
+         const std::vector<cline_utils::option_longer> &option_config,
+         std::pmr::memory_resource *resource_ = std::pmr::get_default_resource()
+                       )
+            : argc_(argc), argv_(argv), resource(resource_)
+      {
+         this->add_options(option_config);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Create a CommandLineParser object. Options MUST be added later!
+      *
+      *     @param[in] int argc: Integer variable storing number of command line arguments (including executable name)    
+      *     @param[in] char **argv: Array of character pointers listing all the arguments    
+      *     @param[in] std::pmr::memory_resource *resource_: Allocates all internal storage
+      *     @return None.
+      * 
+      */
+     CommandLineParser(
+      int argc,
+      char **argv,
+      std::pmr::memory_resource *resource_ = std::pmr::get_default_resource()
+                    )
+         : argc_(argc), argv_(argv), resource(resource_)
+      {
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Add an option to the internal option structure
+      *
+      *     @param[in] cline_utils::option_longer &option_: option_longer struct
+      *     @return None.
+      * 
+      */
+      void add_option(const cline_utils::option_longer &option_)
+      {
+         const cline_utils::option_type type = (type_none != option_.type_code) ? option_.type_code : get_option_type(option_.type_string);
+         if((type_enum == type || type_duration == type) && NULL == option_.ctx)
+         {
+            std::stringstream ss("");
+            ss << "*************************************************************************" << std::endl;
+            ss << "add_option(...) - Option --" << option_.name << " needs its enum_table or duration unit, build it with make_option()" << std::endl;
+            ss << "*************************************************************************" << std::endl;
+            throw cline_utils::cline_exception(std::string(ss.str()));
+         }
+         this->opt_cfg.push_back(option_, type);
+         this->index_option_val(this->opt_cfg.size() - 1);
+         this->compile_constraints(this->opt_cfg.size() - 1, option_.constraints);
+         this->static_tables = NULL; // Generated tables describe the options they were attached to
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Add a bunch of options to the internal option structure
+      *
+      *     @param[in] std::vector<cline_utils::option_longer> &option_: option_longer structs
+      *     @return None.
+      * 
+      */
+      void add_options(const std::vector<cline_utils::option_longer> &options_)
+      {
+         for(size_t i = 0; i < options_.size(); ++i)
+         {
+            this->add_option(options_[i]);
+         }
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Heap bytes used to store the registered options (names, help text,
+      *        types and data pointers), excluding constraint and group tables
+      *
+      *     @return size_t: Bytes
+      * 
+      */
+      size_t option_memory_usage() const
+      {
+         return(this->opt_cfg.memory_usage());
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Value for a long only option that is not used by any option yet.
+      *        Values start at 0x1000, clear of option characters and of the
+      *        values the parser reserves for its own long only options.
+      *
+      *     @return int: Value for option_longer::val
+      * 
+      */
+      int allocate_option_val()
+      {
+         while(0 <= this->find_option_index(this->next_option_val))
+         {
+            ++this->next_option_val;
+         }
+         return(this->next_option_val++);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Give every option of a dotted namespace its default value back
+      *        (the value bound before the first parse) and forget where its
+      *        value came from; a later reparse converts their arguments anew.
+      *
+      *     @param[in] std::string prefix: Namespace such as "solver" or "diag.probe", "" for every option
+      *     @return size_t: Number of options reset
+      * 
+      */
+      size_t reset_options(const std::string &prefix)
+      {
+         std::vector<size_t> indices = this->find_namespace_options("reset_options", prefix);
+         this->capture_default_values();
+         for(size_t option_index : indices)
+         {
+            const int val = this->opt_cfg.val(option_index);
+            this->write_bound_value(option_index, this->default_values[option_index]);
+            this->opt_source_map.erase(val);
+            this->optarg_map.erase(val);
+         }
+         return(indices.size());
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Current values of a dotted namespace as config file lines
+      *        ("solver.tol = 1e-08"), in name order. Strings are quoted, a
+      *        list is written one line per element.
+      *
+      *     @param[in] std::string prefix: Namespace such as "solver" or "diag.probe", "" for every option
+      *     @return std::string: One line per value
+      * 
+      */
+      std::string format_options(const std::string &prefix) const
+      {
+         std::string out;
+         for(size_t option_index : this->find_namespace_options("format_options", prefix))
+         {
+            const void *dataVal = this->opt_cfg.data(option_index);
+            if(type_string_list == this->opt_cfg.type(option_index))
+            {
+               for(const std::string &element : *(const std::vector<std::string> *)dataVal)
+               {
+                  out += this->opt_cfg.name(option_index);
+                  out += " = \"" + element + "\"\n";
+               }
+               continue;
+            }
+            out += this->opt_cfg.name(option_index);
+            out += " = ";
+            this->append_config_value(out, option_index);
+            out += '\n';
+         }
+         return(out);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Create a CommandLineParser object.
+      *
+      *     @param[in] cline_utils::option_longer &option_: option_longer struct
+      *     @return None.
+      * 
+      */
+      void delete_all_options()
+      {
+         this->opt_cfg.clear();
+         this->short_to_index.assign(256, -1);
+         this->long_val_to_index.clear();
+         this->static_tables = NULL;
+
+         this->constraint_table.clear();
+         this->allowed_values.clear();
+         this->allowed_strings.clear();
+         this->cross_constraints.clear();
+         this->option_groups.clear();
+         this->default_values.clear();
+         this->optarg_map.clear(); // Tokens of the previous parse belong to the deleted options
+         this->glob_options.clear();
+         this->next_option_val = first_allocated_val;
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Expand the elements of a std::vector<std::string> option that
+      *        contain glob characters (quoted on the command line, so the
+      *        shell and ARG_MAX never see the matches). "**" matches any
+      *        number of directories. Directories are walked in parallel; a
+      *        pattern that matches nothing is an error. Applies to command
+      *        line and config file values.
+      *
+      *           cline.set_glob_expansion('i');   // --inputs='shots/run_*.h5'
+      *
+      *     @param[in] int val: Short character or value of the option
+      *     @param[in] glob_order order: glob_sorted (default) or glob_unsorted (discovery order)
+      *     @return None.
+      * 
+      */
+      void set_glob_expansion(int val, cline_utils::glob_order order = cline_utils::glob_sorted)
+      {
+         int option_index = this->find_option_index(val);
+         if(0 > option_index || type_string_list != this->opt_cfg.type(option_index))
+         {
+            std::stringstream ss("");
+            ss << "*************************************************************************" << std::endl;
+            ss << "set_glob_expansion(...) - Option " << this->describe_option(val) << " is not a std::vector<std::string> option" << std::endl;
+            ss << "*************************************************************************" << std::endl;
+            throw cline_utils::cline_exception(std::string(ss.str()));
+         }
+         this->glob_options[val] = order;
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Add a group rule over options given by their val (short character)
+      *
+      *     @param[in] cline_utils::group_kind kind: group_exactly_one, group_at_most_one or group_all_or_none
+      *     @param[in] std::vector<int> &members: Option vals of the group
+      *     @return None.
+      * 
+      */
+      void add_option_group(cline_utils::group_kind kind, const std::vector<int> &members)
+      {
+         this->option_groups.push_back({kind, 0, std::pmr::vector<int>(members.begin(), members.end(), this->resource)});
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Option trigger requires all the options in required to be given
+      *
+      *     @param[in] int trigger: Option val that carries the requirement
+      *     @param[in] std::vector<int> &required: Option vals that must then be present
+      *     @return None.
+      * 
+      */
+      void add_option_requirement(int trigger, const std::vector<int> &required)
+      {
+         this->option_groups.push_back({group_requires, trigger, std::pmr::vector<int>(required.begin(), required.end(), this->resource)});
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Attach precomputed tables generated by cline_codegen. Every row
+      *        (name, val, has_arg) must match the options configured so far;
+      *        adding or deleting options afterwards detaches the tables again.
+      *
+      *     @param[in] const cline_utils::static_option_tables &tables: Generated tables
+      *     @return None.
+      * 
+      */
+      void set_static_tables(const cline_utils::static_option_tables &tables)
+      {
+         const bool same_count = (tables.option_count == this->opt_cfg.size());
+         size_t row = 0;
+         while(same_count && row < tables.option_count &&
+               0 == strcmp(tables.getopt_table[row].name, this->opt_cfg.name(row)) &&
+               tables.getopt_table[row].val == this->opt_cfg.val(row) && tables.getopt_table[row].has_arg == this->opt_cfg.has_arg(row))
+         {
+            ++row;
+         }
+         if(false == same_count || row < tables.option_count)
+         {
+            std::stringstream ss("");
+            ss << "*************************************************************************" << std::endl;
+            ss << "set_static_tables(...) - Generated tables do not match the configured options";
+            if(same_count)
+            {
+               ss << " at --" << this->opt_cfg.name(row);
+            }
+            ss << std::endl;
+            ss << "*************************************************************************" << std::endl;
+            throw cline_utils::cline_exception(std::string(ss.str()));
+         }
+         this->static_tables = &tables;
+      }
+
+      /************************************************************************/
+      /*
+      * \brief True if static tables are attached and describe the current options
+      *
+      *     @return bool.
+      * 
+      */
+      bool use_static_tables() const
+      {
+         return(NULL != this->static_tables);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Ensure that all required_options are present
+      *
+      *     @return None
+      * 
+      */
+      void check_required_options()
+      {
+         // One word wide AND-NOT per 64 options instead of a map lookup per option
+         for(size_t word = 0; word < this->required_bits.size(); ++word)
+         {
+            uint64_t missing = this->required_bits[word] & ~this->presence_bits[word];
+            if(0 != missing)
+            {
+               size_t option_index = 64 * word + __builtin_ctzll(missing);
+               std::stringstream ss("");
+               ss << "******************************************************************************************" << std::endl;
+               ss << "check_required_options(...) - Missing required option in command line args: " << this->describe_option(this->opt_cfg.val(option_index)) << std::endl;
+               ss << "******************************************************************************************" << std::endl;
+               throw cline_utils::cline_exception(std::string(ss.str()));
+            }
+         }
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Check every option group with word wide bit operations on the
+      *        presence bitset and report all violations together
+      *
+      *     @return None
+      * 
+      */
+      void check_option_groups()
+      {
+         const size_t words = this->presence_bits.size();
+         std::stringstream violations("");
+         size_t count = 0;
+
+         for(size_t group_index = 0; group_index < this->option_groups.size(); ++group_index)
+         {
+            const uint64_t *trigger = this->group_masks.data() + 2 * words * group_index;
+            const uint64_t *members = trigger + words;
+
+            size_t given = 0, size = 0;
+            bool triggered = false, complete = true;
+            for(size_t word = 0; word < words; ++word)
+            {
+               uint64_t present = this->presence_bits[word] & members[word];
+               given += __builtin_popcountll(present);
+               size += __builtin_popcountll(members[word]);
+               triggered = triggered || (0 != (this->presence_bits[word] & trigger[word]));
+               complete = complete && (present == members[word]);
+            }
+
+            const option_group &group = this->option_groups[group_index];
+            bool valid = true;
+            switch(group.kind)
+            {
+               case group_exactly_one: valid = (1 == given); break;
+               case group_at_most_one: valid = (1 >= given); break;
+               case group_all_or_none: valid = (0 == given || size == given); break;
+               case group_requires:    valid = (false == triggered || complete); break;
+            }
+
+            if(false == valid)
+            {
+               static const char *rule[] = {"exactly one of", "at most one of", "all or none of", "requires all of"};
+               violations << "   ";
+               if(group_requires == group.kind)
+               {
+                  violations << this->describe_option(group.trigger) << " ";
+               }
+               violations << rule[group.kind];
+               for(size_t i = 0; i < group.members.size(); ++i)
+               {
+                  violations << ((0 == i) ? " " : ", ") << this->describe_option(group.members[i]);
+               }
+               violations << std::endl;
+               ++count;
+            }
+         }
+
+         if(0 < count)
+         {
+            std::stringstream ss("");
+            ss << "*************************************************************************" << std::endl;
+            ss << "check_option_groups(...) - " << count << " option group violation(s):" << std::endl;
+            ss << violations.str();
+            ss << "*************************************************************************" << std::endl;
+            throw cline_utils::cline_exception(std::string(ss.str()));
+         }
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Ensure no options long or short names are duplicates in input
+      *        configuration struct.
+      *
+      *     @return None
+      * 
+      */
+      void check_duplicate_option_config_names()
+      {
+         // Long names are interned, so equal names share one pointer
+         std::pmr::vector<const char *> long_names(this->resource);
+         std::pmr::vector<int> short_names(this->resource);
+         long_names.reserve(this->opt_cfg.size());
+         short_names.reserve(this->opt_cfg.size());
+
+         for(size_t option_index = 0; option_index < this->opt_cfg.size(); ++option_index)
+         {
+            long_names.push_back(this->opt_cfg.name(option_index));
+            short_names.push_back(this->opt_cfg.val(option_index));
+         }
+
+         // Check option long name configuration for duplicates
+         std::sort(long_names.begin(), long_names.end());
+         auto long_duplicate = std::adjacent_find(long_names.begin(), long_names.end());
+         if(long_duplicate != long_names.end())
+         {
+            std::stringstream ss("");
+            ss << "****************************************************************************************************************" << std::endl;
+            ss << "check_duplicate_options(...) - Struct option.name field const char* configured with duplicate entries: " << *long_duplicate << std::endl;
+            ss << "****************************************************************************************************************" << std::endl;
+            throw cline_utils::cline_exception(std::string(ss.str()));
+         }
+
+         // Check option short name configuration for duplicates
+         std::sort(short_names.begin(), short_names.end());
+         auto short_duplicate = std::adjacent_find(short_names.begin(), short_names.end());
+         if(short_duplicate != short_names.end())
+         {
+            std::stringstream ss("");
+            ss << "****************************************************************************************************************" << std::endl;
+            ss << "check_duplicate_options(...) - Struct option->flag field int* configured with duplicate entries: " << char(*short_duplicate) << std::endl;
+            ss << "****************************************************************************************************************" << std::endl;
+            throw cline_utils::cline_exception(std::string(ss.str()));
+         }
+      }
+
+
+      /************************************************************************/
+      /*
+      * \brief Create a format string to be fed into get_opt
+      *           
+      *     @return None
+      * 
+      */
+      void create_option_format_string()
+      {
+         // Loop through the option_longer struct and construct the. The leading '-'
+         // returns non-option arguments in order (as option 1) instead of permuting argv
+         std::pmr::string &result = this->fmt_string;
+         result.assign("-:");
+
+         for(size_t option_index = 0; option_index < this->opt_cfg.size(); ++option_index)
+         {
+            // Long only options use val outside of the printable characters
+            if(false == cline_utils::is_short_option_val(this->opt_cfg.val(option_index)))
+            {
+               continue;
+            }
+
+            result += char(this->opt_cfg.val(option_index));
+
+            switch(this->opt_cfg.has_arg(option_index))
+            {
+               case (required_argument):
+                  result.append(":");
+                  break;
+
+               case (optional_argument):
+                  result.append("::");
+                  break;
+            }
+         }
+
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Unpack command line data into internal class members
+      *
+      *     @return None
+      * 
+      */
+      void parse_options_arguments()
+      {
+         int opt = 0;
+
+         std::stringstream ss("");
+
+         std::pmr::vector<option> longer_options(this->resource);
+         const option *getopt_table = NULL;
+         const char *format_string = NULL;
+         if(this->use_static_tables())
+         {
+            getopt_table = this->static_tables->getopt_table;
+            format_string = this->static_tables->format_string;
+         }
+         else
+         {
+            longer_options = this->opt_cfg.getopt_table();
+            getopt_table = longer_options.data();
+            format_string = this->fmt_string.c_str();
+         }
+
+         this->compile_option_bitsets();
+         this->positional_args.clear();
+
+         // Config files load while getopt works through argv
+         this->pending_config = this->start_config_load(this->resource);
+
+         // 0 rather than 1 makes glibc reset its internal state too, so the
+         // same or another parser can parse again in this process
+         optind = 0;
+
+         while(true)
+         {
+            int option_index = -1;
+            if(this->match_long_option(option_index))
+            {
+               opt = this->opt_cfg.val(option_index);
+            }
+            else
+            {
+               opt = getopt_long(this->argc_, this->argv_, format_string, getopt_table, &option_index);
+               if(-1 == opt)
+               {
+                  break;
+               }
+            }
+
+            switch (opt) //Recall that character constants (which have a type int) comparisons to opt (which is also an int)
+            {  
+               case 'h': //Help option
+                  ss << "*************************************************************************" << std::endl;
+                  ss << "parse_options_arguments(...) - Help Option Selected: " << char(optopt) << std::endl;
+                  ss << "*************************************************************************" << std::endl;
+                  throw cline_utils::cline_exception(std::string(ss.str()));
+                  break;
+
+               case '?': //Unrecognized command line option
+                  ss << "*************************************************************************" << std::endl;
+                  ss << "parse_options_arguments(...) - Unrecognized option: " << optopt << " " << char(opt) << std::endl;
+                  ss << "*************************************************************************" << std::endl;
+                  throw cline_utils::cline_exception(std::string(ss.str()));
+                  break;
+                 
+               case ':': //Missing argument for option
+                  ss << "*************************************************************************" << std::endl;
+                  ss << "parse_options_arguments(...) - Missing argument for option: " << char(optopt) << std::endl;
+                  ss << "*************************************************************************" << std::endl;
+                  throw cline_utils::cline_exception(std::string(ss.str()));
+                  break;
+
+               case 1: // Non-option argument, returned in order because of the leading '-'
+                  this->add_positional_argument(optind - 1);
+                  break;
+
+               default:
+                  // If the size stays the same, then insert failed and we know its likely a duplicate key input on
+                  // the command line.
+                  // try_emplace builds the string with the map's memory resource
+                  // getopt_long only reports the index for long options
+                  if(0 > option_index)
+                  {
+                     option_index = this->find_option_index(opt);
+                  }
+                  if(false == this->optarg_map.try_emplace(opt, (NULL != optarg) ? optarg : "").second)
+                  {
+                     // Lists collect every occurrence, NUL separated until conversion
+                     if(0 <= option_index && type_string_list == this->opt_cfg.type(option_index))
+                     {
+                        std::pmr::string &list = this->optarg_map.find(opt)->second;
+                        list += '\0';
+                        list += (NULL != optarg) ? optarg : "";
+                        break;
+                     }
+                     ss << "*************************************************************************" << std::endl;
+                     ss << "parse_options_arguments(...) - Duplicate option struct.val input found: " << this->describe_option(opt) << std::endl;
+                     ss << "*************************************************************************" << std::endl;
+                     throw cline_utils::cline_exception(std::string(ss.str()));
+                  }
+
+                  this->opt_source_map[opt] = source_command_line;
+
+                  if(0 <= option_index)
+                  {
+                     this->presence_bits[option_index / 64] |= uint64_t(1) << (option_index % 64);
+                  }
+                  break;
+           }
+         }
+
+         // Everything after "--" is positional
+         for(int argv_index = optind; argv_index < this->argc_; ++argv_index)
+         {
+            this->add_positional_argument(argv_index);
+         }
+         if(this->positional_args.size() < this->positional_min)
+         {
+            ss << "*************************************************************************" << std::endl;
+            ss << "parse_options_arguments(...) - Expected at least " << this->positional_min << " positional argument(s), got " << this->positional_args.size() << std::endl;
+            ss << "*************************************************************************" << std::endl;
+            throw cline_utils::cline_exception(std::string(ss.str()));
+         }
+
+         // Config file values fill in options not given on the command line
+         this->merge_config_file();
+
+         this->check_required_options();
+         this->check_option_groups();
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Parse the command line and store the data
+      *
+      *     @return None.
+      * 
+      */
+      void parse_command_line()
+      {
+         bool found_option_type = 0;
+
+         this->optarg_map.clear();
+         this->opt_source_map.clear();
+         this->capture_default_values();
+
+         // Generated tables were validated and built by cline_codegen
+         if(false == this->use_static_tables())
+         {
+            // Create the format string from the option_longer struct
+            this->check_duplicate_option_config_names();
+
+            // Create the required/optional options and required/not argument strings
+            this->create_option_format_string();
+         }
+
+         // The key covers the bound values before the parse, so the cached
+         // values are exactly what parsing would produce from them
+         const bool use_cache = this->config_cache_enabled();
+         std::vector<char> initial_state;
+         uint64_t cache_key = 0;
+         struct timespec parse_start = {0, 0};
+         this->config_cache_used = false;
+         this->config_cache_inputs.clear();
+         if(use_cache)
+         {
+            initial_state = this->serialize_snapshot();
+            cache_key = this->config_cache_key(initial_state);
+            if(this->load_config_cache(cache_key))
+            {
+               this->config_cache_used = true;
+               this->check_constraints();
+               return;
+            }
+            clock_gettime(CLOCK_REALTIME_COARSE, &parse_start);
+         }
+
+         this->parse_options_arguments();
+
+         std::string dependency;
+         for (auto const & [key, val] : this->optarg_map)
+         {
+            // Start at the option currently being parsed by getopt
+            found_option_type = false;
+            const int first_index = (this->use_static_tables() && 0 <= key && key < 256) ? this->static_tables->short_index[key] : this->find_option_index(key);
+            for(size_t option_index = std::max(first_index, 0); option_index < this->opt_cfg.size(); ++option_index)
+            {
+               if(this->opt_cfg.val(option_index) == key)
+               {
+                  dependency.clear();
+                  found_option_type = this->convert_argument(option_index, std::string_view(val), this->opt_cfg.data(option_index), &dependency);
+                  if(false == dependency.empty())
+                  {
+                     this->config_cache_inputs.emplace_back(dependency);
+                  }
+               }
+               // If option has been found and handled, move on.
+               if(true == found_option_type) break;
+            }
+               
+            if(false == found_option_type)
+            {
+               std::stringstream ss("");
+               ss << "*************************************************************************" << std::endl;
+               ss << "parse_command_line(...) - Unable to match option type string: " << this->describe_option(key) << std::endl;
+               ss << "*************************************************************************" << std::endl;
+               throw cline_utils::cline_exception(std::string(ss.str()));
+               break;
+            }
+         }
+
+         this->check_constraints();
+
+         if(use_cache)
+         {
+            this->write_config_cache(cache_key, parse_start);
+         }
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Parse a new command line against the previous parse. Tokens are
+      *        compared by option; only options whose argument text changed are
+      *        converted and validated, options no longer given get their
+      *        default value back. Nothing is written unless the whole command
+      *        line is valid: on error the previous parse stays in effect.
+      *
+      *        The first call (or a call after delete_all_options) behaves like
+      *        parse_command_line() and reports every given option as changed.
+      *        Cross constraints run only if something changed.
+      *
+      *     @param[in] int argc: Number of arguments of the new command line
+      *     @param[in] char **argv: New command line, must outlive the parser or the next parse
+      *     @return std::vector<int>: val of every changed option, in configuration order
+      * 
+      */
+      std::vector<int> reparse_command_line(int argc, char **argv)
+      {
+         std::pmr::map<int, std::pmr::string> previous(this->resource);
+         previous.swap(this->optarg_map);
+         const int previous_argc = this->argc_;
+         char **previous_argv = this->argv_;
+
+         std::vector<size_t> changed;
+         std::pmr::vector<cline_utils::option_value> updated(this->resource);
+
+         this->argc_ = argc;
+         this->argv_ = argv;
+         try
+         {
+            this->opt_source_map.clear();
+            this->capture_default_values();
+            if(false == this->use_static_tables())
+            {
+               this->check_duplicate_option_config_names();
+               this->create_option_format_string();
+            }
+            this->parse_options_arguments();
+
+            // Convert what changed into scratch values first
+            for(size_t option_index = 0; option_index < this->opt_cfg.size(); ++option_index)
+            {
+               const int val = this->opt_cfg.val(option_index);
+               auto now = this->optarg_map.find(val);
+               auto before = previous.find(val);
+               if(now == this->optarg_map.end())
+               {
+                  if(before != previous.end())
+                  {
+                     changed.push_back(option_index);
+                     updated.push_back(this->default_values[option_index]);
+                  }
+                  continue;
+               }
+               if(before != previous.end() && before->second == now->second)
+               {
+                  continue;
+               }
+
+               changed.push_back(option_index);
+               updated.push_back(this->read_bound_value(option_index));
+               if(false == this->convert_into_value(option_index, now->second, updated.back()))
+               {
+                  std::stringstream ss("");
+                  ss << "*************************************************************************" << std::endl;
+                  ss << "reparse_command_line(...) - Unable to match option type string: " << this->describe_option(val) << std::endl;
+                  ss << "*************************************************************************" << std::endl;
+                  throw cline_utils::cline_exception(std::string(ss.str()));
+               }
+            }
+
+            this->check_changed_constraints(changed, updated);
+         }
+         catch(...)
+         {
+            // Tokenizing the previous command line again restores sources,
+            // presence and positionals; it parsed before, so it parses now
+            this->argc_ = previous_argc;
+            this->argv_ = previous_argv;
+            try
+            {
+               this->optarg_map.clear();
+               this->opt_source_map.clear();
+               this->parse_options_arguments();
+            }
+            catch(...)
+            {
+            }
+            this->optarg_map.swap(previous);
+            throw;
+         }
+
+         std::vector<int> result;
+         result.reserve(changed.size());
+         for(size_t i = 0; i < changed.size(); ++i)
+         {
+            this->write_bound_value(changed[i], updated[i]);
+            result.push_back(this->opt_cfg.val(changed[i]));
+         }
+
+         return(result);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Convert an option argument string into the type of the option
+      *
+      *     @param[in] size_t option_index: Index of the option in the configuration
+      *     @param[in] const char *optArgString: NUL terminated argument text
+      *     @param[out] void *dataVal: Destination of the option type
+      *     @param[out] std::string *dependency: If not NULL, receives the file the value was read from, if any
+      *     @return bool: False if the option type is not supported
+      * 
+      *        Numbers that do not fit the option type throw instead of wrapping.
+      *        Text that is not entirely a number throws, except for double and
+      *        int, which keep their historical NaN / INT_MIN markers and ignore
+      *        trailing text.
+      * 
+      */
+      bool convert_argument(size_t option_index, const char *optArgString, void *dataVal, std::string *dependency = NULL) const
+      {
+         switch(this->opt_cfg.type(option_index))
+         {
+            case type_string:
+               *(std::string *)dataVal = optArgString;
+               break;
+
+            case type_string_list:
+               *(std::vector<std::string> *)dataVal = {optArgString};
+               break;
+
+            case type_double_array:
+            {
+               // "@path" reads the numbers of a file, anything else is the list itself
+               cline_utils::numeric_array_error error;
+               if('@' == optArgString[0])
+               {
+                  error = cline_utils::load_numeric_array(optArgString + 1, *(std::vector<double> *)dataVal);
+                  if(NULL != dependency)
+                  {
+                     *dependency = optArgString + 1;
+                  }
+               }
+               else
+               {
+                  error = cline_utils::numeric_array_parser(optArgString, strlen(optArgString)).parse(*(std::vector<double> *)dataVal);
+               }
+               if(error.failed())
+               {
+                  const std::string where = ('@' == optArgString[0]) ? "line " + std::to_string(error.line) + ": " : "";
+                  this->throw_conversion_error(option_index, optArgString,
+                     error.token.empty() ? error.what : where + "'" + error.token + "' " + error.what);
+               }
+               break;
+            }
+
+            case type_double:
+            {
+               // Legacy behaviour kept for existing callers: text that is not a
+               // number gives NaN, and trailing text after a number is ignored
+               // ("1.5xyz" is 1.5). The same holds for int below (INT_MIN).
+               char *endPtr;
+               errno = 0;
+               double test = strtod(optArgString, &endPtr);
+               if(ERANGE == errno && std::isinf(test))
+               {
+                  this->throw_conversion_error(option_index, optArgString, "out of range of double");
+               }
+               *(double *)dataVal = (endPtr != optArgString) ? test : std::nan("1");
+               break;
+            }
+            case type_float:
+            {
+               char *endPtr;
+               errno = 0;
+               float test = strtof(optArgString, &endPtr);
+               if(endPtr == optArgString || '\0' != *endPtr)
+               {
+                  this->throw_conversion_error(option_index, optArgString, "not a number");
+               }
+               if(ERANGE == errno && std::isinf(test))
+               {
+                  this->throw_conversion_error(option_index, optArgString, "out of range of float");
+               }
+               *(float *)dataVal = test;
+               break;
+            }
+            case type_int:
+            {
+               // Legacy, see type_double: INT_MIN for text that is not a number
+               char *endPtr;
+               errno = 0;
+               long test = std::strtol(optArgString, &endPtr, 0);
+               if(endPtr != optArgString && (ERANGE == errno || test < INT_MIN || test > INT_MAX))
+               {
+                  this->throw_conversion_error(option_index, optArgString,
+                     "out of range [" + std::to_string(INT_MIN) + ", " + std::to_string(INT_MAX) + "]");
+               }
+               *(int *)dataVal = (endPtr != optArgString) ? int(test) : INT_MIN;
+               if('\0' == optArgString[0] && no_argument == this->opt_cfg.has_arg(option_index))
+               {
+                  *(int *)dataVal = 1; // Flag given
+               }
+               break;
+            }
+            case type_range:
+               *(cline_utils::range *)dataVal = cline_utils::range::parse(optArgString);
+               break;
+
+            case type_shard:
+               *(cline_utils::shard_spec *)dataVal = cline_utils::shard_spec::parse(optArgString);
+               break;
+
+            default:
+            {
+               const cline_utils::scalar_type_ops *ops = cline_utils::scalar_type_ops::get(this->opt_cfg.type(option_index));
+               if(NULL == ops)
+               {
+                  return(false);
+               }
+               ops->store(dataVal, this->parse_scalar(option_index, optArgString), this->opt_cfg.context(option_index));
+               break;
+            }
+         }
+
+         return(true);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Convert argument text that may hold several occurrences of a list
+      *        option (NUL separated, as collected by parse_options_arguments)
+      *
+      */
+      bool convert_argument(size_t option_index, std::string_view text, void *dataVal, std::string *dependency = NULL) const
+      {
+         if(type_string_list == this->opt_cfg.type(option_index))
+         {
+            std::vector<std::string> &list = *(std::vector<std::string> *)dataVal;
+            split_list(text, list);
+            auto glob = this->glob_options.find(this->opt_cfg.val(option_index));
+            if(glob != this->glob_options.end())
+            {
+               this->expand_globs(option_index, glob->second, list);
+            }
+            return(true);
+         }
+         return(this->convert_argument(option_index, text.data(), dataVal, dependency));
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Replace the glob patterns of a list by their matches, in place
+      *
+      */
+      void expand_globs(size_t option_index, cline_utils::glob_order order, std::vector<std::string> &list) const
+      {
+         std::vector<std::string> expanded;
+         for(const std::string &element : list)
+         {
+            if(false == cline_utils::has_glob_magic(element))
+            {
+               expanded.push_back(element);
+            }
+            else if(0 == cline_utils::glob_expand(element, expanded, order))
+            {
+               this->throw_conversion_error(option_index, element.c_str(), "matches no files");
+            }
+         }
+         list.swap(expanded);
+      }
+
+      static void split_list(std::string_view text, std::vector<std::string> &list)
+      {
+         list.clear();
+         for(size_t first = 0; first <= text.size();)
+         {
+            size_t end = std::min(text.find('\0', first), text.size());
+            list.emplace_back(text.substr(first, end - first));
+            first = end + 1;
+         }
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Terrible hack function to print option data type. Can't use more
+      *        elegant methods because internally this class only sees void data.
+      *
+      *     @return None.
+      * 
+      */
+      std::string get_type_string(const std::string type_name)
+      {  
+         std::string result("None ");
+         
+         if("Pc" == type_name)
+         {
+            result = "char * ";
+         }
+         else if("d" == type_name)
+         {
+            result = "double ";
+         }
+         else if("f" == type_name)
+         {
+            result = "float ";
+         }
+         else if("i" == type_name)
+         {
+            result = "int ";
+         }
+         else if(typeid(cline_utils::range).name() == type_name)
+         {
+            result = "range ";
+         }
+         else if(typeid(cline_utils::shard_spec).name() == type_name)
+         {
+            result = "shard ";
+         }
+         else if(typeid(std::vector<std::string>).name() == type_name)
+         {
+            result = "string list ";
+         }
+         else if(typeid(std::vector<double>).name() == type_name)
+         {
+            result = "double array ";
+         }
+
+         return(result);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Type column of the usage and summary tables
+      *
+      *     @param[in] size_t option_index: Index of the option in the configuration
+      *     @return std::string: Type label
+      * 
+      */
+      std::string get_type_label(size_t option_index)
+      {
+         const cline_utils::scalar_type_ops *ops = cline_utils::scalar_type_ops::get(this->opt_cfg.type(option_index));
+         return((NULL != ops) ? std::string(ops->label) : this->get_type_string(this->opt_cfg.type_string(option_index)));
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Print usage example & available data.
+      *
+      *     @return None.
+      * 
+      */
+      void print_usage()
+      {  
+         std::cerr << std::endl;
+         std::cerr << "--------------------------------------------------------------" << std::endl; 
+         std::cerr << "foo@bar:~$ ";
+         std::cerr << argv_[0] << " -option_character <argument_value>" << std::endl;
+         std::cerr << "--------------------------------------------------------------" << std::endl;
+
+         if(this->use_static_tables())
+         {
+            std::cerr << this->static_tables->usage;
+            return;
+         }
+ 
+         bprinter::TablePrinter tp(&std::cerr);
+         tp.AddColumn("Option Long Name ", 25);
+         tp.AddColumn("Option Character ", 20);
+         tp.AddColumn("Argument Type ", 20);
+         tp.AddColumn("Option Required ", 20);
+         tp.AddColumn("Argument Required ", 20);
+         tp.AddColumn("Argument Default Value ", 30);
+         tp.AddColumn("Description ", 75);
+      
+         tp.PrintHeader();
+         
+         for(size_t option_index = 0; option_index < this->opt_cfg.size(); ++option_index)
+         {
+
+            tp << this->opt_cfg.name(option_index);
+            tp << char(cline_utils::is_short_option_val(this->opt_cfg.val(option_index)) ? this->opt_cfg.val(option_index) : ' ');
+            tp << this->get_type_label(option_index);
+            tp << this->opt_cfg.is_mandatory_opt(option_index);
+            tp << this->opt_cfg.has_arg(option_index);
+
+            this->print_value(tp, option_index);
+
+            tp << this->opt_cfg.description(option_index);
+
+         }
+         tp.PrintFooter();
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Print summary of command line available data.
+      *
+      *     @return None.
+      * 
+      */
+      void print_input_summary()
+      {  
+         bprinter::TablePrinter tp(&std::cerr);
+         tp.AddColumn("Option Long Name ", 25);
+         tp.AddColumn("Option Character ", 20);
+         tp.AddColumn("Argument Type ", 20);
+         tp.AddColumn("Option Required ", 20);
+         tp.AddColumn("Argument Required ", 20);
+         tp.AddColumn("Current Argument Value ", 30);
+         tp.AddColumn("Description ", 75);
+     
+         tp.PrintHeader();
+
+         for(size_t option_index = 0; option_index < this->opt_cfg.size(); ++option_index)
+         {
+
+            tp << this->opt_cfg.name(option_index);
+            tp << char(cline_utils::is_short_option_val(this->opt_cfg.val(option_index)) ? this->opt_cfg.val(option_index) : ' ');
+            tp << this->get_type_label(option_index);
+            tp << this->opt_cfg.is_mandatory_opt(option_index);
+            tp << this->opt_cfg.has_arg(option_index);
+
+            this->print_value(tp, option_index);
+
+            tp << this->opt_cfg.description(option_index);
+
+         }
+         tp.PrintFooter();
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Resolved options as JSON or CSV, with name, character, type,
+      *        required / argument flags, source, value and description of
+      *        each option. Floating point values use the shortest text that
+      *        reads back to the same value (std::to_chars); in JSON, numbers
+      *        and booleans are bare and NaN / infinities are null.
+      *
+      *     @param[in] summary_format format: summary_json or summary_csv
+      *     @return std::string: The whole document
+      * 
+      */
+      std::string format_input_summary(cline_utils::summary_format format) const
+      {
+         std::string out;
+         out.reserve(256 + 160 * this->opt_cfg.size());
+         const bool json = (summary_json == format);
+
+         out += json ? "{\"options\":[" : "name,char,type,required,argument,source,value,description\r\n";
+         for(size_t option_index = 0; option_index < this->opt_cfg.size(); ++option_index)
+         {
+            const int val = this->opt_cfg.val(option_index);
+            const char character[2] = {(0 < val && val < 128 && isprint(val)) ? char(val) : '\0', '\0'};
+            const char *type = summary_type_name(this->opt_cfg.type(option_index));
+            const char *required = this->opt_cfg.is_mandatory_opt(option_index) ? "true" : "false";
+            const char *argument = (no_argument != this->opt_cfg.has_arg(option_index)) ? "true" : "false";
+            static const char *sources[] = {"default", "command_line", "snapshot", "config_file"};
+            const char *source = sources[this->get_option_source(val) & 3];
+
+            std::string_view description(this->opt_cfg.description(option_index));
+            size_t first = description.find_first_not_of(" \t");
+            description = (std::string_view::npos == first) ? std::string_view() : description.substr(first);
+            description = description.substr(0, description.find_last_not_of(" \t") + 1);
+
+            if(json)
+            {
+               out += (0 == option_index) ? "{\"name\":" : ",{\"name\":";
+               append_json_string(out, this->opt_cfg.name(option_index));
+               out += ",\"char\":";
+               if('\0' == character[0]) out += "null"; else append_json_string(out, character);
+               out += ",\"type\":\"";
+               out += type;
+               out += "\",\"required\":";
+               out += required;
+               out += ",\"argument\":";
+               out += argument;
+               out += ",\"source\":\"";
+               out += source;
+               out += "\",\"value\":";
+               this->append_summary_value(out, option_index, true);
+               out += ",\"description\":";
+               append_json_string(out, description);
+               out += '}';
+            }
+            else
+            {
+               append_csv_field(out, this->opt_cfg.name(option_index));
+               out += ',';
+               out += character;
+               out += ',';
+               out += type;
+               out += ',';
+               out += required;
+               out += ',';
+               out += argument;
+               out += ',';
+               out += source;
+               out += ',';
+               this->append_summary_value(out, option_index, false);
+               out += ',';
+               append_csv_field(out, description);
+               out += "\r\n";
+            }
+         }
+
+         if(json)
+         {
+            out += "],\"positional\":[";
+            for(size_t i = 0; i < this->positional_args.size(); ++i)
+            {
+               if(0 < i) out += ',';
+               append_json_string(out, this->positional_args[i]);
+            }
+            out += "]}\n";
+         }
+
+         return(out);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Write format_input_summary() to a file descriptor with a single
+      *        write(2) (repeated only if the kernel accepts part of it), so
+      *        concurrent writers to a log never interleave inside a record
+      *
+      *     @param[in] summary_format format: summary_json or summary_csv
+      *     @param[in] int fd: Destination, stderr by default
+      *     @return None.
+      * 
+      */
+      void write_input_summary(cline_utils::summary_format format, int fd = STDERR_FILENO) const
+      {
+         const std::string out = this->format_input_summary(format);
+         size_t written = 0;
+         while(written < out.size())
+         {
+            ssize_t n = ::write(fd, out.data() + written, out.size() - written);
+            if(0 > n)
+            {
+               if(EINTR == errno) continue;
+               std::stringstream ss("");
+               ss << "*************************************************************************" << std::endl;
+               ss << "write_input_summary(...) - " << strerror(errno) << std::endl;
+               ss << "*************************************************************************" << std::endl;
+               throw cline_utils::cline_exception(std::string(ss.str()));
+            }
+            written += n;
+         }
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Map a typeid(...).name() string onto the compact option_type code
+      *
+      *     @param[in] std::string type_name: typeid(...).name() stored in option_longer
+      *     @return option_type: Matching code or type_none if not supported
+      * 
+      */
+      static cline_utils::option_type get_option_type(const std::string &type_name)
+      {
+         if(std::string(typeid(char *).name()) == type_name)
+         {
+            return(type_string);
+         }
+         else if(std::string(typeid(double).name()) == type_name)
+         {
+            return(type_double);
+         }
+         else if(std::string(typeid(int).name()) == type_name)
+         {
+            return(type_int);
+         }
+         else if(std::string(typeid(float).name()) == type_name)
+         {
+            return(type_float);
+         }
+         else if(std::string(typeid(cline_utils::range).name()) == type_name)
+         {
+            return(type_range);
+         }
+         else if(std::string(typeid(cline_utils::shard_spec).name()) == type_name)
+         {
+            return(type_shard);
+         }
+         else if(std::string(typeid(long).name()) == type_name || std::string(typeid(long long).name()) == type_name)
+         {
+            return((8 == sizeof(long) || std::string(typeid(long long).name()) == type_name) ? type_int64 : type_none);
+         }
+         else if(std::string(typeid(unsigned long).name()) == type_name || std::string(typeid(unsigned long long).name()) == type_name)
+         {
+            return((8 == sizeof(unsigned long) || std::string(typeid(unsigned long long).name()) == type_name) ? type_uint64 : type_none);
+         }
+         else if(std::string(typeid(bool).name()) == type_name)
+         {
+            return(type_bool);
+         }
+         else if(std::string(typeid(std::vector<std::string>).name()) == type_name)
+         {
+            return(type_string_list);
+         }
+         else if(std::string(typeid(std::vector<double>).name()) == type_name)
+         {
+            return(type_double_array);
+         }
+
+         return(type_none);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Report where the current value of an option came from
+      *
+      *     @param[in] int val: short character (casted to int) name of the option
+      *     @return option_source: source_default if the parser never wrote the option
+      * 
+      */
+      cline_utils::option_source get_option_source(int val) const
+      {
+         auto itr = this->opt_source_map.find(val);
+         return((itr == this->opt_source_map.end()) ? source_default : itr->second);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Serialize the resolved option values and their sources into a
+      *        compact, versioned binary record. Layout (host byte order):
+      *
+      *        "CLNS" | uint16 version | uint16 byte order mark | uint32 count
+      *        count x { int32 val | uint8 type | uint8 source | uint16 name length | name
+      *                  | payload (string: uint32 length + bytes, double: 8, int/float: 4,
+      *                             int64 and later scalar types: uint64 bits) }
+      *        uint32 FNV-1a checksum of everything before it
+      *
+      *     @return std::vector<char>: The binary record
+      * 
+      */
+      std::vector<char> serialize_snapshot() const
+      {
+         std::vector<char> record;
+         record.reserve(16 + 32 * this->opt_cfg.size());
+
+         const uint16_t version = snapshot_version;
+         const uint16_t bom = 0xFEFF;
+         const uint32_t count = this->opt_cfg.size();
+
+         append_bytes(record, snapshot_magic, 4);
+         append_bytes(record, &version, sizeof(version));
+         append_bytes(record, &bom, sizeof(bom));
+         append_bytes(record, &count, sizeof(count));
+
+         for(size_t option_index = 0; option_index < this->opt_cfg.size(); ++option_index)
+         {
+            const char *name = this->opt_cfg.name(option_index);
+            const void *dataVal = this->opt_cfg.data(option_index);
+
+            const int32_t val = this->opt_cfg.val(option_index);
+            const uint8_t type = this->opt_cfg.type(option_index);
+            const uint8_t source = this->get_option_source(val);
+            const uint16_t name_length = strlen(name);
+
+            append_bytes(record, &val, sizeof(val));
+            append_bytes(record, &type, sizeof(type));
+            append_bytes(record, &source, sizeof(source));
+            append_bytes(record, &name_length, sizeof(name_length));
+            append_bytes(record, name, name_length);
+
+            switch(type)
+            {
+               case type_string:
+               {
+                  const std::string &value = *(const std::string *)dataVal;
+                  const uint32_t length = value.size();
+                  append_bytes(record, &length, sizeof(length));
+                  append_bytes(record, value.data(), length);
+                  break;
+               }
+               case type_double:
+                  append_bytes(record, dataVal, sizeof(double));
+                  break;
+
+               case type_int:
+                  append_bytes(record, dataVal, sizeof(int));
+                  break;
+
+               case type_float:
+                  append_bytes(record, dataVal, sizeof(float));
+                  break;
+
+               case type_shard:
+                  append_bytes(record, dataVal, sizeof(cline_utils::shard_spec));
+                  break;
+
+               case type_string_list:
+               {
+                  const std::vector<std::string> &list = *(const std::vector<std::string> *)dataVal;
+                  const uint32_t count = list.size();
+                  append_bytes(record, &count, sizeof(count));
+                  for(const std::string &value : list)
+                  {
+                     const uint32_t length = value.size();
+                     append_bytes(record, &length, sizeof(length));
+                     append_bytes(record, value.data(), length);
+                  }
+                  break;
+               }
+
+               case type_double_array:
+               {
+                  const std::vector<double> &array = *(const std::vector<double> *)dataVal;
+                  const uint64_t count = array.size();
+                  append_bytes(record, &count, sizeof(count));
+                  append_bytes(record, array.data(), count * sizeof(double));
+                  break;
+               }
+
+               case type_range:
+               {
+                  // Lazy ranges are stored by their parameters, lists by value
+                  const cline_utils::range &value = *(const cline_utils::range *)dataVal;
+                  const uint8_t kind = value.get_kind();
+                  const uint64_t points = value.size();
+                  const double parameters[3] = {value.get_start(), value.get_stop(), value.get_step()};
+                  append_bytes(record, &kind, sizeof(kind));
+                  append_bytes(record, &points, sizeof(points));
+                  if(cline_utils::range::range_list == kind)
+                  {
+                     append_bytes(record, value.get_list().data(), points * sizeof(double));
+                  }
+                  else
+                  {
+                     append_bytes(record, parameters, sizeof(parameters));
+                  }
+                  break;
+               }
+
+               default:
+               {
+                  const cline_utils::scalar_type_ops *ops = cline_utils::scalar_type_ops::get(cline_utils::option_type(type));
+                  if(NULL != ops)
+                  {
+                     const uint64_t bits = ops->load(dataVal, this->opt_cfg.context(option_index));
+                     append_bytes(record, &bits, sizeof(bits));
+                  }
+                  break;
+               }
+            }
+         }
+
+         const uint32_t checksum = fnv1a_32(record.data(), record.size());
+         append_bytes(record, &checksum, sizeof(checksum));
+
+         return(record);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Load a binary record made by serialize_snapshot() straight into the
+      *        bound variables. No tokenizing or text conversion takes place.
+      *        Options missing from the record keep their current values. The
+      *        whole record is decoded before any variable is written, so a
+      *        record that fails to load changes nothing.
+      *
+      *     @param[in] const char *data: Start of the binary record
+      *     @param[in] size_t size: Size of the binary record in bytes
+      *     @return None.
+      * 
+      */
+      void load_snapshot(const char *data, size_t size)
+      {
+         if(size < 16 || 0 != memcmp(data, snapshot_magic, 4))
+         {
+            throw_snapshot_error("Not a cline_utils snapshot record");
+         }
+
+         uint32_t checksum = 0;
+         memcpy(&checksum, data + size - sizeof(checksum), sizeof(checksum));
+         if(checksum != fnv1a_32(data, size - sizeof(checksum)))
+         {
+            throw_snapshot_error("Checksum mismatch (corrupt or truncated record)");
+         }
+
+         uint16_t version = 0, bom = 0;
+         uint32_t count = 0;
+         size_t pos = 4;
+         read_bytes(data, size, pos, &version, sizeof(version));
+         read_bytes(data, size, pos, &bom, sizeof(bom));
+         read_bytes(data, size, pos, &count, sizeof(count));
+
+         if(snapshot_version != version || 0xFEFF != bom)
+         {
+            throw_snapshot_error("Unsupported snapshot version or byte order");
+         }
+
+         struct decoded_record
+         {
+            size_t option_index;
+            cline_utils::option_source source;
+            cline_utils::option_value value;
+         };
+         std::vector<decoded_record> decoded;
+         decoded.reserve(std::min<size_t>(count, this->opt_cfg.size()));
+
+         for(uint32_t record_index = 0; record_index < count; ++record_index)
+         {
+            int32_t val = 0;
+            uint8_t type = 0, source = 0;
+            uint16_t name_length = 0;
+            read_bytes(data, size, pos, &val, sizeof(val));
+            read_bytes(data, size, pos, &type, sizeof(type));
+            read_bytes(data, size, pos, &source, sizeof(source));
+            read_bytes(data, size, pos, &name_length, sizeof(name_length));
+
+            const char *name = data + pos;
+            pos += name_length;
+            if(pos > size - sizeof(checksum))
+            {
+               throw_snapshot_error("Truncated option name");
+            }
+
+            // Records are normally written in configuration order, so try the
+            // matching index before falling back to a search
+            size_t option_index = record_index;
+            if(option_index >= this->opt_cfg.size() || this->opt_cfg.val(option_index) != val)
+            {
+               for(option_index = 0; option_index < this->opt_cfg.size(); ++option_index)
+               {
+                  if(this->opt_cfg.val(option_index) == val) break;
+               }
+            }
+
+            if(option_index == this->opt_cfg.size() ||
+               strlen(this->opt_cfg.name(option_index)) != name_length ||
+               0 != memcmp(this->opt_cfg.name(option_index), name, name_length) ||
+               this->opt_cfg.type(option_index) != type)
+            {
+               throw_snapshot_error("Record does not match configured option: " + std::string(name, name_length));
+            }
+
+            cline_utils::option_value value;
+            switch(type)
+            {
+               case type_string:
+               {
+                  uint32_t length = 0;
+                  read_bytes(data, size, pos, &length, sizeof(length));
+                  if(length > size - sizeof(checksum) - pos)
+                  {
+                     throw_snapshot_error("Truncated string value");
+                  }
+                  value = std::string(data + pos, length);
+                  pos += length;
+                  break;
+               }
+               case type_double:
+               {
+                  double number = 0;
+                  read_bytes(data, size, pos, &number, sizeof(number));
+                  value = number;
+                  break;
+               }
+               case type_int:
+               {
+                  int number = 0;
+                  read_bytes(data, size, pos, &number, sizeof(number));
+                  value = number;
+                  break;
+               }
+               case type_float:
+               {
+                  float number = 0;
+                  read_bytes(data, size, pos, &number, sizeof(number));
+                  value = number;
+                  break;
+               }
+               case type_shard:
+               {
+                  cline_utils::shard_spec shard;
+                  read_bytes(data, size, pos, &shard, sizeof(shard));
+                  value = shard;
+                  break;
+               }
+               case type_string_list:
+               {
+                  uint32_t count = 0;
+                  read_bytes(data, size, pos, &count, sizeof(count));
+                  std::vector<std::string> list;
+                  for(uint32_t i = 0; i < count; ++i)
+                  {
+                     uint32_t length = 0;
+                     read_bytes(data, size, pos, &length, sizeof(length));
+                     if(length > size - sizeof(checksum) - pos)
+                     {
+                        throw_snapshot_error("Truncated string list value");
+                     }
+                     list.emplace_back(data + pos, length);
+                     pos += length;
+                  }
+                  value = std::move(list);
+                  break;
+               }
+               case type_double_array:
+               {
+                  uint64_t count = 0;
+                  read_bytes(data, size, pos, &count, sizeof(count));
+                  if(count > (size - sizeof(checksum) - pos) / sizeof(double))
+                  {
+                     throw_snapshot_error("Truncated double array value");
+                  }
+                  std::vector<double> array(count);
+                  read_bytes(data, size, pos, array.data(), count * sizeof(double));
+                  value = std::move(array);
+                  break;
+               }
+
+               case type_range:
+               {
+                  uint8_t kind = 0;
+                  uint64_t points = 0;
+                  read_bytes(data, size, pos, &kind, sizeof(kind));
+                  read_bytes(data, size, pos, &points, sizeof(points));
+                  if(cline_utils::range::range_list == kind)
+                  {
+                     if(points > (size - sizeof(checksum) - pos) / sizeof(double))
+                     {
+                        throw_snapshot_error("Truncated range value");
+                     }
+                     std::vector<double> list(points);
+                     read_bytes(data, size, pos, list.data(), points * sizeof(double));
+                     value = cline_utils::range::values(list);
+                  }
+                  else
+                  {
+                     double parameters[3];
+                     read_bytes(data, size, pos, parameters, sizeof(parameters));
+                     value = (cline_utils::range::range_log == kind) ?
+                        cline_utils::range::logarithmic(parameters[0], parameters[1], points) :
+                        cline_utils::range::linear(parameters[0], parameters[2], points, parameters[1]);
+                  }
+                  break;
+               }
+
+               default:
+               {
+                  if(NULL != cline_utils::scalar_type_ops::get(cline_utils::option_type(type)))
+                  {
+                     uint64_t bits = 0;
+                     read_bytes(data, size, pos, &bits, sizeof(bits));
+                     value = cline_utils::scalar_value{bits, cline_utils::option_type(type), this->opt_cfg.context(option_index)};
+                  }
+                  break;
+               }
+            }
+            decoded.push_back({option_index, (cline_utils::option_source)source, std::move(value)});
+         }
+
+         // Only a fully decoded record touches the bound variables
+         for(decoded_record &record : decoded)
+         {
+            this->write_bound_value(record.option_index, record.value);
+            const int val = this->opt_cfg.val(record.option_index);
+            if(source_default == record.source)
+            {
+               this->opt_source_map.erase(val);
+            }
+            else
+            {
+               this->opt_source_map[val] = record.source;
+            }
+         }
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Load a binary record made by serialize_snapshot()
+      *
+      *     @param[in] std::vector<char> &record: The binary record
+      *     @return None.
+      * 
+      */
+      void load_snapshot(const std::vector<char> &record)
+      {
+         this->load_snapshot(record.data(), record.size());
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Write the binary snapshot record to a file
+      *
+      *     @param[in] std::string filename: Output file name
+      *     @return None.
+      * 
+      */
+      void write_snapshot_file(const std::string &filename) const
+      {
+         std::vector<char> record = this->serialize_snapshot();
+         std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+         out.write(record.data(), record.size());
+         if(!out)
+         {
+            throw_snapshot_error("Unable to write snapshot file: " + filename);
+         }
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Read a binary snapshot record from a file into the bound variables
+      *
+      *     @param[in] std::string filename: Input file name
+      *     @return None.
+      * 
+      */
+      void read_snapshot_file(const std::string &filename)
+      {
+         std::ifstream in(filename, std::ios::binary | std::ios::ate);
+         if(!in)
+         {
+            throw_snapshot_error("Unable to open snapshot file: " + filename);
+         }
+
+         std::vector<char> record(in.tellg());
+         in.seekg(0);
+         in.read(record.data(), record.size());
+         this->load_snapshot(record);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Register the conventional long only --shard i/N option
+      *
+      *     @param[in] cline_utils::shard_spec &shard: Bound shard specification
+      *     @return None.
+      * 
+      */
+      void add_shard_option(cline_utils::shard_spec &shard)
+      {
+         this->add_option({"shard", required_argument, NULL, shard_option_val, optional_option, typeid(cline_utils::shard_spec).name(), &shard,
+                           " Run only share i of N of the parameter sweep (i/N)"});
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Number of configurations in the Cartesian product of all non
+      *        empty range options. Never materialized.
+      *
+      *     @return uint64_t: Product of the range sizes (1 if there are none)
+      * 
+      */
+      uint64_t sweep_size() const
+      {
+         uint64_t result = 1;
+         for(size_t option_index = 0; option_index < this->opt_cfg.size(); ++option_index)
+         {
+            if(type_range != this->opt_cfg.type(option_index))
+            {
+               continue;
+            }
+
+            uint64_t points = ((cline_utils::range *)this->opt_cfg.data(option_index))->size();
+            if(0 == points)
+            {
+               continue;
+            }
+            if(result > UINT64_MAX / points)
+            {
+               std::stringstream ss("");
+               ss << "*************************************************************************" << std::endl;
+               ss << "sweep_size(...) - Parameter sweep has more than 2^64 configurations" << std::endl;
+               ss << "*************************************************************************" << std::endl;
+               throw cline_utils::cline_exception(std::string(ss.str()));
+            }
+            result *= points;
+         }
+         return(result);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Prepare to enumerate this worker's share of the sweep. The share
+      *        is taken from the shard_spec option if one is configured (whole
+      *        sweep otherwise). Shares differ in size by at most one.
+      *
+      *     @return None.
+      * 
+      */
+      void begin_sweep()
+      {
+         cline_utils::shard_spec shard;
+
+         this->sweep_axes.clear();
+         for(size_t option_index = 0; option_index < this->opt_cfg.size(); ++option_index)
+         {
+            cline_utils::option_type type = this->opt_cfg.type(option_index);
+            if(type_range == type && 0 < ((cline_utils::range *)this->opt_cfg.data(option_index))->size())
+            {
+               this->sweep_axes.push_back(option_index);
+            }
+            else if(type_shard == type)
+            {
+               shard = *(cline_utils::shard_spec *)this->opt_cfg.data(option_index);
+            }
+         }
+
+         // Balanced partition: the first (total % count) shards get one extra configuration
+         uint64_t total = this->sweep_size();
+         uint64_t quotient = total / shard.count, remainder = total % shard.count;
+         this->sweep_begin = shard.index * quotient + std::min(shard.index, remainder);
+         this->sweep_end = this->sweep_begin + quotient + ((shard.index < remainder) ? 1 : 0);
+         this->sweep_next = this->sweep_begin;
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Bind the next configuration of this worker's share by moving the
+      *        cursor of every swept range (see range::current()). The first
+      *        configured range varies slowest. Call begin_sweep() first.
+      *
+      *     @return bool: False once the share is exhausted
+      * 
+      */
+      bool next_sweep_point()
+      {
+         if(this->sweep_next >= this->sweep_end)
+         {
+            return(false);
+         }
+
+         if(this->sweep_next == this->sweep_begin)
+         {
+            // Mixed radix decode of the configuration index, done once per share
+            uint64_t remaining = this->sweep_next;
+            for(size_t axis = this->sweep_axes.size(); 0 < axis--;)
+            {
+               cline_utils::range *r = (cline_utils::range *)this->opt_cfg.data(this->sweep_axes[axis]);
+               r->set_cursor(remaining % r->size());
+               remaining /= r->size();
+            }
+         }
+         else
+         {
+            // Odometer increment, amortized O(1) per configuration
+            for(size_t axis = this->sweep_axes.size(); 0 < axis--;)
+            {
+               cline_utils::range *r = (cline_utils::range *)this->opt_cfg.data(this->sweep_axes[axis]);
+               if(r->get_cursor() + 1 < r->size())
+               {
+                  r->set_cursor(r->get_cursor() + 1);
+                  break;
+               }
+               r->set_cursor(0);
+            }
+         }
+
+         ++this->sweep_next;
+         return(true);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Global index (over all shards) of the configuration bound by the
+      *        last successful next_sweep_point() call
+      *
+      *     @return uint64_t.
+      * 
+      */
+      uint64_t get_sweep_index() const
+      {
+         return(this->sweep_next - 1);
+      }
+
+      uint64_t get_shard_begin() const { return(this->sweep_begin); }
+      uint64_t get_shard_end() const { return(this->sweep_end); }
+
+      /************************************************************************/
+      /*
+      * \brief Add a check involving several options, e.g. [&]{ return lo < hi; }.
+      *        Evaluated by check_constraints() after the per option checks.
+      *
+      *     @param[in] std::function<bool()> predicate: Returns true if the configuration is valid
+      *     @param[in] std::string message: Reported when the predicate fails
+      *     @return None.
+      * 
+      */
+      void add_cross_constraint(const std::function<bool()> &predicate, const std::string &message)
+      {
+         this->cross_constraints.push_back({predicate, message});
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Evaluate the whole constraint table in a single pass over values
+      *        set by the parser and report every violation in one exception.
+      *        Called at the end of parse_command_line().
+      *
+      *     @return None.
+      * 
+      */
+      void check_constraints()
+      {
+         std::stringstream violations("");
+         size_t count = this->find_constraint_violations(
+            [this](size_t option_index) -> const void *
+            {
+               return((source_default == this->get_option_source(this->opt_cfg.val(option_index))) ? NULL : this->opt_cfg.data(option_index));
+            }, violations);
+
+         if(0 != this->positional_path_checks)
+         {
+            std::vector<path_job> paths;
+            for(size_t i = 0; i < this->positional_args.size(); ++i)
+            {
+               paths.push_back({std::string::npos, this->positional_path_checks, this->positional_args[i]});
+            }
+            count += this->find_path_violations(paths, violations);
+         }
+
+         for(size_t i = 0; i < this->cross_constraints.size(); ++i)
+         {
+            if(false == this->cross_constraints[i].first())
+            {
+               violations << "   " << this->cross_constraints[i].second << std::endl;
+               ++count;
+            }
+         }
+
+         if(0 < count)
+         {
+            std::stringstream ss("");
+            ss << "*************************************************************************" << std::endl;
+            ss << "check_constraints(...) - " << count << " constraint violation(s):" << std::endl;
+            ss << violations.str();
+            ss << "*************************************************************************" << std::endl;
+            throw cline_utils::cline_exception(std::string(ss.str()));
+         }
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Read option values from a config file of "long_name = value" lines
+      *        ('#' starts a comment line, a bare long name sets a flag). Values
+      *        given on the command line take precedence.
+      *
+      *     @param[in] std::string filename: Config file name
+      *     @return None.
+      * 
+      */
+      void set_config_file(const std::string &filename)
+      {
+         this->config_filename = filename;
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Add a config file below the one given to set_config_file(). Layers
+      *        override each other in the order they are added (site, project,
+      *        user, ...); the set_config_file() file overrides all of them and
+      *        the command line overrides every file. An "@include path" line
+      *        splices in another file at that point (paths relative to the
+      *        including file). All files are read concurrently, overlapping
+      *        the tokenizing of argv.
+      *
+      *     @param[in] std::string filename: Config file name
+      *     @param[in] bool optional: Skip the layer if the file does not exist
+      *     @return None.
+      * 
+      */
+      void add_config_layer(const std::string &filename, bool optional = false)
+      {
+         this->config_layers.emplace_back(filename, optional);
+      }
+
+      void clear_config_layers()
+      {
+         this->config_layers.clear();
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Choose how config files are read: io_uring (default, where the
+      *        kernel allows it) or blocking reads on the shared thread pool
+      *
+      *     @param[in] bool enabled: False forces the thread pool
+      *     @return None.
+      * 
+      */
+      void set_io_uring_enabled(bool enabled)
+      {
+         this->io_uring_enabled = enabled;
+      }
+
+      /************************************************************************/
+      /*
+      * \brief How the config files of the last parse or reload were read
+      *
+      */
+      cline_utils::file_batch::backend_kind get_config_backend() const
+      {
+         return(cline_utils::file_batch::backend_kind(this->config_backend.load()));
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Keep the fully resolved configuration of a parse in a binary
+      *        cache file. The next parse with the same argv, the same values
+      *        of the named environment variables, the same options and
+      *        unchanged config files (device, inode, size and mtime of every
+      *        file read, includes and missing optional layers too) maps the
+      *        file and loads the values straight into the bound variables,
+      *        without reading the config files or converting any text.
+      *        Constraints are still checked, as path checks depend on the
+      *        file system.
+      *
+      *        The file is replaced atomically (written beside it, then
+      *        renamed), so concurrent launches never see a partial record;
+      *        an unreadable or corrupt file is a miss. Parses of options
+      *        expanded as globs are never cached, and a parse is not stored
+      *        while a config file has the same mtime as the parse started,
+      *        since a change within the same clock tick would go unnoticed.
+      *
+      *     @param[in] std::string path: Cache file, "" disables the cache
+      *     @param[in] std::vector<std::string> env_names: Environment variables the configuration depends on
+      *     @return None.
+      * 
+      */
+      void set_config_cache(const std::string &path, std::vector<std::string> env_names = {})
+      {
+         this->config_cache_path = path;
+         this->config_cache_env.assign(env_names.begin(), env_names.end());
+      }
+
+      /************************************************************************/
+      /*
+      * \brief True if the last parse was loaded from the config cache
+      *
+      */
+      bool loaded_from_config_cache() const
+      {
+         return(this->config_cache_used);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Publish the current bound values as a new immutable snapshot
+      *        that reader threads pick up without locking
+      *
+      *     @return None.
+      * 
+      */
+      void publish_snapshot()
+      {
+         snapshot_state &state = this->get_snapshot_state();
+         std::lock_guard<std::mutex> lock(state.publish_mutex);
+
+         cline_utils::config_snapshot *snapshot = this->new_snapshot(state);
+         for(size_t option_index = 0; option_index < this->opt_cfg.size(); ++option_index)
+         {
+            snapshot->values[option_index] = this->read_bound_value(option_index);
+            snapshot->sources[option_index] = this->get_option_source(this->opt_cfg.val(option_index));
+         }
+         state.cell.publish(snapshot);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Claim a reader slot for one reader thread. read() on the returned
+      *        handle gives wait-free access to the latest published snapshot.
+      *
+      *     @return cline_utils::snapshot_reader.
+      * 
+      */
+      cline_utils::snapshot_reader register_snapshot_reader()
+      {
+         return(this->get_snapshot_state().cell.register_reader());
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Re-read the config file into a new snapshot and publish it. The
+      *        bound variables are left alone so threads reading them directly
+      *        are not raced. Command line values keep precedence, options that
+      *        disappeared from the file fall back to their defaults. Per option
+      *        constraints are checked; cross constraints refer to the bound
+      *        variables and are not.
+      *
+      *     @return bool: False (and nothing published) if the file is invalid
+      * 
+      */
+      bool reload_config()
+      {
+         snapshot_state &state = this->get_snapshot_state();
+         std::lock_guard<std::mutex> lock(state.publish_mutex);
+
+         std::unique_ptr<cline_utils::config_snapshot> snapshot(this->new_snapshot(state));
+         // The watcher thread must not share the parser's memory resource
+         std::pmr::memory_resource *heap = std::pmr::new_delete_resource();
+         std::pmr::vector<std::pmr::string> read_paths(heap);
+         try
+         {
+            const cline_utils::config_snapshot *previous = state.cell.unsafe_get();
+            for(size_t option_index = 0; option_index < this->opt_cfg.size(); ++option_index)
+            {
+               bool from_command_line = (NULL != previous && source_command_line == previous->sources[option_index]);
+               snapshot->values[option_index] = from_command_line ? previous->values[option_index] : this->default_values[option_index];
+               snapshot->sources[option_index] = from_command_line ? source_command_line : source_default;
+            }
+
+            // The watcher thread reloads with its own batch, never pending_config
+            config_entries entries = this->finish_config_load(this->start_config_load(heap), heap, &read_paths);
+            for(size_t i = 0; i < entries.size(); ++i)
+            {
+               const size_t option_index = entries[i].first;
+               if(source_command_line != snapshot->sources[option_index])
+               {
+                  if(false == this->convert_into_value(option_index, entries[i].second, snapshot->values[option_index]))
+                  {
+                     std::stringstream ss("");
+                     ss << "*************************************************************************" << std::endl;
+                     ss << "reload_config(...) - Unable to match option type string: " << this->describe_option(this->opt_cfg.val(option_index)) << std::endl;
+                     ss << "*************************************************************************" << std::endl;
+                     throw cline_utils::cline_exception(std::string(ss.str()));
+                  }
+                  snapshot->sources[option_index] = source_config_file;
+               }
+            }
+
+            std::stringstream violations("");
+            size_t count = this->find_constraint_violations(
+               [&snapshot](size_t option_index) -> const void *
+               {
+                  return((source_default == snapshot->sources[option_index]) ? NULL : value_pointer(snapshot->values[option_index]));
+               }, violations);
+            if(0 < count)
+            {
+               std::stringstream ss("");
+               ss << "*************************************************************************" << std::endl;
+               ss << "reload_config(...) - " << count << " constraint violation(s):" << std::endl;
+               ss << violations.str();
+               ss << "*************************************************************************" << std::endl;
+               throw cline_utils::cline_exception(std::string(ss.str()));
+            }
+         }
+         catch(const cline_utils::cline_exception &e)
+         {
+            std::lock_guard<std::mutex> error_lock(state.error_mutex);
+            state.last_error = e.what();
+            return(false);
+         }
+
+         state.cell.publish(snapshot.release());
+         state.config_paths.assign(read_paths.begin(), read_paths.end());
+         ++state.reloads;
+         return(true);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Start a thread that reloads and republishes the configuration
+      *        whenever one of its files is rewritten or replaced: every layer
+      *        of add_config_layer(), the set_config_file() file and the files
+      *        they @include (inotify on their directories, so editors that
+      *        rename over a file are seen too). Files included by a reload are
+      *        watched from then on. Publishes the current values first if
+      *        nothing was published yet. Options must not be changed while the
+      *        watch is running.
+      *
+      *     @return None.
+      * 
+      */
+      void watch_config_file()
+      {
+         snapshot_state &state = this->get_snapshot_state();
+         if(state.watch_thread.joinable())
+         {
+            return;
+         }
+         if(this->config_sources(std::pmr::new_delete_resource()).empty() || this->default_values.empty())
+         {
+            throw_watch_error("Set a config file and parse the command line before watching");
+         }
+         if(NULL == state.cell.unsafe_get())
+         {
+            this->publish_snapshot();
+         }
+
+         std::pmr::memory_resource *heap = std::pmr::new_delete_resource();
+         std::pmr::vector<std::pmr::string> loaded_paths(heap);
+         this->finish_config_load(this->start_config_load(heap), heap, &loaded_paths);
+         const std::vector<std::string> paths(loaded_paths.begin(), loaded_paths.end());
+         {
+            std::lock_guard<std::mutex> lock(state.publish_mutex);
+            state.config_paths = paths;
+         }
+
+         int inotify_fd = inotify_init1(IN_CLOEXEC);
+         if(0 > inotify_fd)
+         {
+            throw_watch_error(std::string("Unable to create inotify instance: ") + strerror(errno));
+         }
+         std::map<int, std::set<std::string>> watched; // Watched file names per directory
+         std::string failed = add_config_watches(inotify_fd, paths, watched);
+         if(false == failed.empty())
+         {
+            close(inotify_fd);
+            throw_watch_error("Unable to watch directory " + failed + ": " + strerror(errno));
+         }
+         if(0 != pipe2(state.stop_pipe, O_CLOEXEC))
+         {
+            close(inotify_fd);
+            throw_watch_error(std::string("Unable to create stop pipe: ") + strerror(errno));
+         }
+
+         state.watch_thread = std::thread([this, inotify_fd, watched]() mutable
+            {
+               snapshot_state &state = *this->snapshots;
+               alignas(struct inotify_event) char buffer[4096];
+               while(true)
+               {
+                  struct pollfd fds[2] = {{inotify_fd, POLLIN, 0}, {state.stop_pipe[0], POLLIN, 0}};
+                  if(0 > poll(fds, 2, -1) && EINTR != errno) break;
+                  if(0 != fds[1].revents) break;
+                  if(0 == fds[0].revents) continue;
+
+                  ssize_t length = read(inotify_fd, buffer, sizeof(buffer));
+                  bool changed = false;
+                  for(ssize_t pos = 0; pos < length;)
+                  {
+                     const struct inotify_event *event = (const struct inotify_event *)(buffer + pos);
+                     auto names = watched.find(event->wd);
+                     changed = changed || (0 < event->len && names != watched.end() && 0 != names->second.count(event->name));
+                     pos += sizeof(struct inotify_event) + event->len;
+                  }
+                  if(changed && this->reload_config())
+                  {
+                     // A file may have gained an @include
+                     std::vector<std::string> paths;
+                     {
+                        std::lock_guard<std::mutex> lock(state.publish_mutex);
+                        paths = state.config_paths;
+                     }
+                     add_config_watches(inotify_fd, paths, watched);
+                  }
+               }
+               close(inotify_fd);
+            });
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Stop the config file watch thread (no-op if none is running)
+      *
+      *     @return None.
+      * 
+      */
+      void stop_config_watch()
+      {
+         if(NULL == this->snapshots || false == this->snapshots->watch_thread.joinable())
+         {
+            return;
+         }
+         snapshot_state &state = *this->snapshots;
+         char stop = 1;
+         if(1 != write(state.stop_pipe[1], &stop, 1))
+         {
+            // Closing the write end wakes poll() just as well
+         }
+         close(state.stop_pipe[1]);
+         state.watch_thread.join();
+         close(state.stop_pipe[0]);
+         state.stop_pipe[0] = state.stop_pipe[1] = -1;
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Number of successful reloads and the error of the last failed one
+      *
+      */
+      uint64_t get_reload_count() const
+      {
+         return((NULL == this->snapshots) ? 0 : this->snapshots->reloads.load());
+      }
+
+      std::string get_reload_error() const
+      {
+         if(NULL == this->snapshots) return("");
+         std::lock_guard<std::mutex> lock(this->snapshots->error_mutex);
+         return(this->snapshots->last_error);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Accept positional (non-option) arguments. By default none are
+      *        accepted and any non-option argument is an error.
+      *
+      *     @param[in] size_t min_count: Fewest positional arguments required
+      *     @param[in] size_t max_count: Most positional arguments accepted
+      *     @return None.
+      * 
+      */
+      void set_positional_arity(size_t min_count, size_t max_count = SIZE_MAX)
+      {
+         if(min_count > max_count)
+         {
+            std::stringstream ss("");
+            ss << "*************************************************************************" << std::endl;
+            ss << "set_positional_arity(...) - Minimum " << min_count << " exceeds maximum " << max_count << std::endl;
+            ss << "*************************************************************************" << std::endl;
+            throw cline_utils::cline_exception(std::string(ss.str()));
+         }
+         this->positional_min = min_count;
+         this->positional_max = max_count;
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Require every positional argument to be a path passing the given
+      *        checks. They are validated with the path constraints of the
+      *        options, in one parallel batch at the end of the parse.
+      *
+      *     @param[in] unsigned checks: option_constraint::path_check bits, 0 turns the checks off
+      *     @return None.
+      * 
+      */
+      void set_positional_path_checks(unsigned checks)
+      {
+         this->positional_path_checks = (0 == checks) ? 0 : (checks | cline_utils::option_constraint::path_exists);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Positional arguments of the last parse, in command line order.
+      *        The view points into argv and is valid as long as argv is.
+      *
+      *     @return const cline_utils::positional_view &: View of the arguments
+      * 
+      */
+      const cline_utils::positional_view &get_positional_arguments() const
+      {
+         return(this->positional_args);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Positional arguments followed by the entries of a --files-from
+      *        style option: a string option naming a list file, "-" for
+      *        standard input. The list is read lazily as the stream is
+      *        consumed, through a buffer of fixed size.
+      *
+      *           for(std::string_view file : cline.get_positional_stream('F', '\0')) { ... }
+      *
+      *     @param[in] int files_from_val: Val of the list option
+      *     @param[in] char delimiter: '\n' (default) or '\0' between entries
+      *     @param[in] size_t capacity: Buffer size, also the longest entry accepted
+      *     @return files_from_reader: The entries; only the positionals if the option was not given
+      * 
+      */
+      cline_utils::files_from_reader get_positional_stream(int files_from_val, char delimiter = '\n', size_t capacity = 65536) const
+      {
+         int option_index = this->find_option_index(files_from_val);
+         if(0 > option_index || type_string != this->opt_cfg.type(option_index))
+         {
+            std::stringstream ss("");
+            ss << "*************************************************************************" << std::endl;
+            ss << "get_positional_stream(...) - Option " << this->describe_option(files_from_val) << " is not a string option" << std::endl;
+            ss << "*************************************************************************" << std::endl;
+            throw cline_utils::cline_exception(std::string(ss.str()));
+         }
+
+         cline_utils::files_from_reader reader = (source_default == this->get_option_source(files_from_val)) ?
+            cline_utils::files_from_reader(-1, delimiter, capacity) :
+            cline_utils::files_from_reader::open(*(const std::string *)this->opt_cfg.data(option_index), delimiter, capacity);
+         for(const char *argument : this->positional_args)
+         {
+            reader.add_leading(argument);
+         }
+         return(reader);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Streaming alternative to parse_command_line(). Each option and
+      *        positional argument is converted and handed to callback as soon
+      *        as it is tokenized; nothing is collected and the bound variables
+      *        are not written. "@file" arguments are read from the file token
+      *        by token (whitespace separated, double quotes group), so argument
+      *        lists of any length are parsed in constant memory. Required
+      *        options, option groups and positional arity are checked at the
+      *        end of the stream.
+      *
+      *        Supported syntax: -a value, -avalue, -xyz flag bundles,
+      *        --name value, --name=value, -- (end of options) and @file.
+      *
+      *     @param[in] event_callback callback: Return false to stop early
+      *     @return uint64_t: Number of events delivered
+      * 
+      */
+      uint64_t stream_command_line(const cline_utils::event_callback &callback)
+      {
+         this->compile_option_bitsets();
+
+         stream_state state;
+         state.callback = &callback;
+
+         for(int argv_index = 1; argv_index < this->argc_ && false == state.stopped; ++argv_index)
+         {
+            this->push_token(state, this->argv_[argv_index], true);
+         }
+
+         if(false == state.stopped)
+         {
+            if(0 <= state.pending_option)
+            {
+               throw_stream_error("Missing argument for option: --" + std::string(this->opt_cfg.name(state.pending_option)));
+            }
+            if(state.positionals < this->positional_min)
+            {
+               throw_stream_error("Expected at least " + std::to_string(this->positional_min) + " positional argument(s), got " + std::to_string(state.positionals));
+            }
+            this->check_required_options();
+            this->check_option_groups();
+         }
+
+         return(state.options + state.positionals);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Publish the current values to a sealed, read only memfd with the
+      *        fixed shared_config layout. Forked children, or exec'd ones that
+      *        inherit the descriptor, attach with shared_config_view::attach(fd)
+      *        instead of parsing again.
+      *
+      *     @param[in] bool inherit_on_exec: Keep the descriptor open across exec
+      *     @return int: Descriptor owned by the caller
+      * 
+      */
+      int publish_shared_config(bool inherit_on_exec = true) const
+      {
+         const size_t options = this->opt_cfg.size();
+         uint32_t slot_count = 8;
+         while(slot_count < 2 * options) slot_count *= 2;
+
+         cline_utils::shared_config_header header = {};
+         memcpy(header.magic, cline_utils::shared_config_view::magic, sizeof(header.magic));
+         header.version = cline_utils::shared_config_view::layout_version;
+         header.bom = 0xFEFF;
+         header.option_count = options;
+         header.slot_count = slot_count;
+         header.entries_offset = sizeof(header);
+         header.slots_offset = header.entries_offset + options * sizeof(cline_utils::shared_config_entry);
+         header.data_offset = (header.slots_offset + slot_count * sizeof(uint32_t) + 7) & ~uint64_t(7);
+
+         // Entries and slots are filled in place once the data area is laid out
+         std::pmr::vector<char> segment(header.data_offset, '\0', this->resource);
+         auto append_data = [&segment](const void *data, size_t size) -> uint64_t
+            {
+               const uint64_t offset = segment.size();
+               segment.insert(segment.end(), (const char *)data, (const char *)data + size);
+               segment.resize((segment.size() + 7) & ~size_t(7), '\0');
+               return(offset);
+            };
+
+         std::pmr::vector<cline_utils::shared_config_entry> entries(options, cline_utils::shared_config_entry{}, this->resource);
+         std::pmr::vector<uint32_t> slots(slot_count, 0, this->resource);
+         for(size_t option_index = 0; option_index < options; ++option_index)
+         {
+            cline_utils::shared_config_entry &e = entries[option_index];
+            const char *name = this->opt_cfg.name(option_index);
+            const void *dataVal = this->opt_cfg.data(option_index);
+
+            e.val = this->opt_cfg.val(option_index);
+            e.type = this->opt_cfg.type(option_index);
+            e.source = this->get_option_source(e.val);
+            e.name_length = strlen(name);
+            e.name_offset = append_data(name, e.name_length + 1);
+
+            switch(e.type)
+            {
+               case type_string:
+               {
+                  const std::string &value = *(const std::string *)dataVal;
+                  e.value.text.length = value.size();
+                  e.value.text.offset = append_data(value.c_str(), value.size() + 1);
+                  break;
+               }
+               case type_double: e.value.real = *(const double *)dataVal; break;
+               case type_int:    e.value.integer = *(const int *)dataVal; break;
+               case type_float:  e.value.single = *(const float *)dataVal; break;
+
+               case type_shard:
+                  e.value.shard.index = ((const cline_utils::shard_spec *)dataVal)->index;
+                  e.value.shard.count = ((const cline_utils::shard_spec *)dataVal)->count;
+                  break;
+
+               case type_string_list:
+               {
+                  std::string joined;
+                  for(const std::string &value : *(const std::vector<std::string> *)dataVal)
+                  {
+                     joined.append(value.c_str(), value.size() + 1);
+                  }
+                  e.value.text.length = joined.size();
+                  e.value.text.offset = append_data(joined.data(), joined.size());
+                  break;
+               }
+
+               case type_double_array:
+               {
+                  const std::vector<double> &value = *(const std::vector<double> *)dataVal;
+                  e.value.points.count = value.size();
+                  e.value.points.offset = append_data(value.data(), value.size() * sizeof(double));
+                  break;
+               }
+
+               case type_range:
+               {
+                  const cline_utils::range &value = *(const cline_utils::range *)dataVal;
+                  const uint64_t kind = value.get_kind();
+                  const double parameters[3] = {value.get_start(), value.get_stop(), value.get_step()};
+                  e.value.points.count = value.size();
+                  e.value.points.offset = append_data(&kind, sizeof(kind));
+                  append_data(parameters, sizeof(parameters));
+                  if(cline_utils::range::range_list == kind)
+                  {
+                     append_data(value.get_list().data(), value.size() * sizeof(double));
+                  }
+                  break;
+               }
+
+               default:
+               {
+                  const cline_utils::scalar_type_ops *ops = cline_utils::scalar_type_ops::get(cline_utils::option_type(e.type));
+                  if(NULL != ops)
+                  {
+                     e.value.bits = ops->load(dataVal, this->opt_cfg.context(option_index));
+                  }
+                  if(type_duration == e.type)
+                  {
+                     const cline_utils::duration_unit &unit = *(const cline_utils::duration_unit *)this->opt_cfg.context(option_index);
+                     e.value.duration.num = unit.num;
+                     e.value.duration.den = unit.den;
+                  }
+                  break;
+               }
+            }
+
+            uint32_t slot = cline_utils::shared_config_view::hash_name(name, e.name_length) & (slot_count - 1);
+            while(0 != slots[slot]) slot = (slot + 1) & (slot_count - 1);
+            slots[slot] = option_index + 1;
+         }
+
+         header.total_size = segment.size();
+         memcpy(segment.data(), &header, sizeof(header));
+         memcpy(segment.data() + header.entries_offset, entries.data(), options * sizeof(cline_utils::shared_config_entry));
+         memcpy(segment.data() + header.slots_offset, slots.data(), slot_count * sizeof(uint32_t));
+
+         int fd = memfd_create("cline_shared_config", MFD_ALLOW_SEALING | (inherit_on_exec ? 0 : MFD_CLOEXEC));
+         if(0 > fd)
+         {
+            throw_shared_config_error(std::string("memfd_create failed: ") + strerror(errno));
+         }
+
+         // One write, then seal so nobody can change or resize the segment
+         for(size_t written = 0; written < segment.size();)
+         {
+            ssize_t count = pwrite(fd, segment.data() + written, segment.size() - written, written);
+            if(0 > count && EINTR == errno) continue;
+            if(0 >= count)
+            {
+               close(fd);
+               throw_shared_config_error(std::string("Unable to write shared configuration: ") + strerror(errno));
+            }
+            written += count;
+         }
+         if(0 != fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL))
+         {
+            close(fd);
+            throw_shared_config_error(std::string("Unable to seal shared configuration: ") + strerror(errno));
+         }
+
+         return(fd);
+      }
+
+      private:
+
+      /************************************************************************/
+      /*
+      * \brief Convert an argument into an option_value of the option type,
+      *        without touching the bound variable
+      *
+      *     @param[in] size_t option_index: Index of the option in the configuration
+      *     @param[in] std::string_view text: Argument text, NUL terminated right after its end
+      *     @param[in,out] option_value &value: Holds the previous value, receives the new one
+      *     @return bool: False if the option type is not supported
+      * 
+      */
+      bool convert_into_value(size_t option_index, std::string_view text, cline_utils::option_value &value) const
+      {
+         if(NULL != cline_utils::scalar_type_ops::get(this->opt_cfg.type(option_index)))
+         {
+            value = cline_utils::scalar_value{this->parse_scalar(option_index, text.data()), this->opt_cfg.type(option_index),
+                                              this->opt_cfg.context(option_index)};
+            return(true);
+         }
+         return(this->convert_argument(option_index, text, value_pointer(value)));
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Parse the argument of a scalar option (see option_traits) into its bits
+      *
+      */
+      uint64_t parse_scalar(size_t option_index, const char *optArgString) const
+      {
+         const cline_utils::option_type type = this->opt_cfg.type(option_index);
+         uint64_t bits = 0;
+         std::string error;
+         if(type_bool == type && '\0' == optArgString[0] && no_argument != this->opt_cfg.has_arg(option_index))
+         {
+            this->throw_conversion_error(option_index, optArgString, "missing boolean value");
+         }
+         if(false == cline_utils::scalar_type_ops::get(type)->parse(optArgString, this->opt_cfg.context(option_index), bits, error))
+         {
+            this->throw_conversion_error(option_index, optArgString, error);
+         }
+         return(bits);
+      }
+
+      void throw_conversion_error(size_t option_index, const char *optArgString, const std::string &reason) const
+      {
+         std::stringstream ss("");
+         ss << "*************************************************************************" << std::endl;
+         ss << "convert_argument(...) - Invalid value for " << this->describe_option(this->opt_cfg.val(option_index)) << ": '" << optArgString << "' " << reason << std::endl;
+         ss << "*************************************************************************" << std::endl;
+         throw cline_utils::cline_exception(std::string(ss.str()));
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Current value of an option into a table row
+      *
+      */
+      void print_value(bprinter::TablePrinter &tp, size_t option_index)
+      {
+         const void *dataVal = this->opt_cfg.data(option_index);
+         switch(this->opt_cfg.type(option_index))
+         {
+            case type_string: tp << *(const std::string *)dataVal; break;
+            case type_double: tp << *(const double *)dataVal; break;
+            case type_float:  tp << *(const float *)dataVal; break;
+            case type_int:    tp << *(const int *)dataVal; break;
+            case type_range:  tp << ((const cline_utils::range *)dataVal)->to_string(); break;
+            case type_shard:  tp << ((const cline_utils::shard_spec *)dataVal)->to_string(); break;
+
+            case type_string_list:
+            {
+               const std::vector<std::string> &list = *(const std::vector<std::string> *)dataVal;
+               tp << ((1 == list.size()) ? list[0] : std::to_string(list.size()) + " values");
+               break;
+            }
+
+            case type_double_array:
+            {
+               const std::vector<double> &array = *(const std::vector<double> *)dataVal;
+               if(1 == array.size()) tp << array[0];
+               else                  tp << std::to_string(array.size()) + " values";
+               break;
+            }
+
+            default:
+            {
+               const cline_utils::scalar_type_ops *ops = cline_utils::scalar_type_ops::get(this->opt_cfg.type(option_index));
+               const void *ctx = this->opt_cfg.context(option_index);
+               tp << ((NULL != ops) ? ops->format(ops->load(dataVal, ctx), ctx) : std::string("None "));
+               break;
+            }
+         }
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Stable type names of the JSON / CSV summaries
+      *
+      */
+      static const char *summary_type_name(cline_utils::option_type type)
+      {
+         static const char *names[] = {"none", "string", "double", "int", "float", "range", "shard",
+                                       "int64", "uint64", "bool", "enum", "duration", "string_list", "double_array"};
+         return((type_double_array >= type) ? names[type] : "none");
+      }
+
+      template <typename T>
+      static void append_number(std::string &out, T value, bool json)
+      {
+         if(std::is_floating_point_v<T> && json && false == std::isfinite(double(value)))
+         {
+            out += "null";
+            return;
+         }
+         char text[64];
+         auto result = std::to_chars(text, text + sizeof(text), value);
+         out.append(text, result.ptr - text);
+      }
+
+      static void append_json_string(std::string &out, std::string_view text)
+      {
+         static const char hex[] = "0123456789abcdef";
+         out += '"';
+         for(char c : text)
+         {
+            switch(c)
+            {
+               case '"':  out += "\\\""; break;
+               case '\\': out += "\\\\"; break;
+               case '\n': out += "\\n"; break;
+               case '\r': out += "\\r"; break;
+               case '\t': out += "\\t"; break;
+               default:
+                  if(0x20 > (unsigned char)c)
+                  {
+                     out += "\\u00";
+                     out += hex[(unsigned char)c >> 4];
+                     out += hex[c & 15];
+                  }
+                  else
+                  {
+                     out += c;
+                  }
+            }
+         }
+         out += '"';
+      }
+
+      static void append_csv_field(std::string &out, std::string_view text)
+      {
+         if(std::string_view::npos == text.find_first_of(",\"\r\n"))
+         {
+            out += text;
+            return;
+         }
+         out += '"';
+         for(char c : text)
+         {
+            if('"' == c) out += '"';
+            out += c;
+         }
+         out += '"';
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Options of a dotted namespace, throws if there are none
+      *
+      */
+      std::vector<size_t> find_namespace_options(const char *caller, const std::string &prefix) const
+      {
+         std::vector<size_t> indices;
+         if(false == this->opt_cfg.find_namespace(prefix, indices) || indices.empty())
+         {
+            std::stringstream ss("");
+            ss << "*************************************************************************" << std::endl;
+            ss << caller << "(...) - No options in namespace '" << prefix << "'" << std::endl;
+            ss << "*************************************************************************" << std::endl;
+            throw cline_utils::cline_exception(std::string(ss.str()));
+         }
+         return(indices);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Current value of a scalar, string, range, shard or double array
+      *        option as the value of a config file line
+      *
+      */
+      void append_config_value(std::string &out, size_t option_index) const
+      {
+         const void *dataVal = this->opt_cfg.data(option_index);
+         const cline_utils::option_type type = this->opt_cfg.type(option_index);
+         const void *ctx = this->opt_cfg.context(option_index);
+         switch(type)
+         {
+            case type_double: append_number(out, *(const double *)dataVal, false); break;
+            case type_float:  append_number(out, *(const float *)dataVal, false); break;
+            case type_int:    append_number(out, *(const int *)dataVal, false); break;
+            case type_bool:   out += *(const bool *)dataVal ? "true" : "false"; break;
+            case type_string: out += '"' + *(const std::string *)dataVal + '"'; break;
+            case type_range:  out += ((const cline_utils::range *)dataVal)->to_string(); break;
+            case type_shard:  out += ((const cline_utils::shard_spec *)dataVal)->to_string(); break;
+            case type_double_array:
+            {
+               const std::vector<double> &array = *(const std::vector<double> *)dataVal;
+               for(size_t i = 0; i < array.size(); ++i)
+               {
+                  if(0 < i) out += ',';
+                  append_number(out, array[i], false);
+               }
+               break;
+            }
+            default:
+            {
+               const cline_utils::scalar_type_ops *ops = cline_utils::scalar_type_ops::get(type);
+               if(NULL != ops)
+               {
+                  out += ops->format(ops->load(dataVal, ctx), ctx);
+               }
+               break;
+            }
+         }
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Current value of an option into a JSON or CSV summary
+      *
+      */
+      void append_summary_value(std::string &out, size_t option_index, bool json) const
+      {
+         const void *dataVal = this->opt_cfg.data(option_index);
+         const cline_utils::option_type type = this->opt_cfg.type(option_index);
+         const void *ctx = this->opt_cfg.context(option_index);
+         std::string text;
+         switch(type)
+         {
+            case type_double: append_number(out, *(const double *)dataVal, json); return;
+            case type_float:  append_number(out, *(const float *)dataVal, json); return;
+            case type_int:    append_number(out, *(const int *)dataVal, json); return;
+            case type_int64:  append_number(out, int64_t(scalar_type_ops::load_word(dataVal, ctx)), json); return;
+            case type_uint64: append_number(out, scalar_type_ops::load_word(dataVal, ctx), json); return;
+            case type_bool:   out += *(const bool *)dataVal ? "true" : "false"; return;
+            case type_string: text = *(const std::string *)dataVal; break;
+            case type_range:  text = ((const cline_utils::range *)dataVal)->to_string(); break;
+            case type_shard:  text = ((const cline_utils::shard_spec *)dataVal)->to_string(); break;
+            case type_string_list:
+            {
+               // JSON array, or one CSV field with the elements separated by ';'
+               const std::vector<std::string> &list = *(const std::vector<std::string> *)dataVal;
+               if(json) out += '[';
+               for(size_t i = 0; i < list.size(); ++i)
+               {
+                  if(0 < i) text += json ? "" : ";";
+                  if(json)
+                  {
+                     if(0 < i) out += ',';
+                     append_json_string(out, list[i]);
+                  }
+                  else
+                  {
+                     text += list[i];
+                  }
+               }
+               if(json)
+               {
+                  out += ']';
+                  return;
+               }
+               break;
+            }
+            case type_double_array:
+            {
+               const std::vector<double> &array = *(const std::vector<double> *)dataVal;
+               if(json) out += '[';
+               for(size_t i = 0; i < array.size(); ++i)
+               {
+                  if(0 < i) (json ? out : text) += json ? ',' : ';';
+                  append_number(json ? out : text, array[i], json);
+               }
+               if(json)
+               {
+                  out += ']';
+                  return;
+               }
+               break;
+            }
+            default:
+            {
+               const cline_utils::scalar_type_ops *ops = cline_utils::scalar_type_ops::get(type);
+               if(NULL == ops)
+               {
+                  out += json ? "null" : "";
+                  return;
+               }
+               text = ops->format(ops->load(dataVal, ctx), ctx);
+               break;
+            }
+         }
+         if(json) append_json_string(out, text); else append_csv_field(out, text);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Append the constraints of one option to the flat constraint table
+      *
+      */
+      void compile_constraints(size_t option_index, const std::vector<cline_utils::option_constraint> &constraints)
+      {
+         const bool is_string = (type_string == this->opt_cfg.type(option_index) || type_string_list == this->opt_cfg.type(option_index));
+
+         for(const cline_utils::option_constraint &constraint : constraints)
+         {
+            compiled_constraint c;
+            c.option_index = option_index;
+            c.kind = constraint.kind;
+            c.lower_exclusive = constraint.lower_exclusive;
+            c.lower = constraint.lower;
+            c.upper = constraint.upper;
+            c.path_checks = constraint.path_checks;
+            c.allowed_first = is_string ? this->allowed_strings.size() : this->allowed_values.size();
+            c.allowed_count = constraint.allowed.size();
+
+            for(const std::string &allowed : constraint.allowed)
+            {
+               if(is_string)
+               {
+                  this->allowed_strings.emplace_back(allowed.data(), allowed.size());
+               }
+               else
+               {
+                  this->allowed_values.push_back(strtod(allowed.c_str(), NULL));
+               }
+            }
+
+            const unsigned classes = constraint.char_classes;
+            for(int ch = 0; ch < 256; ++ch)
+            {
+               c.charset[ch] = ((classes & option_constraint::chars_lower)      && islower(ch)) ||
+                               ((classes & option_constraint::chars_upper)      && isupper(ch)) ||
+                               ((classes & option_constraint::chars_digit)      && isdigit(ch)) ||
+                               ((classes & option_constraint::chars_underscore) && '_' == ch) ||
+                               ((classes & option_constraint::chars_dash)       && '-' == ch) ||
+                               ((classes & option_constraint::chars_dot)        && '.' == ch) ||
+                               ((classes & option_constraint::chars_slash)      && '/' == ch) ||
+                               ((classes & option_constraint::chars_space)      && ' ' == ch);
+            }
+
+            this->constraint_table.push_back(c);
+         }
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Single pass over the constraint table
+      *
+      *     @param[in] value_of: Pointer to the value of an option index, NULL to skip it
+      *     @param[out] std::stringstream &violations: One line per violation
+      *     @return size_t: Number of violations
+      * 
+      *        Path constraints are collected during the pass and checked
+      *        together at the end (see find_path_violations()).
+      * 
+      */
+      size_t find_constraint_violations(const std::function<const void *(size_t)> &value_of, std::stringstream &violations) const
+      {
+         size_t count = 0;
+         std::vector<path_job> paths;
+
+         for(const compiled_constraint &c : this->constraint_table)
+         {
+            const void *dataVal = value_of(c.option_index);
+            if(NULL == dataVal)
+            {
+               continue;
+            }
+
+            std::string failure;
+            cline_utils::option_type type = this->opt_cfg.type(c.option_index);
+            if(cline_utils::option_constraint::constraint_path == c.kind)
+            {
+               if(type_string == type)
+               {
+                  paths.push_back({c.option_index, c.path_checks, ((const std::string *)dataVal)->c_str()});
+               }
+               else if(type_string_list == type)
+               {
+                  for(const std::string &value : *(const std::vector<std::string> *)dataVal)
+                  {
+                     paths.push_back({c.option_index, c.path_checks, value.c_str()});
+                  }
+               }
+               continue;
+            }
+
+            if(type_string == type)
+            {
+               const std::string &value = *(const std::string *)dataVal;
+               failure = this->check_string_constraint(c, value);
+            }
+            else if(type_string_list == type)
+            {
+               for(const std::string &value : *(const std::vector<std::string> *)dataVal)
+               {
+                  failure = this->check_string_constraint(c, value);
+                  if(false == failure.empty()) break;
+               }
+            }
+            else if(type_range == type)
+            {
+               // Linear and logarithmic ranges are monotonic, so the end points decide
+               const cline_utils::range &value = *(const cline_utils::range *)dataVal;
+               if(cline_utils::range::range_list == value.get_kind())
+               {
+                  for(size_t i = 0; i < value.size() && failure.empty(); ++i)
+                  {
+                     failure = this->check_numeric_constraint(c, value[i]);
+                  }
+               }
+               else if(0 < value.size())
+               {
+                  failure = this->check_numeric_constraint(c, value[0]);
+                  if(failure.empty() && cline_utils::option_constraint::constraint_bounds == c.kind)
+                  {
+                     failure = this->check_numeric_constraint(c, value[value.size() - 1]);
+                  }
+               }
+            }
+            else if(type_double_array == type)
+            {
+               for(double value : *(const std::vector<double> *)dataVal)
+               {
+                  failure = this->check_numeric_constraint(c, value);
+                  if(false == failure.empty()) break;
+               }
+            }
+            else if(type_double == type || type_float == type || type_int == type)
+            {
+               double value = (type_double == type) ? *(const double *)dataVal :
+                              (type_float == type) ? *(const float *)dataVal : *(const int *)dataVal;
+               failure = this->check_numeric_constraint(c, value);
+            }
+            else if(type_int64 == type || type_uint64 == type || type_duration == type)
+            {
+               // Bound variables and scalar_value both start with the 64 bit word
+               uint64_t bits;
+               memcpy(&bits, dataVal, sizeof(bits));
+               failure = this->check_numeric_constraint(c, (type_uint64 == type) ? double(bits) : double(int64_t(bits)));
+            }
+
+            if(false == failure.empty())
+            {
+               violations << "   --" << this->opt_cfg.name(c.option_index);
+               if(cline_utils::is_short_option_val(this->opt_cfg.val(c.option_index)))
+               {
+                  violations << " (-" << char(this->opt_cfg.val(c.option_index)) << ")";
+               }
+               violations << ": " << failure << std::endl;
+               ++count;
+            }
+         }
+
+         return(count + this->find_path_violations(paths, violations));
+      }
+
+      /************************************************************************/
+      /*
+      * \brief One path to check: the option it belongs to (npos for a
+      *        positional argument) and the path_check bits
+      *
+      */
+      struct path_job
+      {
+         size_t option_index;
+         unsigned checks;
+         const char *path;
+      };
+
+      /************************************************************************/
+      /*
+      * \brief Check many paths at once. Each check is a statx() plus, for the
+      *        permission bits, a faccessat() as the effective user; the calls
+      *        are blocking, so chunks of paths run in parallel on the shared
+      *        thread pool. Every failure is counted; the report lists the
+      *        first few per option and summarizes the rest.
+      *
+      *     @param[in] std::vector<path_job> &jobs: Paths to check
+      *     @param[out] std::stringstream &violations: Lines of the failures
+      *     @return size_t: Number of paths that failed
+      * 
+      */
+      size_t find_path_violations(const std::vector<path_job> &jobs, std::stringstream &violations) const
+      {
+         if(jobs.empty())
+         {
+            return(0);
+         }
+
+         const size_t chunk = 256;
+         std::vector<std::string> failures(jobs.size());
+         cline_utils::thread_pool::shared().parallel_for((jobs.size() + chunk - 1) / chunk, [&jobs, &failures, chunk](size_t block)
+            {
+               for(size_t i = block * chunk; i < std::min(jobs.size(), (block + 1) * chunk); ++i)
+               {
+                  failures[i] = check_path(jobs[i].path, jobs[i].checks);
+               }
+            });
+
+         const size_t listed_per_owner = 10;
+         std::map<size_t, size_t> failed_per_owner;
+         size_t count = 0;
+         for(size_t i = 0; i < jobs.size(); ++i)
+         {
+            if(failures[i].empty())
+            {
+               continue;
+            }
+            ++count;
+            if(listed_per_owner < ++failed_per_owner[jobs[i].option_index])
+            {
+               continue;
+            }
+            violations << "   " << this->describe_path_owner(jobs[i].option_index) << ": " << failures[i] << std::endl;
+         }
+         for(const auto &[owner, failed] : failed_per_owner)
+         {
+            if(listed_per_owner < failed)
+            {
+               violations << "   " << this->describe_path_owner(owner) << ": ... and " << failed - listed_per_owner << " more path(s)" << std::endl;
+            }
+         }
+         return(count);
+      }
+
+      std::string describe_path_owner(size_t option_index) const
+      {
+         if(std::string::npos == option_index)
+         {
+            return("positional argument");
+         }
+         std::string owner = std::string("--") + this->opt_cfg.name(option_index);
+         if(cline_utils::is_short_option_val(this->opt_cfg.val(option_index)))
+         {
+            owner += std::string(" (-") + char(this->opt_cfg.val(option_index)) + ")";
+         }
+         return(owner);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Check one path, thread safe
+      *
+      *     @return std::string: Empty if the path passes, the reason otherwise
+      * 
+      */
+      static std::string check_path(const char *path, unsigned checks)
+      {
+         typedef cline_utils::option_constraint oc;
+         struct statx info;
+         if(0 != statx(AT_FDCWD, path, AT_STATX_SYNC_AS_STAT, STATX_TYPE | STATX_MODE, &info))
+         {
+            return("'" + std::string(path) + "': " + std::generic_category().message(errno));
+         }
+         if((checks & oc::path_file) && false == S_ISREG(info.stx_mode))
+         {
+            return("'" + std::string(path) + "' is not a regular file");
+         }
+         if((checks & oc::path_directory) && false == S_ISDIR(info.stx_mode))
+         {
+            return("'" + std::string(path) + "' is not a directory");
+         }
+
+         const int mode = ((checks & oc::path_readable) ? R_OK : 0) | ((checks & oc::path_writable) ? W_OK : 0) |
+                          ((checks & oc::path_executable) ? X_OK : 0);
+         if(0 != mode && 0 != faccessat(AT_FDCWD, path, mode, AT_EACCESS))
+         {
+            const char *wanted = (R_OK == mode) ? "readable" : (W_OK == mode) ? "writable" : (X_OK == mode) ? "executable" : "accessible";
+            return("'" + std::string(path) + "' is not " + wanted + ": " + std::generic_category().message(errno));
+         }
+         return(std::string());
+      }
+
+      std::string check_numeric_constraint(const compiled_constraint &c, double value) const
+      {
+         std::stringstream ss("");
+         ss.precision(17);
+         switch(c.kind)
+         {
+            case cline_utils::option_constraint::constraint_bounds:
+               if(std::isnan(value) || value < c.lower || (c.lower_exclusive && value == c.lower))
+               {
+                  ss << "value " << value << " is below " << (c.lower_exclusive ? "or equal to " : "") << "minimum " << c.lower;
+               }
+               else if(value > c.upper)
+               {
+                  ss << "value " << value << " is above maximum " << c.upper;
+               }
+               break;
+
+            case cline_utils::option_constraint::constraint_allowed:
+            {
+               const double *first = this->allowed_values.data() + c.allowed_first;
+               if(std::find(first, first + c.allowed_count, value) == first + c.allowed_count)
+               {
+                  ss << "value " << value << " is not one of the allowed values";
+               }
+               break;
+            }
+         }
+         return(ss.str());
+      }
+
+      std::string check_string_constraint(const compiled_constraint &c, const std::string &value) const
+      {
+         std::stringstream ss("");
+         switch(c.kind)
+         {
+            case cline_utils::option_constraint::constraint_bounds:
+               if(value.size() < c.lower || (c.lower_exclusive && value.size() == c.lower) || value.size() > c.upper)
+               {
+                  ss << "length " << value.size() << " of '" << value << "' is out of bounds";
+               }
+               break;
+
+            case cline_utils::option_constraint::constraint_allowed:
+            {
+               const std::pmr::string *first = this->allowed_strings.data() + c.allowed_first;
+               if(std::find(first, first + c.allowed_count, std::string_view(value)) == first + c.allowed_count)
+               {
+                  ss << "'" << value << "' is not one of:";
+                  for(uint32_t i = 0; i < c.allowed_count; ++i)
+                  {
+                     ss << " " << first[i];
+                  }
+               }
+               break;
+            }
+
+            case cline_utils::option_constraint::constraint_chars:
+               for(size_t i = 0; i < value.size(); ++i)
+               {
+                  if(false == c.charset[(unsigned char)value[i]])
+                  {
+                     ss << "'" << value << "' contains invalid character '" << value[i] << "'";
+                     break;
+                  }
+               }
+               break;
+         }
+         return(ss.str());
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Index of the option with the given val, -1 if there is none
+      *
+      */
+      int find_option_index(int val) const
+      {
+         if(0 <= val && val < (int)this->short_to_index.size())
+         {
+            return(this->short_to_index[val]);
+         }
+         auto found = this->long_val_to_index.find(val);
+         return((found == this->long_val_to_index.end()) ? -1 : found->second);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Add a new option to the lookups of find_option_index(). The
+      *        first option with a val keeps it, as in option_table::find().
+      *
+      */
+      void index_option_val(size_t option_index)
+      {
+         const int val = this->opt_cfg.val(option_index);
+         if(0 <= val && val < (int)this->short_to_index.size())
+         {
+            if(0 > this->short_to_index[val])
+            {
+               this->short_to_index[val] = option_index;
+            }
+         }
+         else
+         {
+            this->long_val_to_index.emplace(val, option_index);
+         }
+      }
+
+      /************************************************************************/
+      /*
+      * \brief "--name (-c)" for messages
+      *
+      */
+      std::string describe_option(int val) const
+      {
+         int option_index = this->find_option_index(val);
+         std::string result = (0 <= option_index) ? std::string("--") + this->opt_cfg.name(option_index) : std::string("?");
+         if(cline_utils::is_short_option_val(val))
+         {
+            result += std::string(" (-") + char(val) + ")";
+         }
+         return(result);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Size the presence bitset and build the required and group masks
+      *        for the current option indices
+      *
+      */
+      void compile_option_bitsets()
+      {
+         const size_t options = this->opt_cfg.size();
+         const size_t words = (options + 63) / 64;
+
+         this->presence_bits.assign(words, 0);
+         this->required_bits.assign(words, 0);
+         for(size_t option_index = 0; option_index < options; ++option_index)
+         {
+            if(required_option == this->opt_cfg.is_mandatory_opt(option_index))
+            {
+               this->required_bits[option_index / 64] |= uint64_t(1) << (option_index % 64);
+            }
+         }
+
+         this->group_masks.assign(2 * words * this->option_groups.size(), 0);
+         for(size_t group_index = 0; group_index < this->option_groups.size(); ++group_index)
+         {
+            uint64_t *trigger = this->group_masks.data() + 2 * words * group_index;
+            uint64_t *members = trigger + words;
+            const option_group &group = this->option_groups[group_index];
+
+            if(group_requires == group.kind)
+            {
+               this->set_group_bit(trigger, group.trigger);
+            }
+            for(int member : group.members)
+            {
+               this->set_group_bit(members, member);
+            }
+         }
+      }
+
+      void set_group_bit(uint64_t *mask, int val)
+      {
+         int option_index = this->find_option_index(val);
+         if(0 > option_index)
+         {
+            std::stringstream ss("");
+            ss << "*************************************************************************" << std::endl;
+            ss << "compile_option_bitsets(...) - Option group refers to unknown option: " << val << std::endl;
+            ss << "*************************************************************************" << std::endl;
+            throw cline_utils::cline_exception(std::string(ss.str()));
+         }
+         mask[option_index / 64] |= uint64_t(1) << (option_index % 64);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief One line of a config file: an option value or an include
+      *
+      */
+      struct config_item
+      {
+         typedef std::pmr::polymorphic_allocator<char> allocator_type;
+
+         size_t option_index;
+         std::pmr::string value;
+         int include; /**< Index of the included file, -1 for a value */
+
+         config_item(size_t option_index_, std::string_view value_, int include_, const allocator_type &alloc)
+            : option_index(option_index_), value(value_, alloc), include(include_) {}
+         config_item(const config_item &other, const allocator_type &alloc)
+            : option_index(other.option_index), value(other.value, alloc), include(other.include) {}
+         config_item(config_item &&other, const allocator_type &alloc)
+            : option_index(other.option_index), value(std::move(other.value), alloc), include(other.include) {}
+         config_item(const config_item &other) = default;
+         config_item(config_item &&other) = default;
+         config_item &operator=(const config_item &other) = default;
+         config_item &operator=(config_item &&other) = default;
+      };
+
+      /** (option index, value text) pairs of the config files, later pairs override earlier ones */
+      typedef std::pmr::vector<std::pair<size_t, std::pmr::string>> config_entries;
+
+      /************************************************************************/
+      /*
+      * \brief Every config file in precedence order, lowest first
+      *
+      */
+      std::pmr::vector<std::pair<std::pmr::string, bool>> config_sources(std::pmr::memory_resource *resource) const
+      {
+         std::pmr::vector<std::pair<std::pmr::string, bool>> sources(this->config_layers.begin(), this->config_layers.end(), resource);
+         if(false == this->config_filename.empty())
+         {
+            sources.emplace_back(this->config_filename, false);
+         }
+         return(sources);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Issue the reads of every config layer without waiting for them
+      *
+      *     @param[in] std::pmr::memory_resource *resource: Backs the batch; used on the calling thread only
+      *     @return file_batch_ptr: Reads in flight, NULL without config files
+      *
+      */
+      cline_utils::file_batch_ptr start_config_load(std::pmr::memory_resource *resource) const
+      {
+         std::pmr::vector<std::pair<std::pmr::string, bool>> sources = this->config_sources(resource);
+         if(sources.empty())
+         {
+            return(NULL);
+         }
+
+         std::pmr::vector<std::pmr::string> paths(resource);
+         for(const auto &source : sources) paths.push_back(source.first);
+         return(cline_utils::make_file_batch(paths, this->io_uring_enabled, resource));
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Wait for the layers started by start_config_load(), load their
+      *        includes (one concurrent batch per nesting level) and flatten
+      *        everything into (option index, value text) pairs. Later pairs
+      *        override earlier ones.
+      *
+      */
+      config_entries finish_config_load(cline_utils::file_batch_ptr batch, std::pmr::memory_resource *resource,
+                                        std::pmr::vector<std::pmr::string> *read_paths = NULL)
+      {
+         config_entries result(resource);
+         std::pmr::vector<std::pair<std::pmr::string, bool>> sources = this->config_sources(resource);
+         if(NULL == batch)
+         {
+            return(result);
+         }
+
+         std::pmr::vector<std::pmr::string> paths(resource);               // Every file, layers first
+         std::pmr::vector<std::pmr::vector<config_item>> items(resource);  // Parsed lines per file
+         std::pmr::map<std::pmr::string, int> file_index(resource);
+         for(const auto &source : sources)
+         {
+            file_index.emplace(source.first, paths.size());
+            paths.push_back(source.first);
+         }
+
+         size_t wave_first = 0;
+         for(int depth = 0; NULL != batch; ++depth)
+         {
+            std::pmr::vector<cline_utils::loaded_file> &files = batch->wait();
+            this->config_backend = batch->backend();
+            items.resize(paths.size());
+
+            std::pmr::vector<std::pmr::string> next_wave(resource);
+            for(size_t i = 0; i < files.size(); ++i)
+            {
+               const size_t file = wave_first + i;
+               if(0 != files[i].error)
+               {
+                  if(file < sources.size() && sources[file].second && ENOENT == files[i].error)
+                  {
+                     continue; // Optional layer that does not exist
+                  }
+                  throw_config_error(std::string(files[i].path), 0, std::string("Unable to open config file (") + strerror(files[i].error) + ")");
+               }
+
+               for(const std::pmr::string &include : this->parse_config_text(files[i].path, files[i].data, items[file]))
+               {
+                  if(file_index.emplace(include, paths.size() + next_wave.size()).second)
+                  {
+                     next_wave.push_back(include);
+                  }
+               }
+               // Includes were recorded by path; turn them into file indices
+               for(config_item &item : items[file])
+               {
+                  if(0 <= item.include) continue;
+                  if(std::string::npos == item.option_index)
+                  {
+                     item.include = file_index[item.value];
+                  }
+               }
+            }
+
+            batch.reset();
+            if(false == next_wave.empty())
+            {
+               if(8 <= depth)
+               {
+                  throw_config_error(std::string(next_wave[0]), 0, "Config includes nested too deeply");
+               }
+               wave_first = paths.size();
+               paths.insert(paths.end(), next_wave.begin(), next_wave.end());
+               batch = cline_utils::make_file_batch(next_wave, this->io_uring_enabled, resource);
+            }
+         }
+
+         std::pmr::vector<int> stack(resource);
+         for(size_t layer = 0; layer < sources.size(); ++layer)
+         {
+            this->flatten_config(layer, items, paths, stack, result);
+         }
+         if(NULL != read_paths)
+         {
+            read_paths->insert(read_paths->end(), paths.begin(), paths.end());
+         }
+         return(result);
+      }
+
+      void flatten_config(size_t file, const std::pmr::vector<std::pmr::vector<config_item>> &items, const std::pmr::vector<std::pmr::string> &paths,
+                          std::pmr::vector<int> &stack, config_entries &result) const
+      {
+         if(std::find(stack.begin(), stack.end(), int(file)) != stack.end())
+         {
+            throw_config_error(std::string(paths[file]), 0, "Config include cycle");
+         }
+         stack.push_back(file);
+         for(const config_item &item : items[file])
+         {
+            if(0 <= item.include)
+            {
+               this->flatten_config(item.include, items, paths, stack, result);
+            }
+            else
+            {
+               result.emplace_back(item.option_index, item.value);
+            }
+         }
+         stack.pop_back();
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Parse the text of one config file. Include lines are stored with
+      *        option_index npos and the resolved path as value. Everything is
+      *        allocated from the memory resource of items.
+      *
+      *     @param[in] std::pmr::string filename: File name for errors and relative includes
+      *     @param[in] std::string_view text: Contents
+      *     @param[out] std::pmr::vector<config_item> &items: Lines in file order
+      *     @return std::pmr::vector<std::pmr::string>: Paths of the included files
+      *
+      */
+      std::pmr::vector<std::pmr::string> parse_config_text(const std::pmr::string &filename, std::string_view text,
+                                                          std::pmr::vector<config_item> &items) const
+      {
+         std::pmr::memory_resource *resource = items.get_allocator().resource();
+         std::pmr::vector<std::pmr::string> includes(resource);
+         int line_number = 0;
+         for(size_t line_first = 0; line_first < text.size();)
+         {
+            size_t line_end = text.find('\n', line_first);
+            if(std::string_view::npos == line_end) line_end = text.size();
+            const std::string_view line = text.substr(line_first, line_end - line_first);
+            line_first = line_end + 1;
+
+            ++line_number;
+            size_t first = line.find_first_not_of(" \t\r");
+            if(std::string_view::npos == first || '#' == line[first])
+            {
+               continue;
+            }
+
+            if(0 == line.compare(first, 8, "@include"))
+            {
+               size_t path_first = line.find_first_not_of(" \t", first + 8);
+               size_t path_last = line.find_last_not_of(" \t\r");
+               std::string_view name = (std::string_view::npos == path_first) ? std::string_view() : line.substr(path_first, path_last - path_first + 1);
+               if(2 <= name.size() && '"' == name.front() && '"' == name.back())
+               {
+                  name = name.substr(1, name.size() - 2);
+               }
+               if(name.empty())
+               {
+                  throw_config_error(std::string(filename), line_number, "@include without a file name");
+               }
+               std::pmr::string path(resource);
+               size_t slash = filename.rfind('/');
+               if('/' != name[0] && std::string::npos != slash)
+               {
+                  path.assign(filename, 0, slash + 1);
+               }
+               path.append(name);
+               items.emplace_back(std::string::npos, path, -1);
+               includes.push_back(std::move(path));
+               continue;
+            }
+
+            size_t equals = line.find('=', first);
+            size_t name_last = line.find_last_not_of(" \t\r", (std::string_view::npos == equals) ? std::string_view::npos : equals - 1);
+            std::string_view name = (std::string_view::npos == name_last || name_last < first) ? std::string_view() : line.substr(first, name_last - first + 1);
+            std::string_view value;
+            if(std::string_view::npos != equals)
+            {
+               size_t value_first = line.find_first_not_of(" \t", equals + 1);
+               size_t value_last = line.find_last_not_of(" \t\r");
+               if(std::string_view::npos != value_first && value_last >= value_first)
+               {
+                  value = line.substr(value_first, value_last - value_first + 1);
+               }
+               if(2 <= value.size() && '"' == value.front() && '"' == value.back())
+               {
+                  value = value.substr(1, value.size() - 2);
+               }
+            }
+
+            int option_index = this->find_option_by_name(name);
+            if(0 > option_index)
+            {
+               throw_config_error(std::string(filename), line_number, "Unknown option '" + std::string(name) + "'");
+            }
+            items.emplace_back((size_t)option_index, value, -1);
+         }
+
+         return(includes);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Fill options missing from the command line with config file values
+      *
+      */
+      void merge_config_file()
+      {
+         config_entries entries = this->finish_config_load(std::move(this->pending_config), this->resource, &this->config_cache_inputs);
+         for(size_t i = 0; i < entries.size(); ++i)
+         {
+            const size_t option_index = entries[i].first;
+            const int val = this->opt_cfg.val(option_index);
+            if(source_command_line == this->get_option_source(val))
+            {
+               continue;
+            }
+
+            // Later lines override earlier ones
+            this->optarg_map[val] = entries[i].second;
+            this->opt_source_map[val] = source_config_file;
+            this->presence_bits[option_index / 64] |= uint64_t(1) << (option_index % 64);
+         }
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Index of the option with the given long name, -1 if there is none
+      *
+      */
+      int find_option_by_name(std::string_view name) const
+      {
+         return(this->opt_cfg.find_name(name));
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Remember the bound values before the parser first writes them
+      *
+      */
+      void capture_default_values()
+      {
+         if(this->default_values.size() == this->opt_cfg.size())
+         {
+            return;
+         }
+
+         this->default_values.clear();
+         for(size_t option_index = 0; option_index < this->opt_cfg.size(); ++option_index)
+         {
+            this->default_values.push_back(this->read_bound_value(option_index));
+         }
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Typed copy of a bound variable
+      *
+      */
+      cline_utils::option_value read_bound_value(size_t option_index) const
+      {
+         const void *dataVal = this->opt_cfg.data(option_index);
+         switch(this->opt_cfg.type(option_index))
+         {
+            case type_string: return(*(const std::string *)dataVal);
+            case type_double: return(*(const double *)dataVal);
+            case type_int:    return(*(const int *)dataVal);
+            case type_float:  return(*(const float *)dataVal);
+            case type_range:  return(*(const cline_utils::range *)dataVal);
+            case type_shard:  return(*(const cline_utils::shard_spec *)dataVal);
+            case type_string_list: return(*(const std::vector<std::string> *)dataVal);
+            case type_double_array: return(*(const std::vector<double> *)dataVal);
+            default:
+            {
+               const cline_utils::option_type type = this->opt_cfg.type(option_index);
+               const cline_utils::scalar_type_ops *ops = cline_utils::scalar_type_ops::get(type);
+               if(NULL == ops) return(std::monostate());
+               const void *ctx = this->opt_cfg.context(option_index);
+               return(cline_utils::scalar_value{ops->load(dataVal, ctx), type, ctx});
+            }
+         }
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Validate the options changed by reparse_command_line() before they
+      *        are written: their own constraints against the new values, then
+      *        the cross constraints against the bound variables with the new
+      *        values swapped in (and back out)
+      *
+      *     @param[in] std::vector<size_t> &changed: Option indices
+      *     @param[in,out] std::pmr::vector<option_value> &updated: New value per changed option
+      *     @return None.
+      * 
+      */
+      void check_changed_constraints(const std::vector<size_t> &changed, std::pmr::vector<cline_utils::option_value> &updated)
+      {
+         if(changed.empty())
+         {
+            return;
+         }
+
+         std::stringstream violations("");
+         size_t count = this->find_constraint_violations(
+            [&](size_t option_index) -> const void *
+            {
+               auto itr = std::lower_bound(changed.begin(), changed.end(), option_index);
+               if(itr == changed.end() || *itr != option_index ||
+                  source_default == this->get_option_source(this->opt_cfg.val(option_index)))
+               {
+                  return(NULL);
+               }
+               return(value_pointer(updated[itr - changed.begin()]));
+            }, violations);
+
+         if(false == this->cross_constraints.empty())
+         {
+            std::pmr::vector<cline_utils::option_value> kept(this->resource);
+            for(size_t i = 0; i < changed.size(); ++i)
+            {
+               kept.push_back(this->read_bound_value(changed[i]));
+               this->write_bound_value(changed[i], updated[i]);
+            }
+            for(size_t i = 0; i < this->cross_constraints.size(); ++i)
+            {
+               if(false == this->cross_constraints[i].first())
+               {
+                  violations << "   " << this->cross_constraints[i].second << std::endl;
+                  ++count;
+               }
+            }
+            for(size_t i = 0; i < changed.size(); ++i)
+            {
+               this->write_bound_value(changed[i], kept[i]);
+            }
+         }
+
+         if(0 < count)
+         {
+            std::stringstream ss("");
+            ss << "*************************************************************************" << std::endl;
+            ss << "check_constraints(...) - " << count << " constraint violation(s):" << std::endl;
+            ss << violations.str();
+            ss << "*************************************************************************" << std::endl;
+            throw cline_utils::cline_exception(std::string(ss.str()));
+         }
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Store an option_value of the option's type into its bound variable
+      *
+      */
+      void write_bound_value(size_t option_index, const cline_utils::option_value &value)
+      {
+         void *dataVal = this->opt_cfg.data(option_index);
+         switch(this->opt_cfg.type(option_index))
+         {
+            case type_string: *(std::string *)dataVal = std::get<std::string>(value); break;
+            case type_double: *(double *)dataVal = std::get<double>(value); break;
+            case type_int:    *(int *)dataVal = std::get<int>(value); break;
+            case type_float:  *(float *)dataVal = std::get<float>(value); break;
+            case type_range:  *(cline_utils::range *)dataVal = std::get<cline_utils::range>(value); break;
+            case type_shard:  *(cline_utils::shard_spec *)dataVal = std::get<cline_utils::shard_spec>(value); break;
+            case type_string_list: *(std::vector<std::string> *)dataVal = std::get<std::vector<std::string>>(value); break;
+            case type_double_array: *(std::vector<double> *)dataVal = std::get<std::vector<double>>(value); break;
+            default:
+            {
+               const cline_utils::scalar_type_ops *ops = cline_utils::scalar_type_ops::get(this->opt_cfg.type(option_index));
+               if(NULL != ops)
+               {
+                  ops->store(dataVal, std::get<cline_utils::scalar_value>(value).bits, this->opt_cfg.context(option_index));
+               }
+               break;
+            }
+         }
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Address of the value held by an option_value, NULL if empty
+      *
+      */
+      static void *value_pointer(cline_utils::option_value &value)
+      {
+         return(std::visit([](auto &held) -> void *
+            {
+               if constexpr (std::is_same_v<std::decay_t<decltype(held)>, std::monostate>) return(NULL);
+               else return(&held);
+            }, value));
+      }
+
+      static const void *value_pointer(const cline_utils::option_value &value)
+      {
+         return(value_pointer(const_cast<cline_utils::option_value &>(value)));
+      }
+
+      snapshot_state &get_snapshot_state()
+      {
+         if(NULL == this->snapshots)
+         {
+            this->snapshots.reset(new snapshot_state());
+         }
+         return(*this->snapshots);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Empty snapshot sized for the current options. The long name index
+      *        is built once and shared by every snapshot.
+      *
+      */
+      cline_utils::config_snapshot *new_snapshot(snapshot_state &state)
+      {
+         const size_t options = this->opt_cfg.size();
+         if(NULL == state.name_index || state.name_index->size() != options)
+         {
+            auto index = std::make_shared<std::unordered_map<std::string, size_t>>();
+            for(size_t option_index = 0; option_index < options; ++option_index)
+            {
+               (*index)[this->opt_cfg.name(option_index)] = option_index;
+            }
+            state.name_index = index;
+         }
+
+         cline_utils::config_snapshot *snapshot = new cline_utils::config_snapshot();
+         snapshot->version = ++state.version;
+         snapshot->values.resize(options);
+         snapshot->sources.resize(options, source_default);
+         snapshot->name_index = state.name_index;
+         return(snapshot);
+      }
+
+      static void throw_config_error(const std::string &filename, int line_number, const std::string &what)
+      {
+         std::stringstream ss("");
+         ss << "*************************************************************************" << std::endl;
+         ss << "load_config(...) - " << filename << ":" << line_number << ": " << what << std::endl;
+         ss << "*************************************************************************" << std::endl;
+         throw cline_utils::cline_exception(std::string(ss.str()));
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Watch the directories of config files for writes and renames
+      *
+      *     @param[in] int inotify_fd: inotify instance
+      *     @param[in] std::vector<std::string> &paths: Config files
+      *     @param[in,out] std::map<int, std::set<std::string>> &watched: File names per watch descriptor
+      *     @return std::string: First directory that could not be watched, empty if all were
+      * 
+      */
+      static std::string add_config_watches(int inotify_fd, const std::vector<std::string> &paths,
+                                            std::map<int, std::set<std::string>> &watched)
+      {
+         std::string failed;
+         for(const std::string &path : paths)
+         {
+            size_t slash = path.rfind('/');
+            std::string directory = (std::string::npos == slash) ? "." : path.substr(0, slash + 1);
+            int wd = inotify_add_watch(inotify_fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+            if(0 > wd)
+            {
+               if(failed.empty()) failed = directory;
+               continue;
+            }
+            watched[wd].insert((std::string::npos == slash) ? path : path.substr(slash + 1));
+         }
+         return(failed);
+      }
+
+      static void throw_watch_error(const std::string &what)
+      {
+         std::stringstream ss("");
+         ss << "*************************************************************************" << std::endl;
+         ss << "watch_config_file(...) - " << what << std::endl;
+         ss << "*************************************************************************" << std::endl;
+         throw cline_utils::cline_exception(std::string(ss.str()));
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Take the --name or --name=value token at optind with one walk of
+      *        the name trie instead of getopt_long's scan of every long name.
+      *        Only exact names are taken; abbreviations and malformed tokens
+      *        are left to getopt_long, which reports them as before. Tokens
+      *        are only taken between getopt_long calls (never inside a short
+      *        option cluster) and after its first call has initialized it.
+      *
+      *     @param[out] int &option_index: Index of the matched option
+      *     @return bool: True if the token and its argument were consumed (optind and optarg updated)
+      * 
+      */
+      bool match_long_option(int &option_index)
+      {
+         if(0 >= optind || optind >= this->argc_)
+         {
+            return(false);
+         }
+         const char *token = this->argv_[optind];
+         if('-' != token[0] || '-' != token[1] || '\0' == token[2])
+         {
+            return(false);
+         }
+
+         const std::string_view body(token + 2);
+         const size_t equals = body.find('=');
+         const int found = this->opt_cfg.find_name(body.substr(0, equals));
+         if(0 > found)
+         {
+            return(false);
+         }
+
+         const char *argument = NULL;
+         int consumed = 1;
+         if(std::string_view::npos != equals)
+         {
+            if(no_argument == this->opt_cfg.has_arg(found))
+            {
+               return(false);
+            }
+            argument = token + 2 + equals + 1;
+         }
+         else if(required_argument == this->opt_cfg.has_arg(found))
+         {
+            if(optind + 1 >= this->argc_)
+            {
+               return(false);
+            }
+            argument = this->argv_[optind + 1];
+            consumed = 2;
+         }
+
+         optind += consumed;
+         optarg = (char *)argument;
+         option_index = found;
+         return(true);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Record argv[argv_index] as a positional argument
+      *
+      */
+      void add_positional_argument(int argv_index)
+      {
+         if(this->positional_args.size() >= this->positional_max)
+         {
+            std::stringstream ss("");
+            ss << "*************************************************************************" << std::endl;
+            ss << "parse_options_arguments(...) - Arguments with no corresponding option: " << this->argv_[argv_index] << std::endl;
+            ss << "*************************************************************************" << std::endl;
+            throw cline_utils::cline_exception(std::string(ss.str()));
+         }
+         this->positional_args.append(this->argv_, argv_index);
+      }
+
+      /************************************************************************/
+      /*
+      * \brief Tokenizer state of one streaming parse
+      *
+      */
+      struct stream_state
+      {
+         const cline_utils::event_callback *callback = NULL;
+         int pending_option = -1;        /**< Option still waiting for its argument */
+         bool options_done = false;      /**< "--" was seen */
+         bool stopped = false;           /**< Callback asked to stop */
+         int depth = 0;                  /**< Nesting of response files */
+         uint64_t options = 0;
+         uint64_t positionals = 0;
+         std::string scratch;            /**< Argument text handed to convert_argument */
+         cline_utils::option_value value;
+      };
+
+      static constexpr int max_response_depth = 8;
+
+      /************************************************************************/
+      /*
+      * \brief Feed one token to the streaming tokenizer
+      *
+      */
+      void push_token(stream_state &state, std::string_view token, bool allow_response_file)
+      {
+         if(0 <= state.pending_option)
+         {
+            int option_index = state.pending_option;
+            state.pending_option = -1;
+            this->emit_option(state, option_index, token);
+            return;
+         }
+
+         // After "--" even "@name" is a positional argument
+         if(state.options_done)
+         {
+            this->emit_positional(state, token);
+            return;
+         }
+
+         if(allow_response_file && 1 < token.size() && '@' == token[0])
+         {
+            this->stream_response_file(state, std::string(token.substr(1)));
+            return;
+         }
+
+         if(token.size() < 2 || '-' != token[0])
+         {
+            this->emit_positional(state, token);
+            return;
+         }
+
+         if("--" == token)
+         {
+            state.options_done = true;
+            return;
+         }
+
+         if('-' == token[1])
+         {
+            // --name or --name=value
+            std::string_view body = token.substr(2);
+            size_t equals = body.find('=');
+            std::string_view name = body.substr(0, equals);
+
+            int option_index = this->find_option_by_name(name);
+            if(0 > option_index)
+            {
+               throw_stream_error("Unrecognized option: " + std::string(token));
+            }
+
+            const int has_arg = this->opt_cfg.has_arg(option_index);
+            if(std::string_view::npos != equals)
+            {
+               if(no_argument == has_arg)
+               {
+                  throw_stream_error("Option does not take an argument: " + std::string(token));
+               }
+               this->emit_option(state, option_index, body.substr(equals + 1));
+            }
+            else if(required_argument == has_arg)
+            {
+               state.pending_option = option_index;
+            }
+            else
+            {
+               this->emit_option(state, option_index, std::string_view());
+            }
+            return;
+         }
+
+         // -a value, -avalue or a bundle of flags -xyz
+         for(size_t pos = 1; pos < token.size() && false == state.stopped; ++pos)
+         {
+            int option_index = this->short_to_index[(unsigned char)token[pos]];
+            if(0 > option_index)
+            {
+               throw_stream_error(std::string("Unrecognized option: -") + token[pos]);
+            }
+
+            if(no_argument == this->opt_cfg.has_arg(option_index))
+            {
+               this->emit_option(state, option_index, std::string_view());
+               continue;
+            }
+
+            if(pos + 1 < token.size())
+            {
+               this->emit_option(state, option_index, token.substr(pos + 1));
             }
+            else if(required_argument == this->opt_cfg.has_arg(option_index))
+            {
+               state.pending_option = option_index;
+            }
+            else
+            {
+               this->emit_option(state, option_index, std::string_view());
+            }
+            return;
          }
-
-         this->fmt_string = result;
       }
 
       /************************************************************************/
       /*
-      * \brief Unpack command line data into internal class members
+      * \brief Tokenize a response file one character at a time
       *
-      *     @return None
-      * 
       */
-      void parse_options_arguments()
+      void stream_response_file(stream_state &state, const std::string &filename)
       {
-         int opt = 0;
-
-         std::stringstream ss("");
+         if(max_response_depth <= state.depth)
+         {
+            throw_stream_error("Response files nested too deeply: " + filename);
+         }
 
-         std::vector<option> longer_options = option_longer::pack_into_option_array(this->opt_cfg);
+         std::ifstream in(filename, std::ios::binary);
+         if(!in)
+         {
+            throw_stream_error("Unable to open response file: " + filename);
+         }
 
-         while(true)
+         ++state.depth;
+         std::string token;
+         bool in_token = false;
+         bool quoted = false;
+         std::streambuf *buffer = in.rdbuf();
+         for(int ch = buffer->sbumpc(); false == state.stopped; ch = buffer->sbumpc())
          {
-            int option_index = 0;
-            opt = getopt_long(this->argc_, this->argv_, this->fmt_string.c_str(), longer_options.data(), &option_index);
-            if(-1 == opt)
+            const bool at_end = (std::char_traits<char>::eof() == ch);
+            if(false == at_end && '"' == ch)
             {
-               break;
+               quoted = !quoted;
+               in_token = true;
+            }
+            else if(false == at_end && (quoted || 0 == isspace(ch)))
+            {
+               token += char(ch);
+               in_token = true;
+            }
+            else if(in_token)
+            {
+               this->push_token(state, token, true);
+               token.clear();
+               in_token = false;
             }
 
-            switch (opt) //Recall that character constants (which have a type int) comparisons to opt (which is also an int)
-            {  
-               case 'h': //Help option
-                  ss << "*************************************************************************" << std::endl;
-                  ss << "parse_options_arguments(...) - Help Option Selected: " << char(optopt) << std::endl;
-                  ss << "*************************************************************************" << std::endl;
-                  throw cline_utils::cline_exception(std::string(ss.str()));
-                  break;
+            if(at_end)
+            {
+               break;
+            }
+         }
+         --state.depth;
+      }
 
-               case '?': //Unrecognized command line option
-                  ss << "*************************************************************************" << std::endl;
-                  ss << "parse_options_arguments(...) - Unrecognized option: " << optopt << " " << char(opt) << std::endl;
-                  ss << "*************************************************************************" << std::endl;
-                  throw cline_utils::cline_exception(std::string(ss.str()));
-                  break;
-                 
-               case ':': //Missing argument for option
-                  ss << "*************************************************************************" << std::endl;
-                  ss << "parse_options_arguments(...) - Missing argument for option: " << char(optopt) << std::endl;
-                  ss << "*************************************************************************" << std::endl;
-                  throw cline_utils::cline_exception(std::string(ss.str()));
-                  break;
+      void emit_option(stream_state &state, int option_index, std::string_view text)
+      {
+         // Typed scratch value of the option's type, reused between events
+         state.value = this->read_bound_value(option_index);
+         state.scratch.assign(text.data(), text.size());
+         if(false == this->convert_into_value(option_index, state.scratch, state.value))
+         {
+            throw_stream_error("Unable to match option type string: --" + std::string(this->opt_cfg.name(option_index)));
+         }
+         this->presence_bits[option_index / 64] |= uint64_t(1) << (option_index % 64);
 
-               case 1:
-                  ss << "*************************************************************************" << std::endl;
-                  ss << "parse_options_arguments(...) - Arguments with no corresponding option: " << optarg << std::endl;
-                  ss << "*************************************************************************" << std::endl;
-                  throw cline_utils::cline_exception(std::string(ss.str()));
-                  break;
+         cline_utils::parse_event event = {cline_utils::parse_event::event_option, option_index, this->opt_cfg.val(option_index),
+                                           this->opt_cfg.name(option_index), text, state.options++, &state.value};
+         state.stopped = (false == (*state.callback)(event));
+      }
 
-               default:
-                  // If the size stays the same, then insert failed and we know its likely a duplicate key input on
-                  // the command line.
-                  size_t sizeBefore = this->optarg_map.size();
-                  this->optarg_map.insert({opt,optarg});
-                  if(this->optarg_map.size() == sizeBefore)
-                  {
-                     ss << "*************************************************************************" << std::endl;
-                     ss << "parse_options_arguments(...) - Duplicate option struct.val input found: " << char(opt) << std::endl;
-                     ss << "*************************************************************************" << std::endl;
-                     throw cline_utils::cline_exception(std::string(ss.str()));
-                  }
-                  break;
-           }
+      void emit_positional(stream_state &state, std::string_view text)
+      {
+         if(state.positionals >= this->positional_max)
+         {
+            throw_stream_error("Arguments with no corresponding option: " + std::string(text));
          }
 
-         this->check_required_options();
+         cline_utils::parse_event event = {cline_utils::parse_event::event_positional, -1, 0, NULL, text, state.positionals++, NULL};
+         state.stopped = (false == (*state.callback)(event));
+      }
+
+      static void throw_stream_error(const std::string &what)
+      {
+         std::stringstream ss("");
+         ss << "*************************************************************************" << std::endl;
+         ss << "stream_command_line(...) - " << what << std::endl;
+         ss << "*************************************************************************" << std::endl;
+         throw cline_utils::cline_exception(std::string(ss.str()));
+      }
+
+      static void throw_shared_config_error(const std::string &what)
+      {
+         std::stringstream ss("");
+         ss << "*************************************************************************" << std::endl;
+         ss << "publish_shared_config(...) - " << what << std::endl;
+         ss << "*************************************************************************" << std::endl;
+         throw cline_utils::cline_exception(std::string(ss.str()));
       }
 
       /************************************************************************/
       /*
-      * \brief Parse the command line and store the data
+      * \brief Identity of a config file as seen by the cache
       *
-      *     @return None.
-      * 
       */
-      void parse_command_line()
+      struct file_fingerprint
       {
-         bool found_option_type = 0;
-         
-         // Create the format string from the option_longer struct
-         this->check_duplicate_option_config_names();
+         uint8_t  present = 0;
+         uint64_t device = 0;
+         uint64_t inode = 0;
+         uint64_t size = 0;
+         int64_t  mtime_sec = 0;
+         int64_t  mtime_nsec = 0;
 
-         // Create the required/optional options and required/not argument strings
-         this->create_option_format_string();
-
-         this->parse_options_arguments();
-
-         for (auto const & [key, val] : this->optarg_map)
+         explicit file_fingerprint(const char *path)
          {
-            // Loop through current option type strings to find the option currently being parsed by getopt
-            found_option_type = false;
-            // Exclude the last element from for loop iteration since getopt_long requires
-            // last member of option structs array be all zeroes
-            for(size_t option_index = 0; option_index < this->opt_cfg.size() - 1; ++option_index)
-            {
-               if(this->opt_cfg[option_index].val == key)
-               {
-                  std::string optTypeString = this->opt_cfg[option_index].type_string;
-                  std::string optArgString = val;
-
-                  if(std::string(typeid(char *).name()) == optTypeString) // It's a string
-                  {
-                     *(std::string *)this->opt_cfg[option_index].dataVal = optArgString;
-                     found_option_type = true;
-                     //std::cout << "char * " << this->opt_cfg[option_index].val << " " << optArgString << " " << *(std::string *)this->opt_cfg[option_index].dataVal << " " << optTypeString << " " << option_index << std::endl;
-                  }
-                  else if(std::string(typeid(double).name()) == optTypeString) // It's a double
-                  {
-                     char *endPtr;
-                     double test = strtod(optArgString.c_str(), &endPtr);
-                     *(double *)this->opt_cfg[option_index].dataVal = (endPtr != optArgString) ? test : std::nan("1");
-                     found_option_type = true;
-                     //std::cout << "double " << this->opt_cfg[option_index].val << " " << optArgString << " " << *(double *)this->opt_cfg[option_index].dataVal << " " << optTypeString << " " << option_index << std::endl;
-                  }
-                  else if(std::string(typeid(int).name()) == optTypeString) // It's an int
-                  {
-                     char *endPtr;
-                     int test = std::strtol(optArgString.c_str(), &endPtr, 0);
-                     *(int *)this->opt_cfg[option_index].dataVal = (endPtr != optArgString) ? test : INT_MIN;
-                     found_option_type = true;
-                     //std::cout << "int " << this->opt_cfg[option_index].val << " " << optArgString << " " << *(int *)this->opt_cfg[option_index].dataVal << " " << optTypeString << " " << option_index << std::endl;
-                  }
-               }
-               // If option has been found and handled, move on.
-               if(true == found_option_type) break;
-            }
-               
-            if(false == found_option_type)
+            struct stat info;
+            if(0 == stat(path, &info))
             {
-               std::stringstream ss("");
-               ss << "*************************************************************************" << std::endl;
-               ss << "parse_command_line(...) - Unable to match option type string: " << char(key) << std::endl;
-               ss << "*************************************************************************" << std::endl;
-               throw cline_utils::cline_exception(std::string(ss.str()));
-               break;
+               this->present = 1;
+               this->device = info.st_dev;
+               this->inode = info.st_ino;
+               this->size = info.st_size;
+               this->mtime_sec = info.st_mtim.tv_sec;
+               this->mtime_nsec = info.st_mtim.tv_nsec;
             }
          }
+
+         file_fingerprint() = default;
+      };
+
+      bool config_cache_enabled() const
+      {
+         return(false == this->config_cache_path.empty() && this->glob_options.empty());
+      }
+
+      static uint64_t fnv1a_64(uint64_t hash, const void *data, size_t size)
+      {
+         const unsigned char *bytes = (const unsigned char *)data;
+         for(size_t i = 0; i < size; ++i)
+         {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+         }
+         return(hash);
+      }
+
+      static uint64_t fnv1a_64(uint64_t hash, std::string_view text)
+      {
+         const uint64_t length = text.size();
+         hash = fnv1a_64(hash, &length, sizeof(length));
+         return(fnv1a_64(hash, text.data(), text.size()));
       }
 
       /************************************************************************/
       /*
-      * \brief Terrible hack function to print option data type. Can't use more
-      *        elegant methods because internally this class only sees void data.
+      * \brief Hash of everything a parse depends on except the config files:
+      *        argv, the cache environment, the config file names, the option
+      *        table and groups, and the bound values before the parse
       *
-      *     @return None.
+      *     @param[in] std::vector<char> &initial_state: serialize_snapshot() before the parse
+      *     @return uint64_t: Cache key
       * 
       */
-      std::string get_type_string(const std::string type_name)
-      {  
-         std::string result("None ");
-         
-         if("Pc" == type_name)
+      uint64_t config_cache_key(const std::vector<char> &initial_state) const
+      {
+         uint64_t hash = fnv1a_64(14695981039346656037ull, config_cache_magic, sizeof(config_cache_magic));
+         hash = fnv1a_64(hash, &config_cache_version, sizeof(config_cache_version));
+
+         hash = fnv1a_64(hash, &this->argc_, sizeof(this->argc_));
+         for(int argv_index = 0; argv_index < this->argc_; ++argv_index)
          {
-            result = "char * ";
+            hash = fnv1a_64(hash, std::string(this->argv_[argv_index]));
          }
-         else if("d" == type_name)
+
+         for(const std::pmr::string &name : this->config_cache_env)
          {
-            result = "double ";
+            const char *value = getenv(name.c_str());
+            const uint8_t set = (NULL != value);
+            hash = fnv1a_64(hash, name);
+            hash = fnv1a_64(hash, &set, sizeof(set));
+            if(set) hash = fnv1a_64(hash, std::string_view(value));
          }
-         else if("f" == type_name)
+
+         for(const auto &source : this->config_sources(this->resource))
          {
-            result = "float ";
+            hash = fnv1a_64(hash, source.first);
+            hash = fnv1a_64(hash, &source.second, sizeof(source.second));
          }
-         else if("i" == type_name)
+
+         for(size_t option_index = 0; option_index < this->opt_cfg.size(); ++option_index)
          {
-            result = "int ";
+            const int fields[3] = {this->opt_cfg.val(option_index), this->opt_cfg.has_arg(option_index),
+                                   this->opt_cfg.is_mandatory_opt(option_index)};
+            hash = fnv1a_64(hash, fields, sizeof(fields));
+         }
+         for(const option_group &group : this->option_groups)
+         {
+            const int fields[3] = {int(group.kind), group.trigger, int(group.members.size())};
+            hash = fnv1a_64(hash, fields, sizeof(fields));
+            hash = fnv1a_64(hash, group.members.data(), group.members.size() * sizeof(int));
          }
+         const uint64_t limits[2] = {this->positional_min, this->positional_max};
+         hash = fnv1a_64(hash, limits, sizeof(limits));
 
-         return(result);
+         return(fnv1a_64(hash, initial_state.data(), initial_state.size()));
+      }
+
+      static void append_fingerprint(std::vector<char> &record, const file_fingerprint &file)
+      {
+         append_bytes(record, &file.present, sizeof(file.present));
+         append_bytes(record, &file.device, sizeof(file.device));
+         append_bytes(record, &file.inode, sizeof(file.inode));
+         append_bytes(record, &file.size, sizeof(file.size));
+         append_bytes(record, &file.mtime_sec, sizeof(file.mtime_sec));
+         append_bytes(record, &file.mtime_nsec, sizeof(file.mtime_nsec));
+      }
+
+      static file_fingerprint read_fingerprint(const char *data, size_t size, size_t &pos)
+      {
+         file_fingerprint file;
+         read_bytes(data, size, pos, &file.present, sizeof(file.present));
+         read_bytes(data, size, pos, &file.device, sizeof(file.device));
+         read_bytes(data, size, pos, &file.inode, sizeof(file.inode));
+         read_bytes(data, size, pos, &file.size, sizeof(file.size));
+         read_bytes(data, size, pos, &file.mtime_sec, sizeof(file.mtime_sec));
+         read_bytes(data, size, pos, &file.mtime_nsec, sizeof(file.mtime_nsec));
+         return(file);
       }
 
       /************************************************************************/
       /*
-      * \brief Print usage example & available data.
+      * \brief Load the cached parse if its key matches and every config file
+      *        it depends on is unchanged. Layout:
       *
-      *     @return None.
+      *        "CLNC" | uint16 version | uint16 0xFEFF | uint64 key
+      *        uint32 file count   { uint32 length | path | fingerprint }
+      *        uint32 positionals  { int32 argv index }
+      *        uint32 length | serialize_snapshot() record
+      *        uint32 FNV-1a checksum of everything before it
+      *
+      *     @param[in] uint64_t key: config_cache_key() of this parse
+      *     @return bool: True on a hit
       * 
       */
-      void print_usage()
-      {  
-         std::cerr << std::endl;
-         std::cerr << "--------------------------------------------------------------" << std::endl; 
-         std::cerr << "foo@bar:~$ ";
-         std::cerr << argv_[0] << " -option_character <argument_value>" << std::endl;
-         std::cerr << "--------------------------------------------------------------" << std::endl;
- 
-         bprinter::TablePrinter tp(&std::cerr);
-         tp.AddColumn("Option Long Name ", 25);
-         tp.AddColumn("Option Character ", 20);
-         tp.AddColumn("Argument Type ", 20);
-         tp.AddColumn("Option Required ", 20);
-         tp.AddColumn("Argument Required ", 20);
-         tp.AddColumn("Argument Default Value ", 30);
-         tp.AddColumn("Description ", 75);
-      
-         tp.PrintHeader();
-         
-         for(size_t option_index = 0; option_index < this->opt_cfg.size() - 1; ++option_index)
+      bool load_config_cache(uint64_t key)
+      {
+         int fd = open(this->config_cache_path.c_str(), O_RDONLY | O_CLOEXEC);
+         if(0 > fd)
          {
+            return(false);
+         }
+         struct stat info;
+         void *mapping = MAP_FAILED;
+         if(0 == fstat(fd, &info) && 24 <= info.st_size)
+         {
+            mapping = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+         }
+         close(fd);
+         if(MAP_FAILED == mapping)
+         {
+            return(false);
+         }
 
-            tp << this->opt_cfg[option_index].name;
-            tp << char(this->opt_cfg[option_index].val);
-            tp << this->get_type_string(this->opt_cfg[option_index].type_string);
-            tp << this->opt_cfg[option_index].is_mandatory_opt;
-            tp << this->opt_cfg[option_index].has_arg;
-
-            std::string type_name = this->opt_cfg[option_index].type_string;
-            if("Pc" == type_name)
+         const char *data = (const char *)mapping;
+         const size_t size = info.st_size;
+         bool hit = false;
+         try
+         {
+            uint32_t checksum = 0;
+            memcpy(&checksum, data + size - sizeof(checksum), sizeof(checksum));
+            if(0 != memcmp(data, config_cache_magic, 4) || checksum != fnv1a_32(data, size - sizeof(checksum)))
             {
-               tp << *(std::string *)this->opt_cfg[option_index].dataVal;
+               throw_snapshot_error("Corrupt config cache");
             }
-            else if("d" == type_name)
+
+            size_t pos = 4;
+            uint16_t version = 0, bom = 0;
+            uint64_t stored_key = 0;
+            read_bytes(data, size, pos, &version, sizeof(version));
+            read_bytes(data, size, pos, &bom, sizeof(bom));
+            read_bytes(data, size, pos, &stored_key, sizeof(stored_key));
+            if(config_cache_version != version || 0xFEFF != bom || key != stored_key)
             {
-               tp << *(double *)this->opt_cfg[option_index].dataVal;
+               throw_snapshot_error("Stale config cache");
             }
-            else if("f" == type_name)
+
+            uint32_t files = 0;
+            read_bytes(data, size, pos, &files, sizeof(files));
+            for(uint32_t file = 0; file < files; ++file)
             {
-               tp << *(float *)this->opt_cfg[option_index].dataVal;
+               uint32_t length = 0;
+               read_bytes(data, size, pos, &length, sizeof(length));
+               if(length > size - sizeof(checksum) - pos)
+               {
+                  throw_snapshot_error("Truncated config cache");
+               }
+               const std::string path(data + pos, length);
+               pos += length;
+
+               const file_fingerprint stored = read_fingerprint(data, size, pos);
+               const file_fingerprint current(path.c_str());
+               if(stored.present != current.present || stored.device != current.device || stored.inode != current.inode ||
+                  stored.size != current.size || stored.mtime_sec != current.mtime_sec || stored.mtime_nsec != current.mtime_nsec)
+               {
+                  throw_snapshot_error("Config file changed: " + path);
+               }
             }
-            else if("i" == type_name)
+
+            uint32_t positionals = 0;
+            read_bytes(data, size, pos, &positionals, sizeof(positionals));
+            if(positionals > this->positional_max)
             {
-               tp << *(int *)this->opt_cfg[option_index].dataVal;
+               throw_snapshot_error("Too many positional arguments");
             }
-            else
+            std::vector<int32_t> positional_index(positionals);
+            for(int32_t &argv_index : positional_index)
             {
-               tp << "None ";
+               read_bytes(data, size, pos, &argv_index, sizeof(argv_index));
+               if(0 > argv_index || argv_index >= this->argc_)
+               {
+                  throw_snapshot_error("Positional argument out of range");
+               }
             }
 
-            tp << this->opt_cfg[option_index].desc_string;
+            uint32_t length = 0;
+            read_bytes(data, size, pos, &length, sizeof(length));
+            if(length != size - sizeof(checksum) - pos)
+            {
+               throw_snapshot_error("Truncated config cache");
+            }
+            // The last step that can fail; it leaves the variables alone if it does
+            this->load_snapshot(data + pos, length);
 
+            this->compile_option_bitsets();
+            this->positional_args.clear();
+            for(int32_t argv_index : positional_index)
+            {
+               this->add_positional_argument(argv_index);
+            }
+            for(size_t option_index = 0; option_index < this->opt_cfg.size(); ++option_index)
+            {
+               if(source_default != this->get_option_source(this->opt_cfg.val(option_index)))
+               {
+                  this->presence_bits[option_index / 64] |= uint64_t(1) << (option_index % 64);
+               }
+            }
+            hit = true;
          }
-         tp.PrintFooter();
+         catch(const std::exception &)
+         {
+            // A miss: nothing has been loaded yet
+         }
+
+         munmap(mapping, size);
+         return(hit);
       }
 
       /************************************************************************/
       /*
-      * \brief Print summary of command line available data.
+      * \brief Store the result of a full parse for load_config_cache(). The
+      *        cache is only an accelerator: failures to write it are ignored.
       *
+      *     @param[in] uint64_t key: config_cache_key() of this parse
+      *     @param[in] timespec parse_start: Coarse clock when the parse started
       *     @return None.
       * 
       */
-      void print_input_summary()
-      {  
-         bprinter::TablePrinter tp(&std::cerr);
-         tp.AddColumn("Option Long Name ", 25);
-         tp.AddColumn("Option Character ", 20);
-         tp.AddColumn("Argument Type ", 20);
-         tp.AddColumn("Option Required ", 20);
-         tp.AddColumn("Argument Required ", 20);
-         tp.AddColumn("Current Argument Value ", 30);
-         tp.AddColumn("Description ", 75);
-     
-         tp.PrintHeader();
+      void write_config_cache(uint64_t key, const struct timespec &parse_start) const
+      {
+         std::vector<char> record;
+         const uint16_t version = config_cache_version;
+         const uint16_t bom = 0xFEFF;
+         append_bytes(record, config_cache_magic, 4);
+         append_bytes(record, &version, sizeof(version));
+         append_bytes(record, &bom, sizeof(bom));
+         append_bytes(record, &key, sizeof(key));
 
-         for(size_t option_index = 0; option_index < this->opt_cfg.size() - 1; ++option_index)
+         const uint32_t files = this->config_cache_inputs.size();
+         append_bytes(record, &files, sizeof(files));
+         for(const std::pmr::string &path : this->config_cache_inputs)
          {
-
-            tp << this->opt_cfg[option_index].name;
-            tp << char(this->opt_cfg[option_index].val);
-            tp << this->get_type_string(this->opt_cfg[option_index].type_string);
-            tp << this->opt_cfg[option_index].is_mandatory_opt;
-            tp << this->opt_cfg[option_index].has_arg;
-
-            std::string type_name = this->opt_cfg[option_index].type_string;
-            if("Pc" == type_name)
-            {
-               tp << *(std::string *)this->opt_cfg[option_index].dataVal;
-            }
-            else if("d" == type_name)
-            {
-               tp << *(double *)this->opt_cfg[option_index].dataVal;
-            }
-            else if("f" == type_name)
-            {
-               tp << *(float *)this->opt_cfg[option_index].dataVal;
-            }
-            else if("i" == type_name)
+            const file_fingerprint file(path.c_str());
+            // Written in the tick the parse started: a later change could keep the mtime
+            if(file.present && (file.mtime_sec > parse_start.tv_sec ||
+                                (file.mtime_sec == parse_start.tv_sec && file.mtime_nsec >= parse_start.tv_nsec)))
             {
-               tp << *(int *)this->opt_cfg[option_index].dataVal;
+               return;
             }
-            else
+            const uint32_t length = path.size();
+            append_bytes(record, &length, sizeof(length));
+            append_bytes(record, path.data(), length);
+            append_fingerprint(record, file);
+         }
+
+         const uint32_t positionals = this->positional_args.size();
+         append_bytes(record, &positionals, sizeof(positionals));
+         int32_t argv_index = 0;
+         for(size_t i = 0; i < this->positional_args.size(); ++i)
+         {
+            while(argv_index < this->argc_ && this->argv_[argv_index] != this->positional_args[i]) ++argv_index;
+            if(argv_index == this->argc_)
             {
-               tp << "None ";
+               return;
             }
+            append_bytes(record, &argv_index, sizeof(argv_index));
+            ++argv_index;
+         }
 
-            tp << this->opt_cfg[option_index].desc_string;
+         const std::vector<char> snapshot = this->serialize_snapshot();
+         const uint32_t length = snapshot.size();
+         append_bytes(record, &length, sizeof(length));
+         append_bytes(record, snapshot.data(), snapshot.size());
+         const uint32_t checksum = fnv1a_32(record.data(), record.size());
+         append_bytes(record, &checksum, sizeof(checksum));
 
+         // Readers only ever see a complete old or a complete new file
+         const std::string temporary = this->config_cache_path + ".tmp." + std::to_string(getpid());
+         int fd = open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+         if(0 > fd)
+         {
+            return;
          }
-         tp.PrintFooter();
+         size_t written = 0;
+         while(written < record.size())
+         {
+            ssize_t bytes = write(fd, record.data() + written, record.size() - written);
+            if(0 > bytes && EINTR == errno) continue;
+            if(0 >= bytes) break;
+            written += bytes;
+         }
+         if(0 != close(fd) || written != record.size() || 0 != rename(temporary.c_str(), this->config_cache_path.c_str()))
+         {
+            unlink(temporary.c_str());
+         }
+      }
+
+      static constexpr int shard_option_val = 256; /**< Long only, outside of the option characters */
+      static constexpr int first_allocated_val = 0x1000; /**< First value handed out by allocate_option_val() */
+
+      static constexpr char snapshot_magic[4] = {'C', 'L', 'N', 'S'};
+      static constexpr uint16_t snapshot_version = 1;
+
+      static constexpr char config_cache_magic[4] = {'C', 'L', 'N', 'C'};
+      static constexpr uint16_t config_cache_version = 1;
+
+      static void append_bytes(std::vector<char> &record, const void *bytes, size_t count)
+      {
+         const char *first = (const char *)bytes;
+         record.insert(record.end(), first, first + count);
+      }
+
+      static void read_bytes(const char *data, size_t size, size_t &pos, void *bytes, size_t count)
+      {
+         // Last four bytes always belong to the checksum
+         if(pos + count > size - sizeof(uint32_t))
+         {
+            throw_snapshot_error("Truncated snapshot record");
+         }
+         memcpy(bytes, data + pos, count);
+         pos += count;
+      }
+
+      static uint32_t fnv1a_32(const char *data, size_t size)
+      {
+         uint32_t hash = 2166136261u;
+         for(size_t i = 0; i < size; ++i)
+         {
+            hash ^= (unsigned char)data[i];
+            hash *= 16777619u;
+         }
+         return(hash);
+      }
+
+      static void throw_snapshot_error(const std::string &what)
+      {
+         std::stringstream ss("");
+         ss << "*************************************************************************" << std::endl;
+         ss << "snapshot(...) - " << what << std::endl;
+         ss << "*************************************************************************" << std::endl;
+         throw cline_utils::cline_exception(std::string(ss.str()));
       }
 
    }; // End class CommandLineParser
@@ -0,0 +1,107 @@
+// -----------------------------------------------------------------------
+//
+//                        bench_option_storage.cpp V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <new>
+
+#include "cline_utils.h"
+
+// Live heap bytes, tracked with a small header in front of every allocation
+static size_t g_live_bytes = 0;
+
+void *operator new(size_t size)
+{
+   size_t *block = (size_t *)malloc(size + 16);
+   if(NULL == block) throw std::bad_alloc();
+   block[0] = size;
+   g_live_bytes += size;
+   return((char *)block + 16);
+}
+
+void operator delete(void *ptr) noexcept
+{
+   if(NULL == ptr) return;
+   size_t *block = (size_t *)((char *)ptr - 16);
+   g_live_bytes -= block[0];
+   free(block);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+   operator delete(ptr);
+}
+
+// std::pmr::new_delete_resource() uses the aligned forms; 16 byte alignment suffices here
+void *operator new(size_t size, std::align_val_t)
+{
+   return(operator new(size));
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept
+{
+   operator delete(ptr);
+}
+
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept
+{
+   operator delete(ptr);
+}
+
+/************************************************************************/
+/*
+* \brief Compare the heap used per option by the old array of option_longer
+*        structs (as the parser used to copy it) with the structure of arrays
+*        table the parser keeps now.
+*
+*        Usage: bench_option_storage [option_count]
+* 
+*/
+int main(int argc, char** argv)
+{
+   const size_t option_count = (1 < argc) ? strtoul(argv[1], NULL, 10) : 5000;
+
+   std::vector<std::string> names(option_count);
+   std::vector<double> values(option_count, 0.0);
+   std::vector<cline_utils::option_longer> longer_options;
+   for(size_t i = 0; i < option_count; ++i)
+   {
+      names[i] = "option_" + std::to_string(i);
+      longer_options.push_back({names[i].c_str(), required_argument, NULL, int(0x1000 + i), optional_option, typeid(double).name(), &values[i],
+                                " Scan parameter " + std::to_string(i % 50) + " of the detector model [physical units]"});
+   }
+
+   // Before: the parser held a copy of the vector plus the zero terminator
+   size_t before = g_live_bytes;
+   {
+      std::vector<cline_utils::option_longer> copy(longer_options);
+      copy.push_back({NULL, 0, NULL, 0, required_option, "", NULL, ""});
+      before = g_live_bytes - before;
+   }
+
+   // After: structure of arrays with interned strings
+   size_t after = g_live_bytes;
+   size_t table = 0;
+   {
+      cline_utils::CommandLineParser cline(argc, argv);
+      after = g_live_bytes;
+      cline.add_options(longer_options);
+      after = g_live_bytes - after;
+      table = cline.option_memory_usage();
+   }
+
+   std::cout << std::fixed << std::setprecision(1);
+   std::cout << "options                     : " << option_count << std::endl;
+   std::cout << "sizeof(option_longer)       : " << sizeof(cline_utils::option_longer) << std::endl;
+   std::cout << "array of structs  bytes/opt : " << double(before) / option_count << std::endl;
+   std::cout << "struct of arrays  bytes/opt : " << double(table) / option_count
+             << " (parser total incl. tables " << double(after) / option_count << ")" << std::endl;
+
+   return(0);
+}
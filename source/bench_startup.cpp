@@ -0,0 +1,82 @@
+// -----------------------------------------------------------------------
+//
+//                          bench_startup.cpp V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+extern char **environ;
+
+/************************************************************************/
+/*
+* \brief Report the file size of a program and the time from spawning it to
+*        its exit (process start up, parsing and main() returning), so the
+*        cost of a parser configuration can be compared between builds:
+*
+*           bench_startup 200 build/bin/example_embedded_main -n 3 -o out.txt
+*
+*        The program's output goes to /dev/null.
+*
+*     @param[in] int argc: Number of command line arguments
+*     @param[in] char **argv: runs, program, program arguments...
+*     @return int: Success status
+* 
+*/
+int main(int argc, char** argv)
+{
+   if(3 > argc)
+   {
+      std::cerr << "usage: " << argv[0] << " <runs> <program> [arguments...]" << std::endl;
+      return(1);
+   }
+
+   const int runs = std::max(1, atoi(argv[1]));
+   char **program = argv + 2;
+
+   struct stat info;
+   if(0 != stat(program[0], &info))
+   {
+      std::cerr << argv[0] << ": cannot stat " << program[0] << std::endl;
+      return(1);
+   }
+
+   posix_spawn_file_actions_t actions;
+   posix_spawn_file_actions_init(&actions);
+   posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+   posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+
+   std::vector<double> micros;
+   int last_status = 0;
+   for(int run = 0; run < runs; ++run)
+   {
+      auto start = std::chrono::steady_clock::now();
+      pid_t pid;
+      if(0 != posix_spawn(&pid, program[0], &actions, NULL, program, environ))
+      {
+         std::cerr << argv[0] << ": cannot run " << program[0] << std::endl;
+         return(1);
+      }
+      waitpid(pid, &last_status, 0);
+      micros.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+   }
+   posix_spawn_file_actions_destroy(&actions);
+
+   std::sort(micros.begin(), micros.end());
+   std::cout << program[0] << ": " << info.st_size << " bytes, spawn to exit median " << micros[micros.size() / 2]
+             << " us, min " << micros.front() << " us over " << runs << " runs (exit status "
+             << (WIFEXITED(last_status) ? WEXITSTATUS(last_status) : -1) << ")" << std::endl;
+   return(0);
+}
@@ -0,0 +1,505 @@
+// -----------------------------------------------------------------------
+//
+//                            cline_codegen.cpp V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+//
+// Build time generator turning a declarative option schema into a header
+// with static option tables. Each non-comment schema line holds seven '|'
+// separated fields:
+//
+//    long name | short character | type | required/optional | argument | default | description
+//
+// where type is one of string, double, int, float or flag and argument is
+// one of required, optional or none. See source/example_options.schema.
+//
+// Usage: cline_codegen <schema file> <output header> <namespace>
+//
+// -----------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <set>
+
+struct schema_option
+{
+   std::string name;
+   char        val;
+   std::string type;
+   bool        is_required;
+   std::string has_arg;
+   std::string default_value;
+   std::string description;
+   int         line_number;
+};
+
+/************************************************************************/
+/*
+* \brief Report a schema error and exit with failure status
+*
+*     @param[in] std::string schema_file: Name of the schema being processed
+*     @param[in] int line_number: Offending line (0 if not line related)
+*     @param[in] std::string what: Description of the problem
+*     @return None.
+*
+*/
+[[noreturn]] void schema_error(const std::string &schema_file, int line_number, const std::string &what)
+{
+   std::cerr << schema_file << ":" << line_number << ": cline_codegen error: " << what << std::endl;
+   exit(EXIT_FAILURE);
+}
+
+/************************************************************************/
+/*
+* \brief Remove leading and trailing white space
+*
+*     @param[in] std::string s: Input string
+*     @return std::string: Trimmed copy
+*
+*/
+std::string trim(const std::string &s)
+{
+   size_t first = s.find_first_not_of(" \t\r\n");
+   if(std::string::npos == first)
+   {
+      return("");
+   }
+   size_t last = s.find_last_not_of(" \t\r\n");
+   return(s.substr(first, last - first + 1));
+}
+
+/************************************************************************/
+/*
+* \brief Escape a string so it can be emitted as a C string literal
+*
+*     @param[in] std::string s: Raw string
+*     @return std::string: Quoted and escaped literal
+*
+*/
+std::string quote(const std::string &s)
+{
+   std::string result("\"");
+   for(char c : s)
+   {
+      switch(c)
+      {
+         case '"':  result += "\\\""; break;
+         case '\\': result += "\\\\"; break;
+         case '\n': result += "\\n";  break;
+         case '\t': result += "\\t";  break;
+         default:   result += c;      break;
+      }
+   }
+   result += "\"";
+   return(result);
+}
+
+/************************************************************************/
+/*
+* \brief Escape a short option name so it can be emitted as a C character literal
+*
+*     @param[in] char c: Short option name
+*     @return std::string: Quoted and escaped literal
+*
+*/
+std::string char_literal(char c)
+{
+   if('\'' == c || '\\' == c)
+   {
+      return(std::string("'\\") + c + "'");
+   }
+   return(std::string("'") + c + "'");
+}
+
+/************************************************************************/
+/*
+* \brief Read and validate every option of the schema file
+*
+*     @param[in] std::string schema_file: Name of the schema file
+*     @return std::vector<schema_option>: Options in declaration order
+*
+*/
+std::vector<schema_option> read_schema(const std::string &schema_file)
+{
+   std::ifstream in(schema_file);
+   if(!in)
+   {
+      schema_error(schema_file, 0, "unable to open schema file");
+   }
+
+   std::vector<schema_option> result;
+   std::set<std::string> long_names;
+   std::set<char> short_names;
+
+   std::string line;
+   int line_number = 0;
+   while(std::getline(in, line))
+   {
+      ++line_number;
+      line = trim(line);
+      if(line.empty() || '#' == line[0])
+      {
+         continue;
+      }
+
+      std::vector<std::string> fields;
+      std::stringstream ss(line);
+      std::string field;
+      // The description is the last field and may itself contain '|'
+      while(fields.size() < 6 && std::getline(ss, field, '|'))
+      {
+         fields.push_back(trim(field));
+      }
+      std::getline(ss, field);
+      fields.push_back(trim(field));
+
+      if(7 != fields.size())
+      {
+         schema_error(schema_file, line_number, "expected 7 '|' separated fields");
+      }
+
+      schema_option opt;
+      opt.name          = fields[0];
+      opt.type          = fields[2];
+      opt.has_arg       = fields[4];
+      opt.default_value = fields[5];
+      opt.description   = fields[6];
+      opt.line_number   = line_number;
+
+      if(opt.name.empty() || std::string::npos != opt.name.find_first_of(" \t="))
+      {
+         schema_error(schema_file, line_number, "invalid long name '" + opt.name + "'");
+      }
+      if(1 != fields[1].size() || !isgraph((unsigned char)fields[1][0]) || ':' == fields[1][0] || '-' == fields[1][0])
+      {
+         schema_error(schema_file, line_number, "short name must be a single printable character");
+      }
+      opt.val = fields[1][0];
+
+      if("string" != opt.type && "double" != opt.type && "int" != opt.type && "float" != opt.type && "flag" != opt.type)
+      {
+         schema_error(schema_file, line_number, "unknown type '" + opt.type + "'");
+      }
+
+      if("required" == fields[3])
+      {
+         opt.is_required = true;
+      }
+      else if("optional" == fields[3])
+      {
+         opt.is_required = false;
+      }
+      else
+      {
+         schema_error(schema_file, line_number, "fourth field must be required or optional");
+      }
+
+      if("required" != opt.has_arg && "optional" != opt.has_arg && "none" != opt.has_arg)
+      {
+         schema_error(schema_file, line_number, "argument must be required, optional or none");
+      }
+      if("flag" == opt.type && "none" != opt.has_arg)
+      {
+         schema_error(schema_file, line_number, "flag options cannot take an argument");
+      }
+
+      if(!long_names.insert(opt.name).second)
+      {
+         schema_error(schema_file, line_number, "duplicate long name '" + opt.name + "'");
+      }
+      if(!short_names.insert(opt.val).second)
+      {
+         schema_error(schema_file, line_number, std::string("duplicate short name '") + opt.val + "'");
+      }
+
+      result.push_back(opt);
+   }
+
+   return(result);
+}
+
+/************************************************************************/
+/*
+* \brief Member name of an option inside the generated values struct. Long
+*        names may contain characters such as '-' or '.' that are not valid
+*        in identifiers, so those are replaced by '_'.
+*
+*     @param[in] schema_option opt: Schema entry
+*     @return std::string: Identifier
+*
+*/
+std::string member_name(const schema_option &opt)
+{
+   std::string result(opt.name);
+   for(char &c : result)
+   {
+      if(!isalnum((unsigned char)c)) c = '_';
+   }
+   if(isdigit((unsigned char)result[0]))
+   {
+      result.insert(0, "_");
+   }
+   return(result);
+}
+
+/************************************************************************/
+/*
+* \brief C++ type used for the typed member of an option
+*
+*     @param[in] schema_option opt: Schema entry
+*     @return std::string: C++ type name
+*
+*/
+std::string cxx_type(const schema_option &opt)
+{
+   if("string" == opt.type) return("std::string");
+   if("flag"   == opt.type) return("int");
+   return(opt.type);
+}
+
+/************************************************************************/
+/*
+* \brief Expression that typeid(...).name() must be taken of. Strings are
+*        bound as char * to match the runtime convention.
+*
+*     @param[in] schema_option opt: Schema entry
+*     @return std::string: Type expression
+*
+*/
+std::string typeid_type(const schema_option &opt)
+{
+   if("string" == opt.type) return("char *");
+   if("flag"   == opt.type) return("int");
+   return(opt.type);
+}
+
+/************************************************************************/
+/*
+* \brief C++ initializer for the default value of an option
+*
+*     @param[in] schema_option opt: Schema entry
+*     @return std::string: Initializer expression
+*
+*/
+std::string default_initializer(const schema_option &opt)
+{
+   if("string" == opt.type)
+   {
+      return(quote(opt.default_value));
+   }
+   if(opt.default_value.empty())
+   {
+      return("0");
+   }
+   if("double" == opt.type && ("nan" == opt.default_value || "NaN" == opt.default_value))
+   {
+      return("std::nan(\"1\")");
+   }
+   if("float" == opt.type && ("nan" == opt.default_value || "NaN" == opt.default_value))
+   {
+      return("std::nanf(\"1\")");
+   }
+   return(opt.default_value);
+}
+
+/************************************************************************/
+/*
+* \brief getopt_long has_arg macro for an option
+*
+*     @param[in] schema_option opt: Schema entry
+*     @return std::string: Macro name
+*
+*/
+std::string has_arg_macro(const schema_option &opt)
+{
+   if("required" == opt.has_arg) return("required_argument");
+   if("optional" == opt.has_arg) return("optional_argument");
+   return("no_argument");
+}
+
+/************************************************************************/
+/*
+* \brief Build the usage text once so generated binaries never format it
+*
+*     @param[in] std::vector<schema_option> options: Schema entries
+*     @return std::string: Usage text
+*
+*/
+std::string build_usage(const std::vector<schema_option> &options)
+{
+   std::stringstream ss("");
+   ss << "Options:" << std::endl;
+   for(const schema_option &opt : options)
+   {
+      std::string left = std::string("  -") + opt.val + ", --" + opt.name;
+      if("required" == opt.has_arg)
+      {
+         left += " <" + opt.type + ">";
+      }
+      else if("optional" == opt.has_arg)
+      {
+         left += "[=" + opt.type + "]";
+      }
+      if(left.size() < 34)
+      {
+         left.append(34 - left.size(), ' ');
+      }
+      ss << left << (opt.is_required ? "(required) " : "") << opt.description;
+      if(!opt.default_value.empty() && "flag" != opt.type)
+      {
+         ss << " [default: " << opt.default_value << "]";
+      }
+      ss << std::endl;
+   }
+   return(ss.str());
+}
+
+/************************************************************************/
+/*
+* \brief Write the generated header
+*
+*     @param[in] std::ostream &out: Destination
+*     @param[in] std::string schema_file: Schema the header was generated from
+*     @param[in] std::string name_space: Namespace holding the generated tables
+*     @param[in] std::vector<schema_option> options: Schema entries
+*     @return None.
+*
+*/
+void write_header(std::ostream &out, const std::string &schema_file, const std::string &name_space, const std::vector<schema_option> &options)
+{
+   std::string guard = name_space + "_cline_options_h";
+
+   out << "// -----------------------------------------------------------------------" << std::endl;
+   out << "//" << std::endl;
+   out << "//     Generated by cline_codegen from " << schema_file << std::endl;
+   out << "//     DO NOT EDIT. Edit the schema instead." << std::endl;
+   out << "//" << std::endl;
+   out << "// -----------------------------------------------------------------------" << std::endl;
+   out << std::endl;
+   out << "#ifndef " << guard << std::endl;
+   out << "#define " << guard << std::endl;
+   out << std::endl;
+   out << "#include \"cline_utils.h\"" << std::endl;
+   out << std::endl;
+   out << "namespace " << name_space << std::endl;
+   out << "{" << std::endl;
+
+   // Typed storage for every option, initialized with the schema defaults
+   out << "   struct values" << std::endl;
+   out << "   {" << std::endl;
+   for(const schema_option &opt : options)
+   {
+      out << "      " << cxx_type(opt) << " " << member_name(opt) << " = " << default_initializer(opt) << ";" << std::endl;
+   }
+   out << "   };" << std::endl;
+   out << std::endl;
+
+   out << "   inline constexpr size_t option_count = " << options.size() << ";" << std::endl;
+   out << std::endl;
+
+   // Format string exactly as create_option_format_string() would build it
+   std::string format_string("-:");
+   for(const schema_option &opt : options)
+   {
+      format_string += opt.val;
+      if("required" == opt.has_arg) format_string += ":";
+      if("optional" == opt.has_arg) format_string += "::";
+   }
+   out << "   inline constexpr char format_string[] = " << quote(format_string) << ";" << std::endl;
+   out << std::endl;
+
+   out << "   inline constexpr option getopt_table[] =" << std::endl;
+   out << "      {" << std::endl;
+   for(const schema_option &opt : options)
+   {
+      out << "         {" << quote(opt.name) << ", " << has_arg_macro(opt) << ", NULL, " << char_literal(opt.val) << "}," << std::endl;
+   }
+   out << "         {NULL, 0, NULL, 0}" << std::endl;
+   out << "      };" << std::endl;
+   out << std::endl;
+
+   // Short character -> option index, -1 when unused
+   std::vector<int> short_index(256, -1);
+   for(size_t i = 0; i < options.size(); ++i)
+   {
+      short_index[(unsigned char)options[i].val] = i;
+   }
+   out << "   inline constexpr int16_t short_index[256] =" << std::endl;
+   out << "      {";
+   for(size_t i = 0; i < short_index.size(); ++i)
+   {
+      if(0 == i % 16)
+      {
+         out << ((0 == i) ? "" : ",") << std::endl << "         ";
+      }
+      else
+      {
+         out << ", ";
+      }
+      out << short_index[i];
+   }
+   out << std::endl << "      };" << std::endl;
+   out << std::endl;
+
+   out << "   inline constexpr char usage[] = " << quote(build_usage(options)) << ";" << std::endl;
+   out << std::endl;
+
+   out << "   inline constexpr cline_utils::static_option_tables tables = {format_string, getopt_table, short_index, usage, option_count};" << std::endl;
+   out << std::endl;
+
+   // Binding the typed storage to a parser
+   out << "   inline void add_options(cline_utils::CommandLineParser &cline, values &v)" << std::endl;
+   out << "   {" << std::endl;
+   for(const schema_option &opt : options)
+   {
+      out << "      cline.add_option({" << quote(opt.name) << ", " << has_arg_macro(opt) << ", NULL, " << char_literal(opt.val) << ", "
+          << (opt.is_required ? "required_option" : "optional_option") << ", typeid(" << typeid_type(opt) << ").name(), &v."
+          << member_name(opt) << ", " << quote(opt.description) << "});" << std::endl;
+   }
+   out << "      cline.set_static_tables(tables);" << std::endl;
+   out << "   }" << std::endl;
+
+   out << "}" << std::endl;
+   out << std::endl;
+   out << "#endif" << std::endl;
+}
+
+/************************************************************************/
+/*
+* \brief Main function of the generator
+*
+*     @param[in] int argc: Integer variable storing number of command line arguments (including executable name)
+*     @param[in] char **argv: Array of character pointers listing all the arguments
+*     @return int: Success status
+*
+*/
+int main(int argc, char **argv)
+{
+   if(4 != argc)
+   {
+      std::cerr << "Usage: " << argv[0] << " <schema file> <output header> <namespace>" << std::endl;
+      return(EXIT_FAILURE);
+   }
+
+   const std::string schema_file(argv[1]), output_file(argv[2]), name_space(argv[3]);
+
+   std::vector<schema_option> options = read_schema(schema_file);
+
+   // Write to a string first so a failed run never leaves a partial header behind
+   std::stringstream ss("");
+   write_header(ss, schema_file, name_space, options);
+
+   std::ofstream out(output_file, std::ios::trunc);
+   out << ss.str();
+   if(!out)
+   {
+      schema_error(output_file, 0, "unable to write output header");
+   }
+
+   return(EXIT_SUCCESS);
+}
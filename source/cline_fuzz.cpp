@@ -0,0 +1,962 @@
+// -----------------------------------------------------------------------
+//
+//                            cline_fuzz.cpp V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <malloc.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "cline_utils.h"
+
+/************************************************************************/
+/*
+* \brief Fuzz and stress driver for CommandLineParser.
+*
+*        Every input is one case: its first byte picks the mode, its second
+*        byte a small parameter and the rest is the payload.
+*
+*           0  argv         payload split at NUL bytes into arguments, parameter limits positionals
+*           1  response     payload split like a shell command line (ArgvBuilder::append)
+*           2  files-from   payload is a --files-from list, parameter picks delimiter and buffer
+*           3  config       payload is a config file, parameter may add --alpha on argv
+*
+*        Argument lists are parsed twice, by the parser and by a plain
+*        getopt_long loop over the same option table, and the outcomes must
+*        agree: the same error class, or the same values and positional
+*        arguments. Lists must stream the entries a straight split gives.
+*        Every successful parse must survive a snapshot round trip, and the
+*        parser may only ever throw cline_exception.
+*
+*        Built with -DCLINE_FUZZ_LIBFUZZER and -fsanitize=fuzzer only
+*        LLVMFuzzerTestOneInput() is compiled. Otherwise main() runs a corpus
+*        (files or directories), generated cases, or the throughput report:
+*
+*           cline_fuzz corpus/ crash-1234
+*           cline_fuzz --runs 100000 --seed 7
+*           cline_fuzz --bench --baseline fuzz_baseline.txt --save fuzz_current.txt
+*
+*/
+
+enum fuzz_mode : uint8_t
+{
+   mode_argv       = 0,
+   mode_response   = 1,
+   mode_files_from = 2,
+   mode_config     = 3,
+   mode_count      = 4
+};
+
+/************************************************************************/
+/*
+* \brief Variables bound to the fuzzed option table
+*
+*/
+struct fuzz_values
+{
+   std::string alpha = "unset";
+   std::string alphabet = "unset";
+   bool beta = false;
+   std::vector<std::string> gamma;
+   std::string delta = "unset";
+   bool x = false;
+   std::string level = "unset";
+   std::string files_from = "unset";
+
+   bool operator==(const fuzz_values &other) const
+   {
+      return(this->alpha == other.alpha && this->alphabet == other.alphabet && this->beta == other.beta &&
+             this->gamma == other.gamma && this->delta == other.delta && this->x == other.x &&
+             this->level == other.level && this->files_from == other.files_from);
+   }
+};
+
+static const int delta_val = 0x1000; /**< Long only option */
+
+/************************************************************************/
+/*
+* \brief The option table, chosen so abbreviations are ambiguous ("--alph"),
+*        a long name is one character long ("--x"), and every has_arg kind
+*        and a list option take part
+*
+*/
+static std::vector<cline_utils::option_longer> make_fuzz_options(fuzz_values &values)
+{
+   std::vector<cline_utils::option_longer> options =
+      {
+         cline_utils::make_option("alpha", 'a', values.alpha, " Required argument"),
+         cline_utils::make_option("alphabet", 'b', values.alphabet, " Optional argument"),
+         cline_utils::make_option("beta", 'B', values.beta, " Flag"),
+         cline_utils::make_option("gamma", 'g', values.gamma, " List"),
+         cline_utils::make_option("delta", delta_val, values.delta, " Long only"),
+         cline_utils::make_option("x", 'x', values.x, " One character long name"),
+         cline_utils::make_option("verbose-level", 'v', values.level, " Optional argument"),
+         cline_utils::make_option("files-from", 'F', values.files_from, " Entry list")
+      };
+   options[1].has_arg = optional_argument;
+   options[6].has_arg = optional_argument;
+   return(options);
+}
+
+/************************************************************************/
+/*
+* \brief Outcome of one parse: an error class, or values and positionals
+*
+*/
+struct fuzz_outcome
+{
+   std::string error;
+   fuzz_values values;
+   std::vector<std::string> positional;
+};
+
+static std::string classify_error(const std::string &message)
+{
+   for(const char *kind : {"Unrecognized option", "Missing argument", "Duplicate option"})
+   {
+      if(std::string::npos != message.find(kind))
+      {
+         return(kind);
+      }
+   }
+   if(std::string::npos != message.find("Arguments with no corresponding option"))
+   {
+      return("Unexpected positional");
+   }
+   return("other: " + message);
+}
+
+/************************************************************************/
+/*
+* \brief Escaped arguments for failure reports
+*
+*/
+static std::string describe_arguments(const std::vector<std::string> &arguments)
+{
+   std::string out;
+   for(const std::string &argument : arguments)
+   {
+      out += " '";
+      for(unsigned char c : argument.substr(0, 200))
+      {
+         if(isprint(c) && '\'' != c && '\\' != c)
+         {
+            out += char(c);
+         }
+         else
+         {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\x%02x", c);
+            out += escaped;
+         }
+      }
+      out += (200 < argument.size()) ? "...'" : "'";
+   }
+   return(out);
+}
+
+#ifndef CLINE_FUZZ_LIBFUZZER
+static const char *failure_file = "cline_fuzz_failure.bin";
+static const uint8_t *current_data = NULL; /**< Input of the running case */
+static size_t current_size = 0;
+#endif
+
+static size_t parsed_cases = 0;   /**< Cases that parsed */
+static size_t rejected_cases = 0; /**< Cases rejected with a cline_exception */
+
+/************************************************************************/
+/*
+* \brief Report a finding and abort, so libFuzzer keeps the input. The
+*        standalone driver also writes it to cline_fuzz_failure.bin.
+*
+*/
+[[noreturn]] static void fuzz_failure(const std::string &what, const std::vector<std::string> &arguments)
+{
+   std::cerr << "cline_fuzz: " << what << std::endl;
+   std::cerr << "   arguments:" << describe_arguments(arguments) << std::endl;
+#ifndef CLINE_FUZZ_LIBFUZZER
+   if(NULL != current_data)
+   {
+      std::ofstream out(failure_file, std::ios::binary);
+      out.write((const char *)current_data, current_size);
+      std::cerr << "   input written to " << failure_file << std::endl;
+   }
+#endif
+   abort();
+}
+
+/************************************************************************/
+/*
+* \brief The reference: a plain getopt_long loop with the parser's format
+*        string and rules (duplicates are errors except for the list,
+*        positionals beyond positional_max are errors)
+*
+*/
+static fuzz_outcome run_getopt_long(const std::vector<std::string> &arguments, size_t positional_max)
+{
+   fuzz_outcome result;
+   fuzz_values &values = result.values;
+
+   std::vector<std::string> storage(arguments);
+   std::vector<char *> argv;
+   for(std::string &argument : storage) argv.push_back(&argument[0]);
+   argv.push_back(NULL);
+   const int argc = argv.size() - 1;
+
+   fuzz_values unused;
+   std::vector<cline_utils::option_longer> options = make_fuzz_options(unused);
+   std::vector<option> table;
+   std::string format("-:");
+   for(const cline_utils::option_longer &o : options)
+   {
+      table.push_back({o.name, o.has_arg, NULL, o.val});
+      if(cline_utils::is_short_option_val(o.val))
+      {
+         format += char(o.val);
+         format += (required_argument == o.has_arg) ? ":" : (optional_argument == o.has_arg) ? "::" : "";
+      }
+   }
+   table.push_back({NULL, 0, NULL, 0});
+
+   std::set<int> seen;
+   optind = 0;
+   while(true)
+   {
+      int index = -1;
+      int opt = getopt_long(argc, argv.data(), format.c_str(), table.data(), &index);
+      if(-1 == opt) break;
+      if('?' == opt) { result.error = "Unrecognized option"; return(result); }
+      if(':' == opt) { result.error = "Missing argument"; return(result); }
+      if(1 == opt)
+      {
+         if(result.positional.size() >= positional_max) { result.error = "Unexpected positional"; return(result); }
+         result.positional.push_back(argv[optind - 1]);
+         continue;
+      }
+
+      const std::string text = (NULL != optarg) ? optarg : "";
+      if('g' == opt)
+      {
+         values.gamma.push_back(text);
+         continue;
+      }
+      if(false == seen.insert(opt).second)
+      {
+         result.error = "Duplicate option";
+         return(result);
+      }
+      switch(opt)
+      {
+         case 'a': values.alpha = text; break;
+         case 'b': values.alphabet = text; break;
+         case 'B': values.beta = true; break;
+         case delta_val: values.delta = text; break;
+         case 'x': values.x = true; break;
+         case 'v': values.level = text; break;
+         case 'F': values.files_from = text; break;
+      }
+   }
+   for(int argv_index = optind; argv_index < argc; ++argv_index)
+   {
+      if(result.positional.size() >= positional_max) { result.error = "Unexpected positional"; return(result); }
+      result.positional.push_back(argv[argv_index]);
+   }
+   return(result);
+}
+
+/************************************************************************/
+/*
+* \brief Values must come back unchanged from a snapshot of them
+*
+*/
+static void check_snapshot(cline_utils::CommandLineParser &cline, fuzz_values &values, const std::vector<std::string> &arguments)
+{
+   const fuzz_values parsed = values;
+   std::vector<char> record = cline.serialize_snapshot();
+   values = fuzz_values();
+   values.gamma = {"stale"};
+   cline.load_snapshot(record);
+   if(false == (parsed == values))
+   {
+      fuzz_failure("snapshot round trip changed the values", arguments);
+   }
+}
+
+/************************************************************************/
+/*
+* \brief Parse an argument list with the parser and compare with getopt_long
+*
+*/
+static void run_arguments(const std::vector<std::string> &arguments, uint8_t parameter)
+{
+   const size_t positional_max = (parameter & 1) ? SIZE_MAX : (parameter >> 1) % 3;
+   cline_utils::ArgvBuilder argv;
+   for(const std::string &argument : arguments) argv.push_back(argument);
+
+   fuzz_outcome actual;
+   cline_utils::CommandLineParser cline(argv.argc(), argv.argv());
+   cline.add_options(make_fuzz_options(actual.values));
+   cline.set_positional_arity(0, positional_max);
+   try
+   {
+      cline.parse_command_line();
+      for(const char *argument : cline.get_positional_arguments())
+      {
+         actual.positional.push_back(argument);
+      }
+   }
+   catch(const cline_utils::cline_exception &e)
+   {
+      actual.error = classify_error(e.what());
+   }
+   catch(const std::exception &e)
+   {
+      fuzz_failure(std::string("parse_command_line threw a non cline_exception: ") + e.what(), arguments);
+   }
+
+   const fuzz_outcome expected = run_getopt_long(arguments, positional_max);
+   if(actual.error != expected.error)
+   {
+      fuzz_failure("error '" + actual.error + "', getopt_long gives '" + expected.error + "'", arguments);
+   }
+   if(false == actual.error.empty())
+   {
+      ++rejected_cases;
+      return;
+   }
+   if(false == (actual.values == expected.values))
+   {
+      fuzz_failure("values differ from getopt_long (alpha '" + actual.values.alpha + "' vs '" + expected.values.alpha +
+                   "', " + std::to_string(actual.values.gamma.size()) + " vs " + std::to_string(expected.values.gamma.size()) +
+                   " list elements)", arguments);
+   }
+   if(actual.positional != expected.positional)
+   {
+      fuzz_failure("positional arguments differ from getopt_long (" + std::to_string(actual.positional.size()) + " vs " +
+                   std::to_string(expected.positional.size()) + ")", arguments);
+   }
+   check_snapshot(cline, actual.values, arguments);
+   ++parsed_cases;
+}
+
+/************************************************************************/
+/*
+* \brief Anonymous file holding text, named through /proc/self/fd
+*
+*/
+class memory_file
+{
+   private:
+
+      int fd = -1;
+
+   public:
+
+      explicit memory_file(const std::string &text)
+      {
+         this->fd = memfd_create("cline_fuzz", MFD_CLOEXEC);
+         if(0 > this->fd || ssize_t(text.size()) != write(this->fd, text.data(), text.size()))
+         {
+            std::cerr << "cline_fuzz: cannot create a memory file" << std::endl;
+            exit(2);
+         }
+      }
+
+      ~memory_file() { close(this->fd); }
+
+      std::string path() const { return("/proc/self/fd/" + std::to_string(this->fd)); }
+};
+
+/************************************************************************/
+/*
+* \brief Stream a --files-from list and compare with a straight split
+*
+*/
+static void run_files_from(uint8_t parameter, const std::string &text)
+{
+   const char delimiter = (parameter & 1) ? '\0' : '\n';
+   const size_t capacity = 16 + (parameter >> 1);
+   memory_file list(text);
+   const std::vector<std::string> arguments = {"cline_fuzz", "--files-from=" + list.path()};
+
+   std::vector<std::string> expected;
+   size_t longest = 0;
+   for(size_t first = 0; first < text.size();)
+   {
+      size_t last = text.find(delimiter, first);
+      if(std::string::npos == last) last = text.size();
+      longest = std::max(longest, last - first);
+      std::string entry = text.substr(first, last - first);
+      if('\n' == delimiter && false == entry.empty() && '\r' == entry.back()) entry.pop_back();
+      if(false == entry.empty()) expected.push_back(entry);
+      first = last + 1;
+   }
+
+   fuzz_values values;
+   cline_utils::ArgvBuilder argv{arguments[0], arguments[1]};
+   cline_utils::CommandLineParser cline(argv.argc(), argv.argv());
+   cline.add_options(make_fuzz_options(values));
+   std::vector<std::string> actual;
+   bool too_long = false;
+   try
+   {
+      cline.parse_command_line();
+      for(std::string_view entry : cline.get_positional_stream('F', delimiter, capacity))
+      {
+         actual.emplace_back(entry);
+      }
+   }
+   catch(const cline_utils::cline_exception &e)
+   {
+      too_long = std::string::npos != std::string(e.what()).find("Entry longer than");
+      if(false == too_long)
+      {
+         fuzz_failure(std::string("files-from list failed: ") + e.what(), arguments);
+      }
+   }
+   catch(const std::exception &e)
+   {
+      fuzz_failure(std::string("files-from list threw a non cline_exception: ") + e.what(), arguments);
+   }
+
+   // An entry (with its '\r') as long as the buffer cannot be held with its delimiter
+   if(too_long != (longest >= capacity))
+   {
+      fuzz_failure("longest entry " + std::to_string(longest) + " bytes, buffer " + std::to_string(capacity) +
+                   (too_long ? ", rejected" : ", accepted"), arguments);
+   }
+   ++(too_long ? rejected_cases : parsed_cases);
+   if(false == too_long && actual != expected)
+   {
+      size_t first = 0;
+      while(first < actual.size() && first < expected.size() && actual[first] == expected[first]) ++first;
+      std::vector<std::string> entries = {(first < actual.size()) ? actual[first] : "(none)", (first < expected.size()) ? expected[first] : "(none)"};
+      fuzz_failure("files-from gave " + std::to_string(actual.size()) + " entries, split gives " + std::to_string(expected.size()) +
+                   "; entry " + std::to_string(first) + " read, then split:" + describe_arguments(entries), arguments);
+   }
+}
+
+/************************************************************************/
+/*
+* \brief Parse config text; the command line must win over it
+*
+*/
+static void run_config(uint8_t parameter, const std::string &text)
+{
+   memory_file config(text);
+   std::vector<std::string> arguments = {"cline_fuzz"};
+   if(parameter & 1)
+   {
+      arguments.push_back("--alpha=command line");
+   }
+
+   fuzz_values values;
+   cline_utils::ArgvBuilder argv;
+   for(const std::string &argument : arguments) argv.push_back(argument);
+   cline_utils::CommandLineParser cline(argv.argc(), argv.argv());
+   cline.add_options(make_fuzz_options(values));
+   cline.set_config_file(config.path());
+   arguments.push_back("(config " + config.path() + ")");
+   try
+   {
+      cline.parse_command_line();
+   }
+   catch(const cline_utils::cline_exception &)
+   {
+      ++rejected_cases;
+      return;
+   }
+   catch(const std::exception &e)
+   {
+      fuzz_failure(std::string("config parse threw a non cline_exception: ") + e.what(), arguments);
+   }
+
+   if((parameter & 1) && "command line" != values.alpha)
+   {
+      fuzz_failure("config value '" + values.alpha + "' replaced the command line value", arguments);
+   }
+   check_snapshot(cline, values, arguments);
+   ++parsed_cases;
+}
+
+/************************************************************************/
+/*
+* \brief Run one case
+*
+*/
+static void run_case(const uint8_t *data, size_t size)
+{
+   if(2 > size)
+   {
+      return;
+   }
+   opterr = 0; // getopt_long messages only clutter the output
+   const fuzz_mode mode = fuzz_mode(data[0] % mode_count);
+   const uint8_t parameter = data[1];
+   const std::string payload((const char *)data + 2, size - 2);
+
+   switch(mode)
+   {
+      case mode_argv:
+      {
+         std::vector<std::string> arguments = {"cline_fuzz"};
+         for(size_t first = 0; first <= payload.size() && 256 > arguments.size();)
+         {
+            size_t last = std::min(payload.find('\0', first), payload.size());
+            arguments.push_back(payload.substr(first, last - first));
+            first = last + 1;
+         }
+         run_arguments(arguments, parameter);
+         break;
+      }
+      case mode_response:
+      {
+         cline_utils::ArgvBuilder split;
+         try
+         {
+            split.push_back("cline_fuzz").append(payload);
+         }
+         catch(const cline_utils::cline_exception &)
+         {
+            return; // Unterminated quote
+         }
+         run_arguments(std::vector<std::string>(split.argv(), split.argv() + split.argc()), parameter);
+         break;
+      }
+      case mode_files_from:
+         run_files_from(parameter, payload);
+         break;
+
+      default:
+         run_config(parameter, payload);
+         break;
+   }
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+   run_case(data, size);
+   return(0);
+}
+
+#ifndef CLINE_FUZZ_LIBFUZZER
+
+/************************************************************************/
+/*
+* \brief Generated cases: arguments built from fragments that sit on the
+*        edges of getopt_long's rules, mixed with random bytes
+*
+*/
+class case_generator
+{
+   private:
+
+      std::mt19937_64 random;
+
+      size_t below(size_t limit) { return(std::uniform_int_distribution<size_t>(0, limit - 1)(this->random)); }
+
+      std::string noise(size_t length)
+      {
+         static const char alphabet[] = "abBgxvF-=:;, \t\r\n\"'\\#@";
+         std::string out;
+         for(size_t i = 0; i < length; ++i)
+         {
+            out += (0 == this->below(8)) ? char(this->below(256)) : alphabet[this->below(sizeof(alphabet) - 1)];
+         }
+         return(out);
+      }
+
+      std::string argument()
+      {
+         static const char *fragments[] =
+            {
+               "-", "--", "---", "-a", "-b", "-B", "-g", "-x", "-v", "-F", "-h", "-z", "-:", "-?", "-W",
+               "--alpha", "--alph", "--al", "--alpha=", "--alphabet", "--alphabet=", "--alphabetx", "--beta", "--beta=1",
+               "--be", "--gamma", "--gamma=", "--g", "--delta", "--delta=", "--d", "--x", "--x=1", "--verbose-level",
+               "--verbose-level=", "--verbose", "--v", "--files-from", "--=", "--=x", "-Bx", "-xB", "-Bxa", "-Bg",
+               "-bvalue", "-vv", "-aa", "--ALPHA", "value", "", "@file", "--help"
+            };
+         std::string out = fragments[this->below(sizeof(fragments) / sizeof(fragments[0]))];
+         switch(this->below(6))
+         {
+            case 0: out += this->noise(this->below(8)); break;
+            case 1: out = this->noise(1 + this->below(12)); break;
+            case 2: out += std::string(this->below(2) ? 1 + this->below(4096) : 1 + this->below(16), "xBa"[this->below(3)]); break;
+            default: break;
+         }
+         return(out);
+      }
+
+   public:
+
+      explicit case_generator(uint64_t seed) : random(seed) {}
+
+      std::string next()
+      {
+         const fuzz_mode mode = fuzz_mode(this->below(mode_count));
+         std::string out;
+         out += char(mode);
+         out += char(this->below(256));
+         const size_t count = this->below(12);
+         for(size_t i = 0; i < count; ++i)
+         {
+            switch(mode)
+            {
+               case mode_argv:
+                  out += this->argument();
+                  if(i + 1 < count) out += '\0';
+                  break;
+               case mode_response:
+                  out += (0 == this->below(4)) ? "'" + this->argument() + "'" : this->argument();
+                  out += (0 == this->below(8)) ? "\n" : " ";
+                  break;
+               case mode_files_from:
+                  out += this->noise(this->below(3) ? this->below(24) : this->below(600));
+                  out += "\n\n\r\0"[this->below(4)];
+                  break;
+               default:
+               {
+                  static const char *names[] = {"alpha", "alphabet", "beta", "gamma", "delta", "x", "verbose-level",
+                                                "files-from", "@include", "# comment", "unknown", ""};
+                  out += names[this->below(sizeof(names) / sizeof(names[0]))];
+                  out += (this->below(4)) ? " = " + this->noise(this->below(10)) : this->noise(this->below(3));
+                  out += "\n";
+                  break;
+               }
+            }
+         }
+         return(out);
+      }
+};
+
+static size_t heap_in_use()
+{
+#if defined(__GLIBC__) && (2 < __GLIBC__ || 33 <= __GLIBC_MINOR__)
+   return(mallinfo2().uordblks);
+#else
+   return(0);
+#endif
+}
+
+static void run_input(const std::string &input)
+{
+   current_data = (const uint8_t *)input.data();
+   current_size = input.size();
+   run_case(current_data, current_size);
+   current_data = NULL;
+}
+
+/************************************************************************/
+/*
+* \brief Run generated cases. The heap in use is sampled as cases run; it
+*        must level off once the first cases have warmed up caches and pools.
+*
+*/
+static int run_generated(size_t runs, uint64_t seed)
+{
+   case_generator generator(seed);
+   const size_t sample = 2000;
+   size_t baseline = 0;
+   auto start = std::chrono::steady_clock::now();
+   for(size_t run = 0; run < runs; ++run)
+   {
+      run_input(generator.next());
+      if(sample == run + 1)
+      {
+         baseline = heap_in_use();
+      }
+   }
+   const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+   const size_t in_use = heap_in_use();
+   if(runs >= 4 * sample && in_use > baseline + (size_t(1) << 20))
+   {
+      std::cerr << "cline_fuzz: heap in use grew from " << baseline << " to " << in_use << " bytes, likely a leak" << std::endl;
+      return(1);
+   }
+   std::cout << "cline_fuzz: " << runs << " generated cases (seed " << seed << ") in " << seconds << " s, "
+             << size_t(runs / seconds) << " cases/s, " << parsed_cases << " parsed, " << rejected_cases
+             << " rejected alike, heap in use " << in_use << " bytes" << std::endl;
+   return(0);
+}
+
+/************************************************************************/
+/*
+* \brief Run corpus files, or every regular file of corpus directories
+*
+*/
+static int run_corpus(const std::vector<std::string> &paths)
+{
+   size_t count = 0;
+   for(const std::string &path : paths)
+   {
+      std::vector<std::string> files;
+      struct stat info;
+      if(0 == stat(path.c_str(), &info) && S_ISDIR(info.st_mode))
+      {
+         DIR *dir = opendir(path.c_str());
+         for(struct dirent *entry; NULL != dir && NULL != (entry = readdir(dir));)
+         {
+            if('.' != entry->d_name[0]) files.push_back(path + "/" + entry->d_name);
+         }
+         if(NULL != dir) closedir(dir);
+         std::sort(files.begin(), files.end());
+      }
+      else
+      {
+         files.push_back(path);
+      }
+
+      for(const std::string &file : files)
+      {
+         std::ifstream in(file, std::ios::binary);
+         if(false == in.good())
+         {
+            std::cerr << "cline_fuzz: cannot read " << file << std::endl;
+            return(1);
+         }
+         std::stringstream content;
+         content << in.rdbuf();
+         run_input(content.str());
+         ++count;
+      }
+   }
+   std::cout << "cline_fuzz: " << count << " corpus inputs passed, " << parsed_cases << " parsed, " << rejected_cases
+             << " rejected alike" << std::endl;
+   return(0);
+}
+
+/************************************************************************/
+/*
+* \brief One throughput case: parsers per second over repeated parses of
+*        the same command line
+*
+*/
+struct bench_case
+{
+   std::string name;
+   std::vector<std::string> arguments;
+   size_t long_options;   /**< Options named long_option_prefix + index, all required_argument */
+   bool short_flags;      /**< Bool flags for every letter but 'h' and every digit */
+   bool expect_error;
+};
+
+static const std::string long_option_prefix = "a-rather-long-common-prefix-shared-by-every-generated-option-name-";
+static const std::string flag_characters = "abcdefgijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"; /**< 'h' is help */
+
+static double run_bench_case(const bench_case &c)
+{
+   std::vector<std::string> names;
+   std::vector<std::string> strings(c.long_options);
+   bool flags[64] = {};
+   std::vector<std::string> list;
+   std::string single;
+
+   std::vector<cline_utils::option_longer> options;
+   names.reserve(c.long_options + flag_characters.size()); // Options point at the names
+   for(size_t i = 0; i < c.long_options; ++i)
+   {
+      names.push_back(long_option_prefix + std::to_string(100000 + i));
+   }
+   for(size_t i = 0; i < c.long_options; ++i)
+   {
+      options.push_back(cline_utils::make_option(names[i].c_str(), 0x1000 + int(i), strings[i], " Generated"));
+   }
+   if(c.short_flags)
+   {
+      for(size_t i = 0; i < flag_characters.size(); ++i)
+      {
+         names.push_back("flag-" + flag_characters.substr(i, 1));
+      }
+      for(size_t i = 0; i < flag_characters.size(); ++i)
+      {
+         options.push_back(cline_utils::make_option(names[c.long_options + i].c_str(), flag_characters[i], flags[i], " Flag"));
+      }
+   }
+   else
+   {
+      options.push_back(cline_utils::make_option("list", 'l', list, " List"));
+      options.push_back(cline_utils::make_option("single", 's', single, " Single"));
+   }
+
+   cline_utils::ArgvBuilder argv;
+   for(const std::string &argument : c.arguments) argv.push_back(argument);
+   cline_utils::CommandLineParser cline(argv.argc(), argv.argv());
+   cline.add_options(options);
+   cline.set_positional_arity(0);
+
+   size_t parses = 0;
+   auto start = std::chrono::steady_clock::now();
+   double seconds = 0;
+   while(seconds < 0.25 || parses < 3)
+   {
+      std::string error;
+      try
+      {
+         cline.parse_command_line();
+      }
+      catch(const cline_utils::cline_exception &e)
+      {
+         error = e.what();
+      }
+      if(error.empty() == c.expect_error)
+      {
+         std::cerr << "cline_fuzz: bench case " << c.name << (error.empty() ? " parsed but should fail" : " failed to parse:\n" + error) << std::endl;
+         exit(1);
+      }
+      ++parses;
+      seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   }
+   return(parses / seconds);
+}
+
+/************************************************************************/
+/*
+* \brief Throughput on pathological command lines. With a baseline file
+*        ("name parses_per_second" lines from --save) a case slower than
+*        tolerance times its baseline fails the run.
+*
+*/
+static int run_bench(const std::string &baseline_file, const std::string &save_file, double tolerance)
+{
+   std::vector<bench_case> cases;
+
+   bench_case names{"long_option_names", {"tool"}, 512, false, false};
+   for(size_t i = 0; i < 512; ++i)
+   {
+      names.arguments.push_back("--" + long_option_prefix + std::to_string(100000 + i) + "=" + std::to_string(i));
+   }
+   cases.push_back(names);
+
+   bench_case abbreviated{"ambiguous_abbreviation", {"tool", "--" + long_option_prefix + "1"}, 512, false, true};
+   cases.push_back(abbreviated);
+
+   cases.push_back({"long_value", {"tool", "--single=" + std::string(1 << 20, 'v')}, 0, false, false});
+   cases.push_back({"long_unknown_option", {"tool", "--" + std::string(1 << 16, 'u')}, 0, false, true});
+
+   bench_case cluster{"deep_cluster", {"tool", "-" + flag_characters}, 0, true, false};
+   cases.push_back(cluster);
+   cases.push_back({"duplicate_in_cluster", {"tool", "-" + flag_characters + "a"}, 0, true, true});
+
+   bench_case repeated{"repeated_list_option", {"tool"}, 0, false, false};
+   for(size_t i = 0; i < 4096; ++i)
+   {
+      repeated.arguments.push_back((i % 2) ? "-l" + std::to_string(i) : "--list=" + std::to_string(i));
+   }
+   cases.push_back(repeated);
+
+   bench_case positional{"many_positionals", {"tool"}, 0, false, false};
+   for(size_t i = 0; i < 16384; ++i)
+   {
+      positional.arguments.push_back("input_" + std::to_string(i));
+   }
+   cases.push_back(positional);
+
+   std::map<std::string, double> baseline;
+   if(false == baseline_file.empty())
+   {
+      std::ifstream in(baseline_file);
+      std::string name;
+      double rate;
+      while(in >> name >> rate) baseline[name] = rate;
+   }
+
+   std::stringstream saved;
+   int status = 0;
+   bprinter::TablePrinter tp(&std::cout);
+   tp.AddColumn("Case", 24);
+   tp.AddColumn("Parses/s", 12);
+   tp.AddColumn("Baseline", 12);
+   tp.AddColumn("Ratio", 8);
+   tp.PrintHeader();
+   for(const bench_case &c : cases)
+   {
+      const double rate = run_bench_case(c);
+      saved << c.name << " " << rate << std::endl;
+      auto itr = baseline.find(c.name);
+      const double ratio = (itr != baseline.end()) ? rate / itr->second : 1.0;
+      tp << c.name << rate << ((itr != baseline.end()) ? itr->second : 0.0) << ratio;
+      if(ratio < tolerance)
+      {
+         status = 1;
+      }
+   }
+   tp.PrintFooter();
+
+   // A regression does not become the new baseline
+   if(false == save_file.empty() && (0 == status || save_file != baseline_file))
+   {
+      std::ofstream(save_file) << saved.str();
+   }
+   if(0 != status)
+   {
+      std::cerr << "cline_fuzz: throughput fell below " << tolerance << " of the baseline" << std::endl;
+   }
+   return(status);
+}
+
+/************************************************************************/
+/*
+* \brief Driver function for the standalone fuzz and stress runs
+*
+*     @param[in] int argc: Number of command line arguments
+*     @param[in] char **argv: [--runs N] [--seed S] | [--bench [--baseline F] [--save F] [--tolerance R]] | corpus...
+*     @return int: Success status
+*
+*/
+int main(int argc, char** argv)
+{
+   size_t runs = 0;
+   uint64_t seed = 1;
+   bool bench = false;
+   std::string baseline_file, save_file;
+   double tolerance = 0.5;
+   std::vector<std::string> corpus;
+
+   for(int i = 1; i < argc; ++i)
+   {
+      const std::string argument = argv[i];
+      const bool has_value = i + 1 < argc;
+      if("--runs" == argument && has_value)           runs = strtoull(argv[++i], NULL, 10);
+      else if("--seed" == argument && has_value)      seed = strtoull(argv[++i], NULL, 10);
+      else if("--bench" == argument)                  bench = true;
+      else if("--baseline" == argument && has_value)  baseline_file = argv[++i];
+      else if("--save" == argument && has_value)      save_file = argv[++i];
+      else if("--tolerance" == argument && has_value) tolerance = strtod(argv[++i], NULL);
+      else if('-' == argument[0])
+      {
+         std::cerr << "usage: " << argv[0] << " [--runs N] [--seed S] | [--bench [--baseline F] [--save F] [--tolerance R]] | corpus..." << std::endl;
+         return(2);
+      }
+      else corpus.push_back(argument);
+   }
+
+   if(bench)
+   {
+      return(run_bench(baseline_file, save_file, tolerance));
+   }
+   if(false == corpus.empty())
+   {
+      return(run_corpus(corpus));
+   }
+   return(run_generated((0 < runs) ? runs : 20000, seed));
+}
+
+#endif
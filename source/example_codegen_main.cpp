@@ -0,0 +1,37 @@
+// -----------------------------------------------------------------------
+//
+//                        example_codegen_main.cpp V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#include <iostream>
+
+#include "cline_utils.h"
+#include "example_options.h"
+
+int main(int argc, char** argv)
+{
+   std::cout << "-- BEGIN example_codegen_main --" << std::endl;
+
+   // Typed storage with the defaults declared in example_options.schema
+   example::values parameters;
+
+   cline_utils::CommandLineParser cline(argc, argv);
+   example::add_options(cline, parameters);
+
+   try
+   {
+      cline.parse_command_line();
+      cline.print_input_summary();
+   }
+   catch(const cline_utils::cline_exception& e)
+   {
+      std::cerr << e.what();
+      cline.print_usage();
+   }
+
+   std::cout << "-- END example_codegen_main --" << std::endl;
+   return(0);
+}
@@ -0,0 +1,42 @@
+// -----------------------------------------------------------------------
+//
+//                        example_embedded_main.cpp V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+// Built with -Os -fno-exceptions -fno-rtti: no heap, no iostreams, no exceptions
+#include "cline_embedded.h"
+
+int main(int argc, char** argv)
+{
+   int count = 1;
+   double scale = 1.0;
+   bool verbose = false;
+   const char *output = "out.txt";
+
+   cline_utils::embedded_parser<8, 4> cline;
+   cline.add_option("count"  , 'n', count  , "Number of repetitions");
+   cline.add_option("scale"  , 's', scale  , "Scale factor []");
+   cline.add_option("output" , 'o', output , "Output file", true);
+   cline.add_option("verbose", 'v', verbose, "Verbose output");
+
+   cline_utils::embedded_status status = cline.parse(argc, argv);
+   if(cline_utils::embedded_ok != status)
+   {
+      if(cline_utils::embedded_help != status)
+      {
+         cline.print_error();
+      }
+      cline.print_usage(argv[0]);
+      return((cline_utils::embedded_help == status) ? 0 : 2);
+   }
+
+   char number[32];
+   std::to_chars_result end = std::to_chars(number, number + sizeof(number), count * scale);
+
+   cline_utils::embedded_writer out(STDOUT_FILENO);
+   out.put(output).put(": ").put(number, end.ptr - number).put(verbose ? " (verbose)\n" : "\n");
+   return(0);
+}
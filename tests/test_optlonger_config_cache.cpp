@@ -0,0 +1,226 @@
+// -----------------------------------------------------------------------
+//
+//                    test_optlonger_config_cache.cpp V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#include <iostream>
+
+#define CATCH_CONFIG_RUNNER
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_session.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "cline_utils.h"
+
+// Cheesy global test variables to make things quicker.
+int _G_argc;
+char** _G_argv; //std::vector<std::string> Gargv;
+cline_utils::CommandLineParser *_G_cline;   
+
+/************************************************************************/
+/*
+* \brief Write a small config file, dated in the past so the cache accepts it
+* 
+*/
+static void write_config(const std::string &filename, const std::string &text, time_t age = 60)
+{
+   {
+      std::ofstream out(filename);
+      out << text;
+   }
+   struct timespec times[2];
+   clock_gettime(CLOCK_REALTIME, &times[0]);
+   times[0].tv_sec -= age;
+   times[1] = times[0];
+   utimensat(AT_FDCWD, filename.c_str(), times, 0);
+}
+
+struct cache_values
+{
+   double parameter1D = std::nan("1"),
+          parameter2D = 3.14;
+   int    verboseFlag = 0,
+          parameter3I = 100;
+   std::string parameter4S;
+   std::vector<std::string> positional; /**< Filled after the parse, not bound */
+   cline_utils::option_source source3 = cline_utils::source_default;
+};
+
+/************************************************************************/
+/*
+* \brief Parse a command line with a config file and a config cache
+*
+*     @return bool: True if the parse was loaded from the cache
+* 
+*/
+static bool parse_cached(const std::string &command_line, const std::string &config, const std::string &cache, cache_values &v)
+{
+   std::vector<cline_utils::option_longer> longer_options = 
+      {
+         {"verbose"  , no_argument      , NULL, 'v', optional_option, typeid(v.verboseFlag).name()       , &v.verboseFlag, " Verbose output"},
+         {"longName1", required_argument, NULL, 'a', required_option, typeid(v.parameter1D).name()       , &v.parameter1D, " Required option with required double argument [physical units]"},
+         {"longName2", required_argument, NULL, 'b', required_option, typeid(v.parameter2D).name()       , &v.parameter2D, " Required option with required double argument []"},
+         {"longName3", required_argument, NULL, 'c', optional_option, typeid(v.parameter3I).name()       , &v.parameter3I, " Optional option with a required integer arugment if used"},
+         {"longName4", required_argument, NULL, 'd', required_option, typeid(v.parameter4S.data()).name(), &v.parameter4S, " Required option with required string argument"},
+      };
+
+   cline_utils::ArgvBuilder arguments = cline_utils::ArgvBuilder::split(command_line);
+   cline_utils::CommandLineParser cline(arguments.argc(), arguments.argv());
+   cline.add_options(longer_options);
+   cline.set_positional_arity(0, 4);
+   cline.set_config_file(config);
+   cline.set_config_cache(cache, {"CLINE_CACHE_TEST"});
+   cline.parse_command_line();
+
+   for(const char *argument : cline.get_positional_arguments())
+   {
+      v.positional.push_back(argument);
+   }
+   v.source3 = cline.get_option_source('c');
+   return(cline.loaded_from_config_cache());
+}
+
+/************************************************************************/
+/*
+* \brief A repeated launch is served from the cache until argv, the named
+*        environment or a config file changes
+* 
+*/
+TEST_CASE("Config Cache","[MUSTPASS]")
+{
+   char directory[] = "/tmp/cline_cache_XXXXXX";
+   REQUIRE(NULL != mkdtemp(directory));
+   const std::string dir(directory);
+   const std::string config = dir + "/tool.conf";
+   const std::string include = dir + "/more.conf";
+   const std::string cache = dir + "/tool.cache";
+   unsetenv("CLINE_CACHE_TEST");
+
+   write_config(config, "longName1 = 2.5\nlongName3 = 7\n@include more.conf\n");
+   write_config(include, "longName4 = included.txt\n");
+
+   cache_values first;
+   REQUIRE(false == parse_cached("tool -b 4 in1 in2", config, cache, first));
+   REQUIRE(0 == access(cache.c_str(), R_OK));
+
+   cache_values second;
+   REQUIRE(parse_cached("tool -b 4 in1 in2", config, cache, second));
+   REQUIRE(2.5 == second.parameter1D);
+   REQUIRE(4 == second.parameter2D);
+   REQUIRE(7 == second.parameter3I);
+   REQUIRE("included.txt" == second.parameter4S);
+   REQUIRE((std::vector<std::string>{"in1", "in2"}) == second.positional);
+   REQUIRE(cline_utils::source_config_file == second.source3);
+
+   // Every parse starts from fresh values, as a new process would (the bound
+   // values before the parse are part of the key). Other arguments are
+   // another key, and replace the cached record
+   cache_values other;
+   REQUIRE(false == parse_cached("tool -b 5 -c 1", config, cache, other));
+   REQUIRE(1 == other.parameter3I);
+   REQUIRE(other.positional.empty());
+   cache_values other_again;
+   REQUIRE(parse_cached("tool -b 5 -c 1", config, cache, other_again));
+
+   // An included file changes
+   write_config(include, "longName4 = changed.txt\n", 30);
+   cache_values changed;
+   REQUIRE(false == parse_cached("tool -b 5 -c 1", config, cache, changed));
+   REQUIRE("changed.txt" == changed.parameter4S);
+   cache_values changed_again;
+   REQUIRE(parse_cached("tool -b 5 -c 1", config, cache, changed_again));
+   REQUIRE("changed.txt" == changed_again.parameter4S);
+
+   // The environment named in the key changes
+   setenv("CLINE_CACHE_TEST", "1", 1);
+   cache_values environment;
+   REQUIRE(false == parse_cached("tool -b 5 -c 1", config, cache, environment));
+   cache_values environment_again;
+   REQUIRE(parse_cached("tool -b 5 -c 1", config, cache, environment_again));
+   unsetenv("CLINE_CACHE_TEST");
+
+   // A config file modified in the tick of the parse is not cached
+   {
+      std::ofstream out(config, std::ios::app);
+      out << "longName3 = 8\n";
+   }
+   cache_values fresh;
+   REQUIRE(false == parse_cached("tool -b 5", config, cache, fresh));
+   REQUIRE(8 == fresh.parameter3I);
+   write_config(config, "longName1 = 2.5\nlongName3 = 8\n@include more.conf\n", 10);
+   cache_values rewritten, rewritten_again;
+   REQUIRE(false == parse_cached("tool -b 5", config, cache, rewritten));
+   REQUIRE(parse_cached("tool -b 5", config, cache, rewritten_again));
+
+   // A corrupt record is a miss and gets replaced
+   {
+      std::fstream out(cache, std::ios::in | std::ios::out | std::ios::binary);
+      out.seekp(40);
+      out.put('\x5a');
+   }
+   cache_values corrupt;
+   REQUIRE(false == parse_cached("tool -b 5", config, cache, corrupt));
+   REQUIRE(8 == corrupt.parameter3I);
+   cache_values corrupt_again;
+   REQUIRE(parse_cached("tool -b 5", config, cache, corrupt_again));
+
+   // Errors still come from a full parse
+   cache_values invalid;
+   REQUIRE_THROWS_WITH(parse_cached("tool -c 1", config, cache, invalid), Catch::Matchers::ContainsSubstring("Missing required option"));
+
+   for(const std::string &name : {config, include, cache})
+   {
+      unlink(name.c_str());
+   }
+   rmdir(directory);
+}
+
+/************************************************************************/
+/*
+* \brief Driver function for Catch2 tests. Not clear to me how to use
+*        Catch::Session().run() with LONG command line arguments... 
+*        so quick hack using globals
+*
+*     @param[in] int argc: Integer variable storing number of command line arguments (including executable name)    
+*     @param[in] char **argv: Array of character pointers listing all the arguments    
+*     @return int: Success status
+* 
+*/
+int runCatchTests(int argc, char* const argv[])
+{
+   //std::cout << "-- BEGIN runCatchTests --" << std::endl;
+
+   // Owned, NULL terminated copy of the arguments in one allocation
+   cline_utils::ArgvBuilder arguments(argc, argv);
+   _G_argc = arguments.argc();
+   _G_argv = arguments.argv();
+
+   // Creat the command line parser
+   _G_cline = new cline_utils::CommandLineParser(_G_argc, _G_argv);
+
+   // Call potential tests
+   int result = Catch::Session().run();
+
+   // Clean up memory
+   delete _G_cline;
+
+   //std::cout << "-- END runCatchTests --" << std::endl;
+
+   // Return to main
+   return result;
+}
+
+/************************************************************************/
+/*
+* \brief Main function not built into Catch2...
+*
+*     @return int.
+* 
+*/
+int main(int argc, char* const argv[])
+{
+   return runCatchTests(argc, argv);
+}
\ No newline at end of file
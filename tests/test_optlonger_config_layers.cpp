@@ -0,0 +1,222 @@
+// -----------------------------------------------------------------------
+//
+//                    test_optlonger_config_layers.cpp V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#include <iostream>
+
+#define CATCH_CONFIG_RUNNER
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_session.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "cline_utils.h"
+
+// Cheesy global test variables to make things quicker.
+int _G_argc;
+char** _G_argv; //std::vector<std::string> Gargv;
+cline_utils::CommandLineParser *_G_cline;   
+
+/************************************************************************/
+/*
+* \brief Write a small config file
+* 
+*/
+static void write_config(const std::string &filename, const std::string &text)
+{
+   std::ofstream out(filename);
+   out << text;
+}
+
+struct layer_values
+{
+   double parameter1D = std::nan("1"),
+          parameter2D = 3.14;
+   int    verboseFlag = 0,
+          parameter3I = 100;
+   std::string parameter4S;
+};
+
+/************************************************************************/
+/*
+* \brief Parse a command line with the given config layers
+* 
+*/
+static void parse_with_layers(const std::string &command_line, const std::vector<std::pair<std::string, bool>> &layers,
+                              const std::string &top, bool io_uring, layer_values &v,
+                              cline_utils::file_batch::backend_kind *backend = NULL)
+{
+   std::vector<cline_utils::option_longer> longer_options = 
+      {
+         {"verbose"  , no_argument      , NULL, 'v', optional_option, typeid(v.verboseFlag).name()       , &v.verboseFlag, " Verbose output"},
+         {"longName1", required_argument, NULL, 'a', required_option, typeid(v.parameter1D).name()       , &v.parameter1D, " Required option with required double argument [physical units]"},
+         {"longName2", required_argument, NULL, 'b', required_option, typeid(v.parameter2D).name()       , &v.parameter2D, " Required option with required double argument []"},
+         {"longName3", required_argument, NULL, 'c', optional_option, typeid(v.parameter3I).name()       , &v.parameter3I, " Optional option with a required integer arugment if used"},
+         {"longName4", required_argument, NULL, 'd', required_option, typeid(v.parameter4S.data()).name(), &v.parameter4S, " Required option with required string argument"},
+      };
+
+   cline_utils::ArgvBuilder arguments = cline_utils::ArgvBuilder::split(command_line);
+   cline_utils::CommandLineParser cline(arguments.argc(), arguments.argv());
+   cline.add_options(longer_options);
+   for(const auto &layer : layers)
+   {
+      cline.add_config_layer(layer.first, layer.second);
+   }
+   if(false == top.empty())
+   {
+      cline.set_config_file(top);
+   }
+   cline.set_io_uring_enabled(io_uring);
+   cline.parse_command_line();
+   if(NULL != backend)
+   {
+      *backend = cline.get_config_backend();
+   }
+}
+
+/************************************************************************/
+/*
+* \brief Later layers override earlier ones, the command line overrides all
+* 
+*/
+TEST_CASE("Layered Config Files","[MUSTPASS]")
+{
+   char directory[] = "/tmp/cline_layers_XXXXXX";
+   REQUIRE(NULL != mkdtemp(directory));
+   const std::string dir(directory);
+   mkdir((dir + "/conf.d").c_str(), 0700);
+
+   write_config(dir + "/site.conf", "longName1 = 1\nlongName3 = 1\nlongName4 = site.txt\n");
+   write_config(dir + "/project.conf", "# project\nlongName3 = 2\n@include conf.d/extra.conf\n");
+   write_config(dir + "/conf.d/extra.conf", "longName4 = \"extra file.txt\"\n");
+   write_config(dir + "/user.conf", "verbose\nlongName3 = 3\n");
+
+   const std::vector<std::pair<std::string, bool>> layers =
+      {
+         {dir + "/site.conf", false},
+         {dir + "/project.conf", false},
+         {dir + "/missing.conf", true},
+      };
+
+   for(bool io_uring : {true, false})
+   {
+      layer_values v;
+      cline_utils::file_batch::backend_kind backend;
+      parse_with_layers("tool -b 4", layers, dir + "/user.conf", io_uring, v, &backend);
+      REQUIRE(1 == v.parameter1D);
+      REQUIRE(4 == v.parameter2D);
+      REQUIRE(3 == v.parameter3I);
+      REQUIRE(1 == v.verboseFlag);
+      REQUIRE("extra file.txt" == v.parameter4S);
+      if(false == io_uring)
+      {
+         REQUIRE(cline_utils::file_batch::backend_thread_pool == backend);
+      }
+
+      layer_values w;
+      parse_with_layers("tool -b 4 -c 9 -d cli.txt", layers, "", io_uring, w);
+      REQUIRE(9 == w.parameter3I);
+      REQUIRE("cli.txt" == w.parameter4S);
+      REQUIRE(0 == w.verboseFlag);
+   }
+
+   // A missing layer that is not optional, an include cycle, an unknown option
+   layer_values v;
+   REQUIRE_THROWS_WITH(parse_with_layers("tool -b 4", {{dir + "/absent.conf", false}}, "", true, v),
+                       Catch::Matchers::ContainsSubstring("Unable to open config file"));
+
+   write_config(dir + "/a.conf", "longName3 = 1\n@include b.conf\n");
+   write_config(dir + "/b.conf", "@include a.conf\n");
+   REQUIRE_THROWS_WITH(parse_with_layers("tool -b 4 -a 1 -d x", {{dir + "/a.conf", false}}, "", true, v),
+                       Catch::Matchers::ContainsSubstring("Config include cycle"));
+
+   write_config(dir + "/bad.conf", "longName3 = 1\nnoSuchOption = 2\n");
+   REQUIRE_THROWS_WITH(parse_with_layers("tool -b 4 -a 1 -d x", {{dir + "/site.conf", false}}, dir + "/bad.conf", false, v),
+                       Catch::Matchers::ContainsSubstring("bad.conf:2: Unknown option 'noSuchOption'"));
+
+   for(const char *name : {"site.conf", "project.conf", "conf.d/extra.conf", "user.conf", "a.conf", "b.conf", "bad.conf"})
+   {
+      unlink((dir + "/" + name).c_str());
+   }
+   rmdir((dir + "/conf.d").c_str());
+   rmdir(directory);
+}
+
+/************************************************************************/
+/*
+* \brief A layer that arrives slowly (a FIFO written after a delay) does not
+*        hold up the tokenizing of argv, and is still merged
+* 
+*/
+TEST_CASE("Slow Config Layer","[MUSTPASS]")
+{
+   char directory[] = "/tmp/cline_layers_XXXXXX";
+   REQUIRE(NULL != mkdtemp(directory));
+   const std::string fifo = std::string(directory) + "/slow.conf";
+   REQUIRE(0 == mkfifo(fifo.c_str(), 0600));
+
+   std::thread writer([&fifo]()
+      {
+         std::this_thread::sleep_for(std::chrono::milliseconds(50));
+         std::ofstream out(fifo);
+         out << "longName3 = 42\n";
+      });
+
+   layer_values v;
+   parse_with_layers("tool -b 4 -a 1 -d x", {{fifo, false}}, "", true, v);
+   writer.join();
+   REQUIRE(42 == v.parameter3I);
+
+   unlink(fifo.c_str());
+   rmdir(directory);
+}
+
+/************************************************************************/
+/*
+* \brief Driver function for Catch2 tests. Not clear to me how to use
+*        Catch::Session().run() with LONG command line arguments... 
+*        so quick hack using globals
+*
+*     @param[in] int argc: Integer variable storing number of command line arguments (including executable name)    
+*     @param[in] char **argv: Array of character pointers listing all the arguments    
+*     @return int: Success status
+* 
+*/
+int runCatchTests(int argc, char* const argv[])
+{
+   //std::cout << "-- BEGIN runCatchTests --" << std::endl;
+
+   // Owned, NULL terminated copy of the arguments in one allocation
+   cline_utils::ArgvBuilder arguments(argc, argv);
+   _G_argc = arguments.argc();
+   _G_argv = arguments.argv();
+
+   // Creat the command line parser
+   _G_cline = new cline_utils::CommandLineParser(_G_argc, _G_argv);
+
+   // Call potential tests
+   int result = Catch::Session().run();
+
+   // Clean up memory
+   delete _G_cline;
+
+   //std::cout << "-- END runCatchTests --" << std::endl;
+
+   // Return to main
+   return result;
+}
+
+/************************************************************************/
+/*
+* \brief Main function not built into Catch2...
+*
+*     @return int.
+* 
+*/
+int main(int argc, char* const argv[])
+{
+   return runCatchTests(argc, argv);
+}
\ No newline at end of file
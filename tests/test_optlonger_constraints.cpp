@@ -0,0 +1,117 @@
+// -----------------------------------------------------------------------
+//
+//                     test_optlonger_constraints.cpp V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#include <iostream>
+
+#define CATCH_CONFIG_RUNNER
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_session.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "cline_utils.h"
+
+// Cheesy global test variables to make things quicker.
+int _G_argc;
+char** _G_argv; //std::vector<std::string> Gargv;
+cline_utils::CommandLineParser *_G_cline;   
+
+/************************************************************************/
+/*
+* \brief All constraint violations are reported together
+* 
+*/
+TEST_CASE("Constraint Violations","[MUSTFAIL]")
+{
+   double parameter1D = std::nan("1"),
+          parameter2D = 3.14;
+
+   int helpFlag    = 0,
+       parameter3I = 100;
+
+   std::string parameter4S("");
+
+   typedef cline_utils::option_constraint oc;
+
+   std::vector<cline_utils::option_longer> longer_options = 
+      {
+         {"help"     , no_argument      , NULL, 'h', optional_option, typeid(helpFlag).name()          , &helpFlag   , " Optional help option that must be h"},
+         {"longName1", required_argument, NULL, 'a', required_option, typeid(parameter1D).name()       , &parameter1D, " Required option with required double argument [physical units]",
+          {oc::between(0.0, 1.0)}},
+         {"longName2", required_argument, NULL, 'b', required_option, typeid(parameter2D).name()       , &parameter2D, " Required option with required double argument []",
+          {oc::positive()}},
+         {"longName3", required_argument, NULL, 'c', optional_option, typeid(parameter3I).name()       , &parameter3I, " Optional option with a required integer arugment if used",
+          {oc::one_of({"1", "2", "3"})}},
+         {"longName4", required_argument, NULL, 'd', required_option, typeid(parameter4S.data()).name(), &parameter4S, " Required option with required string argument",
+          {oc::chars(oc::chars_identifier), oc::max(16)}},
+      };
+
+   _G_cline->add_options(longer_options);
+   _G_cline->add_cross_constraint([&]{ return parameter1D < parameter2D; }, "longName1 must be smaller than longName2");
+
+   REQUIRE_THROWS_WITH(_G_cline->parse_command_line(), Catch::Matchers::ContainsSubstring("3 constraint violation(s)"));
+   REQUIRE_THROWS_WITH(_G_cline->check_constraints(), Catch::Matchers::ContainsSubstring("--longName1 (-a): value 5 is above maximum 1"));
+   REQUIRE_THROWS_WITH(_G_cline->check_constraints(), Catch::Matchers::ContainsSubstring("contains invalid character '.'"));
+   REQUIRE_THROWS_WITH(_G_cline->check_constraints(), Catch::Matchers::ContainsSubstring("longName1 must be smaller than longName2"));
+
+   parameter1D = 0.5;
+   parameter4S = "hello_txt";
+   REQUIRE_NOTHROW(_G_cline->check_constraints());
+
+   parameter3I = 7;
+   REQUIRE_THROWS_WITH(_G_cline->check_constraints(), Catch::Matchers::ContainsSubstring("1 constraint violation(s)"));
+
+   _G_cline->delete_all_options();
+   REQUIRE_NOTHROW(_G_cline->check_constraints());
+}
+
+/************************************************************************/
+/*
+* \brief Driver function for Catch2 tests. Not clear to me how to use
+*        Catch::Session().run() with LONG command line arguments... 
+*        so quick hack using globals
+*
+*     @param[in] int argc: Integer variable storing number of command line arguments (including executable name)    
+*     @param[in] char **argv: Array of character pointers listing all the arguments    
+*     @return int: Success status
+* 
+*/
+int runCatchTests(int argc, char* const argv[])
+{
+   //std::cout << "-- BEGIN runCatchTests --" << std::endl;
+
+   // Owned, NULL terminated copy of the arguments in one allocation
+   cline_utils::ArgvBuilder arguments(argc, argv);
+   _G_argc = arguments.argc();
+   _G_argv = arguments.argv();
+
+   // Creat the command line parser
+   _G_cline = new cline_utils::CommandLineParser(_G_argc, _G_argv);
+
+   // Call potential tests
+   int result = Catch::Session().run();
+
+   // Clean up memory
+   delete _G_cline;
+
+   //std::cout << "-- END runCatchTests --" << std::endl;
+
+   // Return to main
+   return result;
+}
+
+/************************************************************************/
+/*
+* \brief Main function not built into Catch2...
+*
+*     @return int.
+* 
+*/
+int main(int argc, char* const argv[])
+{
+   return runCatchTests(argc, argv);
+}
\ No newline at end of file
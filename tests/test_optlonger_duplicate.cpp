@@ -89,6 +89,53 @@ TEST_CASE("Duplicate Config Short Option","[MUSTFAIL]")
    //std::cout << "-- END Duplicate Config Option Test --" << std::endl;
 }
 
+/************************************************************************/
+/*
+* \brief Generated tables skip the duplicate check, so they are only accepted
+*        for exactly the options they were generated for
+* 
+*/
+TEST_CASE("Static Tables Must Match","[MUSTPASS]")
+{
+   int parameterA = 0,
+       parameterB = 0,
+       parameterC = 0;
+
+   // As cline_codegen would emit them for --alpha/-a and --beta/-b
+   static const option getopt_table[] = {{"alpha", required_argument, NULL, 'a'}, {"beta", required_argument, NULL, 'b'}, {NULL, 0, NULL, 0}};
+   static int16_t short_index[256];
+   std::fill(short_index, short_index + 256, -1);
+   short_index['a'] = 0;
+   short_index['b'] = 1;
+   static const cline_utils::static_option_tables tables = {"-:a:b:", getopt_table, short_index, "usage\n", 2};
+
+   cline_utils::ArgvBuilder arguments{"tool", "-a", "1", "-c", "7"};
+   cline_utils::CommandLineParser stale(arguments.argc(), arguments.argv());
+   stale.add_option({"alpha", required_argument, NULL, 'a', optional_option, typeid(parameterA).name(), &parameterA, " Alpha"});
+   stale.add_option({"gamma", required_argument, NULL, 'c', optional_option, typeid(parameterC).name(), &parameterC, " Gamma"});
+   REQUIRE_THROWS_WITH(stale.set_static_tables(tables), Catch::Matchers::ContainsSubstring("do not match the configured options at --gamma"));
+   stale.parse_command_line();
+   REQUIRE(7 == parameterC);
+
+   cline_utils::CommandLineParser flags(arguments.argc(), arguments.argv());
+   flags.add_option({"alpha", required_argument, NULL, 'a', optional_option, typeid(parameterA).name(), &parameterA, " Alpha"});
+   flags.add_option({"beta", no_argument, NULL, 'b', optional_option, typeid(parameterB).name(), &parameterB, " Beta"});
+   REQUIRE_THROWS_WITH(flags.set_static_tables(tables), Catch::Matchers::ContainsSubstring("at --beta"));
+
+   // Matching tables are used until the options change
+   cline_utils::ArgvBuilder matching_arguments{"tool", "-a", "1", "--beta=2"};
+   cline_utils::CommandLineParser matching(matching_arguments.argc(), matching_arguments.argv());
+   matching.add_option({"alpha", required_argument, NULL, 'a', optional_option, typeid(parameterA).name(), &parameterA, " Alpha"});
+   matching.add_option({"beta", required_argument, NULL, 'b', optional_option, typeid(parameterB).name(), &parameterB, " Beta"});
+   matching.set_static_tables(tables);
+   REQUIRE(matching.use_static_tables());
+   matching.add_option({"gamma", required_argument, NULL, 'c', optional_option, typeid(parameterC).name(), &parameterC, " Gamma"});
+   REQUIRE(false == matching.use_static_tables());
+   matching.parse_command_line();
+   REQUIRE(1 == parameterA);
+   REQUIRE(2 == parameterB);
+}
+
 /************************************************************************/
 /*
 * \brief Driver function for Catch2 tests. Not clear to me how to use
@@ -104,19 +151,10 @@ int runCatchTests(int argc, char* const argv[])
 {
    //std::cout << "-- BEGIN runCatchTests --" << std::endl;
 
-   _G_argc = argc;
-
-   // Allocate memory and copy strings
-   // std::copy(argv + 1, argv + Gargc, std::back_inserter(Gargv));
-   _G_argv = new char*[(_G_argc + 1) * sizeof * _G_argv];
-   for(size_t i = 0; i < _G_argc; ++i)
-   {
-      size_t slength = strlen(argv[i]) + 1;
-      //std::cout << slength << std::endl;
-      _G_argv[i] = new char[slength];
-      memcpy(_G_argv[i], argv[i], slength);
-   }
-   _G_argv[_G_argc] = NULL; // Must be NULL terminated
+   // Owned, NULL terminated copy of the arguments in one allocation
+   cline_utils::ArgvBuilder arguments(argc, argv);
+   _G_argc = arguments.argc();
+   _G_argv = arguments.argv();
 
    // Creat the command line parser
    _G_cline = new cline_utils::CommandLineParser(_G_argc, _G_argv);
@@ -125,12 +163,6 @@ int runCatchTests(int argc, char* const argv[])
    int result = Catch::Session().run();
 
    // Clean up memory
-   for(size_t i = 0; i < _G_argc; ++i)
-   {
-      delete[] _G_argv[i];
-   }
-   delete[] _G_argv;
-
    delete _G_cline;
 
    //std::cout << "-- END runCatchTests --" << std::endl;
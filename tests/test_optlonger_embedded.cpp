@@ -0,0 +1,201 @@
+// -----------------------------------------------------------------------
+//
+//                      test_optlonger_embedded.cpp V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#include <iostream>
+
+#define CATCH_CONFIG_RUNNER
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_session.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "cline_utils.h"
+#include "cline_embedded.h"
+
+// Cheesy global test variables to make things quicker.
+int _G_argc;
+char** _G_argv; //std::vector<std::string> Gargv;
+cline_utils::CommandLineParser *_G_cline;   
+
+struct embedded_values
+{
+   int count = 1;
+   long long total = 0;
+   double scale = 1.0;
+   bool verbose = false;
+   const char *output = "out.txt";
+};
+
+typedef cline_utils::embedded_parser<5, 2> small_parser;
+
+static void add_embedded_options(small_parser &cline, embedded_values &v)
+{
+   REQUIRE(cline_utils::embedded_ok == cline.add_option("count", 'n', v.count, "Number of repetitions"));
+   REQUIRE(cline_utils::embedded_ok == cline.add_option("total", '\0', v.total, "Long only 64 bit total"));
+   REQUIRE(cline_utils::embedded_ok == cline.add_option("scale", 's', v.scale, "Scale factor"));
+   REQUIRE(cline_utils::embedded_ok == cline.add_option("verbose", 'v', v.verbose, "Verbose output"));
+   REQUIRE(cline_utils::embedded_ok == cline.add_option("output", 'o', v.output, "Output file", true));
+}
+
+static cline_utils::embedded_status parse_embedded(const std::string &command_line, embedded_values &v, small_parser &cline)
+{
+   static cline_utils::ArgvBuilder arguments{"tool"};
+   arguments = cline_utils::ArgvBuilder::split(command_line);
+   add_embedded_options(cline, v);
+   return(cline.parse(arguments.argc(), arguments.argv()));
+}
+
+/************************************************************************/
+/*
+* \brief Short clusters, long forms, positionals and "--"
+* 
+*/
+TEST_CASE("Embedded Parse","[MUSTPASS]")
+{
+   embedded_values v;
+   small_parser cline;
+   REQUIRE(cline_utils::embedded_ok == parse_embedded("tool -vn3 --scale=2.5 --total 9000000000 -o x.txt in -- -lit", v, cline));
+   REQUIRE(3 == v.count);
+   REQUIRE(9000000000LL == v.total);
+   REQUIRE(2.5 == v.scale);
+   REQUIRE(v.verbose);
+   REQUIRE(std::string("x.txt") == v.output);
+   REQUIRE(2 == cline.positional_size());
+   REQUIRE(std::string("in") == cline.positional(0));
+   REQUIRE(std::string("-lit") == cline.positional(1));
+   REQUIRE(cline.given("scale"));
+   REQUIRE(false == cline.given("nope"));
+
+   embedded_values w;
+   small_parser other;
+   REQUIRE(cline_utils::embedded_ok == parse_embedded("tool -o y -n 7", w, other));
+   REQUIRE(7 == w.count);
+   REQUIRE(1.0 == w.scale);
+   REQUIRE(false == w.verbose);
+}
+
+/************************************************************************/
+/*
+* \brief Every error is a status code; bound values keep their defaults
+* 
+*/
+TEST_CASE("Embedded Errors","[MUSTPASS]")
+{
+   const std::vector<std::pair<std::string, cline_utils::embedded_status>> rows =
+      {
+         {"tool -n", cline_utils::embedded_missing_argument},
+         {"tool -o x --count=12x", cline_utils::embedded_bad_value},
+         {"tool -o x -n 99999999999", cline_utils::embedded_bad_value},
+         {"tool -o x --scale=", cline_utils::embedded_bad_value},
+         {"tool -o x -q", cline_utils::embedded_unknown_option},
+         {"tool -o x --quiet=1", cline_utils::embedded_unknown_option},
+         {"tool -o x --verbose=1", cline_utils::embedded_unexpected_argument},
+         {"tool -o x -n 1 -n 2", cline_utils::embedded_duplicate_option},
+         {"tool -n 1", cline_utils::embedded_missing_required},
+         {"tool -o x a b c", cline_utils::embedded_too_many_positionals},
+         {"tool --help", cline_utils::embedded_help},
+         {"tool -vh", cline_utils::embedded_help},
+      };
+   for(const auto &row : rows)
+   {
+      embedded_values v;
+      small_parser cline;
+      INFO(row.first);
+      REQUIRE(row.second == parse_embedded(row.first, v, cline));
+      REQUIRE(row.second == cline.status());
+      REQUIRE(1 == v.count);
+   }
+
+   // Configuration errors
+   embedded_values v;
+   small_parser cline;
+   add_embedded_options(cline, v);
+   int extra = 0;
+   REQUIRE(cline_utils::embedded_too_many_options == cline.add_option("extra", 'x', extra, ""));
+   cline_utils::embedded_parser<4> roomy;
+   REQUIRE(cline_utils::embedded_ok == roomy.add_option("count", 'n', extra, ""));
+   REQUIRE(cline_utils::embedded_duplicate_name == roomy.add_option("other", 'n', extra, ""));
+   REQUIRE(cline_utils::embedded_duplicate_name == roomy.add_option("count", 'c', extra, ""));
+}
+
+/************************************************************************/
+/*
+* \brief Usage and error text are written to a descriptor
+* 
+*/
+TEST_CASE("Embedded Messages","[MUSTPASS]")
+{
+   embedded_values v;
+   small_parser cline;
+   REQUIRE(cline_utils::embedded_unknown_option == parse_embedded("tool -o x --quiet=1", v, cline));
+
+   int pipe_fds[2];
+   REQUIRE(0 == pipe(pipe_fds));
+   cline.print_error(pipe_fds[1]);
+   cline.print_usage("tool", pipe_fds[1]);
+   close(pipe_fds[1]);
+
+   std::string text;
+   char buffer[512];
+   for(ssize_t bytes; 0 < (bytes = read(pipe_fds[0], buffer, sizeof(buffer)));)
+   {
+      text.append(buffer, bytes);
+   }
+   close(pipe_fds[0]);
+
+   REQUIRE(0 == text.find("error: unknown option '--quiet'\nusage: tool [options] [arguments]\n"));
+   REQUIRE(std::string::npos != text.find("  -n, --count <int>"));
+   REQUIRE(std::string::npos != text.find("      --total <int>"));
+   REQUIRE(std::string::npos != text.find("(required) Output file\n"));
+}
+
+/************************************************************************/
+/*
+* \brief Driver function for Catch2 tests. Not clear to me how to use
+*        Catch::Session().run() with LONG command line arguments... 
+*        so quick hack using globals
+*
+*     @param[in] int argc: Integer variable storing number of command line arguments (including executable name)    
+*     @param[in] char **argv: Array of character pointers listing all the arguments    
+*     @return int: Success status
+* 
+*/
+int runCatchTests(int argc, char* const argv[])
+{
+   //std::cout << "-- BEGIN runCatchTests --" << std::endl;
+
+   // Owned, NULL terminated copy of the arguments in one allocation
+   cline_utils::ArgvBuilder arguments(argc, argv);
+   _G_argc = arguments.argc();
+   _G_argv = arguments.argv();
+
+   // Creat the command line parser
+   _G_cline = new cline_utils::CommandLineParser(_G_argc, _G_argv);
+
+   // Call potential tests
+   int result = Catch::Session().run();
+
+   // Clean up memory
+   delete _G_cline;
+
+   //std::cout << "-- END runCatchTests --" << std::endl;
+
+   // Return to main
+   return result;
+}
+
+/************************************************************************/
+/*
+* \brief Main function not built into Catch2...
+*
+*     @return int.
+* 
+*/
+int main(int argc, char* const argv[])
+{
+   return runCatchTests(argc, argv);
+}
\ No newline at end of file
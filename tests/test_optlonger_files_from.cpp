@@ -0,0 +1,232 @@
+// -----------------------------------------------------------------------
+//
+//                     test_optlonger_files_from.cpp V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#include <iostream>
+
+#define CATCH_CONFIG_RUNNER
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_session.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "cline_utils.h"
+
+// Cheesy global test variables to make things quicker.
+int _G_argc;
+char** _G_argv; //std::vector<std::string> Gargv;
+cline_utils::CommandLineParser *_G_cline;   
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/************************************************************************/
+/*
+* \brief Entries arrive while the producer is still writing
+* 
+*/
+TEST_CASE("Files From Pipe","[MUSTPASS]")
+{
+   int fds[2];
+   REQUIRE(0 == pipe(fds));
+
+   std::mutex mutex;
+   std::condition_variable seen;
+   bool first_seen = false;
+   bool waited_out = false;
+
+   std::thread producer([&]()
+      {
+         REQUIRE(6 == write(fds[1], "a.h5\r\n", 6));
+         {
+            // The rest is only written once the consumer has the first entry
+            std::unique_lock<std::mutex> lock(mutex);
+            waited_out = false == seen.wait_for(lock, std::chrono::seconds(10), [&] { return(first_seen); });
+         }
+         const char rest[] = "\nb.h5\nc d.h5";
+         REQUIRE(sizeof(rest) - 1 == write(fds[1], rest, sizeof(rest) - 1));
+         close(fds[1]);
+      });
+
+   std::vector<std::string> entries;
+   cline_utils::files_from_reader reader(fds[0]);
+   for(std::string_view entry : reader)
+   {
+      entries.emplace_back(entry);
+      std::lock_guard<std::mutex> lock(mutex);
+      first_seen = true;
+      seen.notify_all();
+   }
+   producer.join();
+   close(fds[0]);
+
+   REQUIRE(false == waited_out);
+   REQUIRE((std::vector<std::string>{"a.h5", "b.h5", "c d.h5"} == entries));
+   REQUIRE(3 == reader.count());
+}
+
+/************************************************************************/
+/*
+* \brief A long list streams through a small buffer
+* 
+*/
+TEST_CASE("Files From Bounded Buffer","[MUSTPASS]")
+{
+   int fds[2];
+   REQUIRE(0 == pipe(fds));
+
+   const size_t total = 200000;
+   std::thread producer([&]()
+      {
+         // NUL delimited, names may hold newlines
+         std::string chunk;
+         for(size_t i = 0; i < total; ++i)
+         {
+            chunk += "run/\nshot_" + std::to_string(i);
+            chunk += '\0';
+            if(4096 < chunk.size() || i + 1 == total)
+            {
+               for(size_t done = 0; done < chunk.size();)
+               {
+                  ssize_t n = write(fds[1], chunk.data() + done, chunk.size() - done);
+                  REQUIRE(0 < n);
+                  done += n;
+               }
+               chunk.clear();
+            }
+         }
+         close(fds[1]);
+      });
+
+   cline_utils::files_from_reader reader(fds[0], '\0', 256);
+   size_t count = 0;
+   bool in_order = true;
+   for(std::string_view entry : reader)
+   {
+      in_order = in_order && ("run/\nshot_" + std::to_string(count) == entry);
+      ++count;
+   }
+   producer.join();
+   close(fds[0]);
+
+   REQUIRE(in_order);
+   REQUIRE(total == count);
+   REQUIRE(256 == reader.capacity());
+
+   // An entry that does not fit the buffer is an error, not a reallocation
+   REQUIRE(0 == pipe(fds));
+   REQUIRE(40 == write(fds[1], std::string(40, 'x').data(), 40));
+   close(fds[1]);
+   cline_utils::files_from_reader small(fds[0], '\n', 16);
+   std::string_view entry;
+   REQUIRE_THROWS_WITH(small.next(entry), Catch::Matchers::ContainsSubstring("Entry longer than the 16 byte buffer"));
+   close(fds[0]);
+
+   // A last entry without delimiter that had to be moved to the front of the buffer
+   REQUIRE(0 == pipe(fds));
+   REQUIRE(12 == write(fds[1], "a\nlast entry", 12));
+   close(fds[1]);
+   cline_utils::files_from_reader tail(fds[0], '\n', 16);
+   REQUIRE(tail.next(entry));
+   REQUIRE("a" == entry);
+   REQUIRE(tail.next(entry));
+   REQUIRE("last entry" == entry);
+   REQUIRE(false == tail.next(entry));
+   close(fds[0]);
+}
+
+/************************************************************************/
+/*
+* \brief Positional arguments come first, then the --files-from list
+* 
+*/
+TEST_CASE("Files From Option","[MUSTPASS]")
+{
+   char list[] = "/tmp/cline_files_from_XXXXXX";
+   int list_fd = mkstemp(list);
+   REQUIRE(0 <= list_fd);
+   REQUIRE(16 == write(list_fd, "c.h5\n\nd.h5\ne.h5\n", 16));
+   close(list_fd);
+
+   std::string files_from;
+   std::vector<cline_utils::option_longer> longer_options = 
+      {
+         cline_utils::make_option("files-from", 'F', files_from, " File listing inputs, - for standard input"),
+      };
+
+   cline_utils::ArgvBuilder arguments{"tool", "a.h5", "--files-from", list, "b.h5"};
+   cline_utils::CommandLineParser cline(arguments.argc(), arguments.argv());
+   cline.add_options(longer_options);
+   cline.set_positional_arity(0);
+   cline.parse_command_line();
+
+   std::vector<std::string> entries;
+   for(std::string_view entry : cline.get_positional_stream('F'))
+   {
+      entries.emplace_back(entry);
+   }
+   REQUIRE((std::vector<std::string>{"a.h5", "b.h5", "c.h5", "d.h5", "e.h5"} == entries));
+
+   // Without the option only the positionals are streamed
+   cline_utils::ArgvBuilder plain{"tool", "a.h5"};
+   cline_utils::CommandLineParser other(plain.argc(), plain.argv());
+   other.add_options(longer_options);
+   other.set_positional_arity(0);
+   other.parse_command_line();
+   cline_utils::files_from_reader stream = other.get_positional_stream('F');
+   REQUIRE(1 == std::distance(stream.begin(), stream.end()));
+
+   REQUIRE_THROWS_WITH(cline_utils::files_from_reader::open(std::string(list) + ".missing"), Catch::Matchers::ContainsSubstring("Unable to open entry list"));
+   unlink(list);
+}
+
+/************************************************************************/
+/*
+* \brief Driver function for Catch2 tests. Not clear to me how to use
+*        Catch::Session().run() with LONG command line arguments... 
+*        so quick hack using globals
+*
+*     @param[in] int argc: Integer variable storing number of command line arguments (including executable name)    
+*     @param[in] char **argv: Array of character pointers listing all the arguments    
+*     @return int: Success status
+* 
+*/
+int runCatchTests(int argc, char* const argv[])
+{
+   //std::cout << "-- BEGIN runCatchTests --" << std::endl;
+
+   // Owned, NULL terminated copy of the arguments in one allocation
+   cline_utils::ArgvBuilder arguments(argc, argv);
+   _G_argc = arguments.argc();
+   _G_argv = arguments.argv();
+
+   // Creat the command line parser
+   _G_cline = new cline_utils::CommandLineParser(_G_argc, _G_argv);
+
+   // Call potential tests
+   int result = Catch::Session().run();
+
+   // Clean up memory
+   delete _G_cline;
+
+   //std::cout << "-- END runCatchTests --" << std::endl;
+
+   // Return to main
+   return result;
+}
+
+/************************************************************************/
+/*
+* \brief Main function not built into Catch2...
+*
+*     @return int.
+* 
+*/
+int main(int argc, char* const argv[])
+{
+   return runCatchTests(argc, argv);
+}
\ No newline at end of file
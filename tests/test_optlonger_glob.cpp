@@ -0,0 +1,189 @@
+// -----------------------------------------------------------------------
+//
+//                        test_optlonger_glob.cpp V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#include <iostream>
+
+#define CATCH_CONFIG_RUNNER
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_session.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "cline_utils.h"
+
+// Cheesy global test variables to make things quicker.
+int _G_argc;
+char** _G_argv; //std::vector<std::string> Gargv;
+cline_utils::CommandLineParser *_G_cline;   
+
+/************************************************************************/
+/*
+* \brief Create an empty file
+* 
+*/
+static void touch(const std::string &filename)
+{
+   std::ofstream out(filename);
+}
+
+/************************************************************************/
+/*
+* \brief Glob options expand in the parser, sorted or in discovery order
+* 
+*/
+TEST_CASE("Glob Expansion","[MUSTPASS]")
+{
+   char directory[] = "/tmp/cline_glob_XXXXXX";
+   REQUIRE(NULL != mkdtemp(directory));
+   const std::string dir(directory);
+   for(const char *sub : {"/runs", "/runs/a", "/runs/b", "/runs/b/c", "/runs/.hidden"})
+   {
+      mkdir((dir + sub).c_str(), 0700);
+   }
+   for(const char *file : {"/runs/shot_0.h5", "/runs/a/shot_1.h5", "/runs/a/shot_2.h5", "/runs/a/notes.txt",
+                           "/runs/b/c/shot_3.h5", "/runs/.hidden/shot_4.h5", "/runs/b/.shot_5.h5"})
+   {
+      touch(dir + file);
+   }
+   REQUIRE(0 == symlink((dir + "/runs").c_str(), (dir + "/runs/b/loop").c_str()));
+
+   std::vector<std::string> inputs;
+   std::vector<std::string> all = {dir + "/runs/a/shot_1.h5", dir + "/runs/a/shot_2.h5", dir + "/runs/b/c/shot_3.h5", dir + "/runs/shot_0.h5"};
+
+   cline_utils::ArgvBuilder arguments{"tool", "--inputs=" + dir + "/runs/**/shot_*.h5", "-i", dir + "/runs/a/notes.txt"};
+   cline_utils::CommandLineParser cline(arguments.argc(), arguments.argv());
+   cline.add_options({cline_utils::make_option("inputs", 'i', inputs, " Input files, glob patterns are expanded")});
+   cline.set_glob_expansion('i');
+   cline.parse_command_line();
+
+   // Hidden names and the symbolic link loop are skipped, literals are kept
+   std::vector<std::string> expected = all;
+   expected.push_back(dir + "/runs/a/notes.txt");
+   REQUIRE(expected == inputs);
+
+   // Discovery order holds the same paths
+   cline.set_glob_expansion('i', cline_utils::glob_unsorted);
+   cline.parse_command_line();
+   std::sort(inputs.begin(), inputs.end());
+   std::sort(expected.begin(), expected.end());
+   REQUIRE(expected == inputs);
+
+   // Direct use: character classes, "*" in the middle, trailing slash for directories, ".*"
+   std::vector<std::string> found;
+   REQUIRE(2 == cline_utils::glob_expand(dir + "/runs/*/shot_[12].h5", found));
+   REQUIRE((std::vector<std::string>{dir + "/runs/a/shot_1.h5", dir + "/runs/a/shot_2.h5"} == found));
+   found.clear();
+   REQUIRE(2 == cline_utils::glob_expand(dir + "/runs/*/*/", found));
+   REQUIRE((std::vector<std::string>{dir + "/runs/b/c", dir + "/runs/b/loop"} == found));
+   found.clear();
+   REQUIRE(2 == cline_utils::glob_expand(dir + "/runs/*/", found));
+   REQUIRE((std::vector<std::string>{dir + "/runs/a", dir + "/runs/b"} == found));
+   found.clear();
+   REQUIRE(1 == cline_utils::glob_expand(dir + "/runs/**/.shot_*", found));
+   REQUIRE(dir + "/runs/b/.shot_5.h5" == found[0]);
+
+   // No match is an error
+   cline_utils::ArgvBuilder nothing{"tool", "-i", dir + "/runs/**/*.root"};
+   cline_utils::CommandLineParser empty(nothing.argc(), nothing.argv());
+   empty.add_options({cline_utils::make_option("inputs", 'i', inputs, " Input files")});
+   empty.set_glob_expansion('i');
+   REQUIRE_THROWS_WITH(empty.parse_command_line(), Catch::Matchers::ContainsSubstring("matches no files"));
+
+   // Only list options can glob
+   std::string single;
+   empty.add_options({cline_utils::make_option("single", 's', single, " One file")});
+   REQUIRE_THROWS_WITH(empty.set_glob_expansion('s'), Catch::Matchers::ContainsSubstring("is not a std::vector<std::string> option"));
+
+   REQUIRE(0 == system(("rm -rf " + dir).c_str()));
+}
+
+/************************************************************************/
+/*
+* \brief A large tree is walked in parallel
+* 
+*/
+TEST_CASE("Glob Many Files","[MUSTPASS]")
+{
+   char directory[] = "/tmp/cline_glob_XXXXXX";
+   REQUIRE(NULL != mkdtemp(directory));
+   const std::string dir(directory);
+
+   const size_t directories = 200, files = 200;
+   for(size_t d = 0; d < directories; ++d)
+   {
+      const std::string sub = dir + "/run" + std::to_string(d % 10) + "/part" + std::to_string(d);
+      mkdir((dir + "/run" + std::to_string(d % 10)).c_str(), 0700);
+      mkdir(sub.c_str(), 0700);
+      for(size_t f = 0; f < files; ++f)
+      {
+         touch(sub + "/shot_" + std::to_string(f) + ((0 == f % 4) ? ".txt" : ".h5"));
+      }
+   }
+
+   for(cline_utils::glob_order order : {cline_utils::glob_sorted, cline_utils::glob_unsorted})
+   {
+      std::vector<std::string> found;
+      auto start = std::chrono::steady_clock::now();
+      size_t count = cline_utils::glob_expand(dir + "/**/shot_*.h5", found, order);
+      double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      std::cout << "Matched " << count << " of " << directories * files << " files in " << seconds << " s" << std::endl;
+      REQUIRE(directories * files * 3 / 4 == count);
+      if(cline_utils::glob_sorted == order)
+      {
+         REQUIRE(std::is_sorted(found.begin(), found.end()));
+      }
+   }
+
+   REQUIRE(0 == system(("rm -rf " + dir).c_str()));
+}
+
+/************************************************************************/
+/*
+* \brief Driver function for Catch2 tests. Not clear to me how to use
+*        Catch::Session().run() with LONG command line arguments... 
+*        so quick hack using globals
+*
+*     @param[in] int argc: Integer variable storing number of command line arguments (including executable name)    
+*     @param[in] char **argv: Array of character pointers listing all the arguments    
+*     @return int: Success status
+* 
+*/
+int runCatchTests(int argc, char* const argv[])
+{
+   //std::cout << "-- BEGIN runCatchTests --" << std::endl;
+
+   // Owned, NULL terminated copy of the arguments in one allocation
+   cline_utils::ArgvBuilder arguments(argc, argv);
+   _G_argc = arguments.argc();
+   _G_argv = arguments.argv();
+
+   // Creat the command line parser
+   _G_cline = new cline_utils::CommandLineParser(_G_argc, _G_argv);
+
+   // Call potential tests
+   int result = Catch::Session().run();
+
+   // Clean up memory
+   delete _G_cline;
+
+   //std::cout << "-- END runCatchTests --" << std::endl;
+
+   // Return to main
+   return result;
+}
+
+/************************************************************************/
+/*
+* \brief Main function not built into Catch2...
+*
+*     @return int.
+* 
+*/
+int main(int argc, char* const argv[])
+{
+   return runCatchTests(argc, argv);
+}
\ No newline at end of file
@@ -0,0 +1,242 @@
+// -----------------------------------------------------------------------
+//
+//                        test_optlonger_hot_reload.cpp V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <thread>
+#include <unistd.h>
+
+#define CATCH_CONFIG_RUNNER
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_session.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "cline_utils.h"
+
+// Cheesy global test variables to make things quicker.
+int _G_argc;
+char** _G_argv; //std::vector<std::string> Gargv;
+cline_utils::CommandLineParser *_G_cline;   
+
+/************************************************************************/
+/*
+* \brief Write a config file by renaming a temporary over it, the way editors do
+* 
+*/
+static void write_config(const std::string &filename, const std::string &text)
+{
+   std::string temporary = filename + ".tmp";
+   {
+      std::ofstream out(temporary);
+      out << text;
+   }
+   REQUIRE(0 == rename(temporary.c_str(), filename.c_str()));
+}
+
+/************************************************************************/
+/*
+* \brief Config file values fill in options missing from the command line and
+*        rewriting the file publishes a new snapshot to the readers
+* 
+*/
+TEST_CASE("Config File Hot Reload","[MUSTPASS]")
+{
+   double parameter1D = std::nan("1"),
+          parameter2D = 3.14;
+
+   int helpFlag    = 0,
+       parameter3I = 100,
+       verboseFlag = 0;
+
+   std::string parameter4S("");
+   char label = 'x';
+
+   std::vector<cline_utils::option_longer> longer_options = 
+      {
+         {"help"     , no_argument      , NULL, 'h', optional_option, typeid(helpFlag).name()          , &helpFlag   , " Optional help option that must be h"},
+         {"longName1", required_argument, NULL, 'a', required_option, typeid(parameter1D).name()       , &parameter1D, " Required option with required double argument [physical units]"},
+         {"longName2", required_argument, NULL, 'b', required_option, typeid(parameter2D).name()       , &parameter2D, " Required option with required double argument []"},
+         {"longName3", required_argument, NULL, 'c', optional_option, typeid(parameter3I).name()       , &parameter3I, " Optional option with a required integer arugment if used", {cline_utils::option_constraint::between(0, 50)}},
+         {"longName4", required_argument, NULL, 'd', required_option, typeid(parameter4S.data()).name(), &parameter4S, " Required option with required string argument"},
+         {"verbose"  , no_argument      , NULL, 'v', optional_option, typeid(verboseFlag).name()       , &verboseFlag, " Verbose output"},
+         {"label"    , required_argument, NULL, 'l', optional_option, typeid(label).name()             , &label      , " Option of a type the parser cannot convert"},
+      };
+
+   char directory[] = "/tmp/cline_reload_XXXXXX";
+   REQUIRE(NULL != mkdtemp(directory));
+   std::string filename = std::string(directory) + "/test.conf";
+   write_config(filename, "# startup values\nlongName2 = 9\nlongName3 = 7\nverbose\n");
+
+   _G_cline->add_options(longer_options);
+   _G_cline->set_config_file(filename);
+   _G_cline->parse_command_line();
+
+   // Command line beats config file
+   REQUIRE(4 == parameter2D);
+   REQUIRE(7 == parameter3I);
+   REQUIRE(1 == verboseFlag);
+   REQUIRE(cline_utils::source_command_line == _G_cline->get_option_source('b'));
+   REQUIRE(cline_utils::source_config_file == _G_cline->get_option_source('c'));
+
+   _G_cline->watch_config_file();
+   cline_utils::snapshot_reader reader = _G_cline->register_snapshot_reader();
+   REQUIRE(reader.valid());
+   {
+      auto snapshot = reader.read();
+      REQUIRE(1 == snapshot->version);
+      REQUIRE(7 == snapshot->get<int>("longName3"));
+      REQUIRE("hello.txt" == snapshot->get<std::string>("longName4"));
+   }
+
+   write_config(filename, "longName2 = 9\nlongName3 = 11\n");
+   for(int i = 0; i < 500 && 0 == _G_cline->get_reload_count(); ++i)
+   {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+   }
+   _G_cline->stop_config_watch();
+   REQUIRE(1 == _G_cline->get_reload_count());
+
+   {
+      auto snapshot = reader.read();
+      REQUIRE(2 == snapshot->version);
+      REQUIRE(11 == snapshot->get<int>("longName3"));
+      REQUIRE(4 == snapshot->get<double>("longName2"));
+      REQUIRE(0 == snapshot->get<int>("verbose"));
+      REQUIRE(cline_utils::source_default == snapshot->sources[snapshot->find("verbose")]);
+   }
+
+   // The bound variables are not touched by a reload
+   REQUIRE(7 == parameter3I);
+
+   // Invalid files are rejected and the last good snapshot stays published
+   write_config(filename, "longName3 = 70\n");
+   REQUIRE(false == _G_cline->reload_config());
+   REQUIRE(std::string::npos != _G_cline->get_reload_error().find("1 constraint violation(s)"));
+   write_config(filename, "longName9 = 1\n");
+   REQUIRE(false == _G_cline->reload_config());
+   REQUIRE(std::string::npos != _G_cline->get_reload_error().find("Unknown option 'longName9'"));
+   write_config(filename, "longName3 = 12\nlabel = y\n");
+   REQUIRE(false == _G_cline->reload_config());
+   REQUIRE(std::string::npos != _G_cline->get_reload_error().find("Unable to match option type string: --label (-l)"));
+   REQUIRE(11 == reader.read()->get<int>("longName3"));
+
+   unlink(filename.c_str());
+   rmdir(directory);
+   _G_cline->delete_all_options();
+}
+
+/************************************************************************/
+/*
+* \brief Layers and included files are watched as well, including files a
+*        reload starts to include
+* 
+*/
+TEST_CASE("Config Layer And Include Reload","[MUSTPASS]")
+{
+   int level = 0,
+       verboseFlag = 0;
+
+   std::vector<cline_utils::option_longer> longer_options = 
+      {
+         {"level"  , required_argument, NULL, 'l', optional_option, typeid(level).name()      , &level      , " Level"},
+         {"verbose", no_argument      , NULL, 'v', optional_option, typeid(verboseFlag).name(), &verboseFlag, " Verbose output"},
+      };
+
+   char directory[] = "/tmp/cline_reload_XXXXXX";
+   REQUIRE(NULL != mkdtemp(directory));
+   const std::string dir(directory);
+   REQUIRE(0 == mkdir((dir + "/conf.d").c_str(), 0700));
+   write_config(dir + "/site.conf", "level = 1\n@include conf.d/extra.conf\n");
+   write_config(dir + "/conf.d/extra.conf", "verbose\n");
+
+   cline_utils::ArgvBuilder arguments{"tool"};
+   cline_utils::CommandLineParser cline(arguments.argc(), arguments.argv());
+   cline.add_options(longer_options);
+   cline.add_config_layer(dir + "/site.conf");
+   cline.parse_command_line();
+   REQUIRE(1 == level);
+   REQUIRE(1 == verboseFlag);
+
+   cline.watch_config_file();
+   cline_utils::snapshot_reader reader = cline.register_snapshot_reader();
+   auto wait_for_reload = [&](uint64_t count)
+      {
+         for(int i = 0; i < 500 && count > cline.get_reload_count(); ++i)
+         {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+         }
+         return(cline.get_reload_count());
+      };
+
+   write_config(dir + "/conf.d/extra.conf", "level = 5\n");
+   REQUIRE(1 == wait_for_reload(1));
+   REQUIRE(5 == reader.read()->get<int>("level"));
+   REQUIRE(0 == reader.read()->get<int>("verbose"));
+
+   // new.conf is not part of the configuration yet, writing it changes nothing
+   write_config(dir + "/new.conf", "level = 8\n");
+   write_config(dir + "/site.conf", "@include new.conf\n");
+   REQUIRE(2 == wait_for_reload(2));
+   REQUIRE(8 == reader.read()->get<int>("level"));
+
+   write_config(dir + "/new.conf", "level = 9\n");
+   REQUIRE(3 == wait_for_reload(3));
+   REQUIRE(9 == reader.read()->get<int>("level"));
+   cline.stop_config_watch();
+   REQUIRE(3 == cline.get_reload_count());
+
+   REQUIRE(0 == system(("rm -rf " + dir).c_str()));
+}
+
+/************************************************************************/
+/*
+* \brief Driver function for Catch2 tests. Not clear to me how to use
+*        Catch::Session().run() with LONG command line arguments... 
+*        so quick hack using globals
+*
+*     @param[in] int argc: Integer variable storing number of command line arguments (including executable name)    
+*     @param[in] char **argv: Array of character pointers listing all the arguments    
+*     @return int: Success status
+* 
+*/
+int runCatchTests(int argc, char* const argv[])
+{
+   //std::cout << "-- BEGIN runCatchTests --" << std::endl;
+
+   // Owned, NULL terminated copy of the arguments in one allocation
+   cline_utils::ArgvBuilder arguments(argc, argv);
+   _G_argc = arguments.argc();
+   _G_argv = arguments.argv();
+
+   // Creat the command line parser
+   _G_cline = new cline_utils::CommandLineParser(_G_argc, _G_argv);
+
+   // Call potential tests
+   int result = Catch::Session().run();
+
+   // Clean up memory
+   delete _G_cline;
+
+   //std::cout << "-- END runCatchTests --" << std::endl;
+
+   // Return to main
+   return result;
+}
+
+/************************************************************************/
+/*
+* \brief Main function not built into Catch2...
+*
+*     @return int.
+* 
+*/
+int main(int argc, char* const argv[])
+{
+   return runCatchTests(argc, argv);
+}
\ No newline at end of file
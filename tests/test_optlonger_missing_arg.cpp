@@ -69,19 +69,10 @@ int runCatchTests(int argc, char* const argv[])
 {
    //std::cout << "-- BEGIN runCatchTests --" << std::endl;
 
-   _G_argc = argc;
-
-   // Allocate memory and copy strings
-   // std::copy(argv + 1, argv + Gargc, std::back_inserter(Gargv));
-   _G_argv = new char*[(_G_argc + 1) * sizeof * _G_argv];
-   for(size_t i = 0; i < _G_argc; ++i)
-   {
-      size_t slength = strlen(argv[i]) + 1;
-      //std::cout << slength << std::endl;
-      _G_argv[i] = new char[slength];
-      memcpy(_G_argv[i], argv[i], slength);
-   }
-   _G_argv[_G_argc] = NULL; // Must be NULL terminated
+   // Owned, NULL terminated copy of the arguments in one allocation
+   cline_utils::ArgvBuilder arguments(argc, argv);
+   _G_argc = arguments.argc();
+   _G_argv = arguments.argv();
 
    // Creat the command line parser
    _G_cline = new cline_utils::CommandLineParser(_G_argc, _G_argv);
@@ -90,12 +81,6 @@ int runCatchTests(int argc, char* const argv[])
    int result = Catch::Session().run();
 
    // Clean up memory
-   for(size_t i = 0; i < _G_argc; ++i)
-   {
-      delete[] _G_argv[i];
-   }
-   delete[] _G_argv;
-
    delete _G_cline;
 
    //std::cout << "-- END runCatchTests --" << std::endl;
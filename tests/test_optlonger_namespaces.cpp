@@ -0,0 +1,297 @@
+// -----------------------------------------------------------------------
+//
+//                     test_optlonger_namespaces.cpp V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#include <iostream>
+
+#define CATCH_CONFIG_RUNNER
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_session.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "cline_namespace.h"
+
+// Cheesy global test variables to make things quicker.
+int _G_argc;
+char** _G_argv; //std::vector<std::string> Gargv;
+cline_utils::CommandLineParser *_G_cline;   
+
+struct probe_params
+{
+   double rate = 1.0;
+   std::string name = "probe";
+};
+
+struct diag_params
+{
+   probe_params probe;
+   bool verbose = false;
+};
+
+struct solver_params
+{
+   double tol = 1e-6;
+   int max_iter = 100;
+};
+
+struct mesh_params
+{
+   int nx = 32;
+   int ny = 32;
+};
+
+struct plasma_params
+{
+   solver_params solver;
+   mesh_params mesh;
+   diag_params diag;
+   int flag = 0;
+};
+
+/************************************************************************/
+/*
+* \brief Register the nested parameter structs as dotted options
+* 
+*/
+static void add_plasma_options(cline_utils::CommandLineParser &cline, plasma_params &p)
+{
+   cline.add_option({"flag", no_argument, NULL, 'f', optional_option, typeid(p.flag).name(), &p.flag, " Short option"});
+
+   cline_utils::option_namespace<plasma_params> root(cline, "", p);
+   root.nest("solver", &plasma_params::solver)
+       .option("tol", &solver_params::tol, " Solver tolerance", optional_option, {cline_utils::option_constraint::positive()})
+       .option("max_iter", &solver_params::max_iter, " Iteration limit");
+   root.nest("mesh", &plasma_params::mesh)
+       .option("nx", &mesh_params::nx, " Cells along x")
+       .option("ny", &mesh_params::ny, " Cells along y");
+
+   cline_utils::option_namespace<diag_params> diag = root.nest("diag", &plasma_params::diag);
+   diag.option("verbose", &diag_params::verbose, " Verbose diagnostics");
+   diag.nest("probe", &diag_params::probe)
+       .option("rate", &probe_params::rate, " Probe sample rate [Hz]")
+       .option("name", &probe_params::name, " Probe name");
+   REQUIRE("diag" == diag.name());
+}
+
+static plasma_params parse_plasma(const std::string &command_line, const std::string &config = "")
+{
+   plasma_params p;
+   cline_utils::ArgvBuilder arguments = cline_utils::ArgvBuilder::split(command_line);
+   cline_utils::CommandLineParser cline(arguments.argc(), arguments.argv());
+   add_plasma_options(cline, p);
+   if(false == config.empty())
+   {
+      cline.set_config_file(config);
+   }
+   cline.parse_command_line();
+   return(p);
+}
+
+/************************************************************************/
+/*
+* \brief Dotted names parse from argv and config files into nested structs
+* 
+*/
+TEST_CASE("Dotted Namespaces","[MUSTPASS]")
+{
+   plasma_params p = parse_plasma("tool --solver.tol=1e-8 -f --mesh.nx 64 --diag.probe.rate=2.5 --diag.verbose --diag.probe.name p7");
+   REQUIRE(1e-8 == p.solver.tol);
+   REQUIRE(100 == p.solver.max_iter);
+   REQUIRE(64 == p.mesh.nx);
+   REQUIRE(32 == p.mesh.ny);
+   REQUIRE(2.5 == p.diag.probe.rate);
+   REQUIRE("p7" == p.diag.probe.name);
+   REQUIRE(p.diag.verbose);
+   REQUIRE(1 == p.flag);
+
+   // The first token, unique abbreviations and errors still go through getopt_long
+   plasma_params q = parse_plasma("tool --mesh.ny=8 --solver.max=5");
+   REQUIRE(8 == q.mesh.ny);
+   REQUIRE(5 == q.solver.max_iter);
+   REQUIRE_THROWS_WITH(parse_plasma("tool -f --solver.nope=1"), Catch::Matchers::ContainsSubstring("Unrecognized option"));
+   REQUIRE_THROWS_WITH(parse_plasma("tool -f --solver.tol=-1"), Catch::Matchers::ContainsSubstring("--solver.tol"));
+   REQUIRE_THROWS_WITH(parse_plasma("tool -f --mesh.nx=1 --mesh.nx=2"), Catch::Matchers::ContainsSubstring("Duplicate option struct.val input found: --mesh.nx"));
+
+   char config[] = "/tmp/cline_namespace_XXXXXX";
+   int fd = mkstemp(config);
+   REQUIRE(0 <= fd);
+   const char text[] = "mesh.nx = 128\ndiag.probe.rate = 4\n";
+   REQUIRE(ssize_t(sizeof(text) - 1) == write(fd, text, sizeof(text) - 1));
+   close(fd);
+   plasma_params c = parse_plasma("tool -f --mesh.nx=16", config);
+   REQUIRE(16 == c.mesh.nx);
+   REQUIRE(4 == c.diag.probe.rate);
+   unlink(config);
+}
+
+/************************************************************************/
+/*
+* \brief Whole namespaces are dumped as config lines and reset to defaults
+* 
+*/
+TEST_CASE("Namespace Reset And Dump","[MUSTPASS]")
+{
+   plasma_params p;
+   cline_utils::ArgvBuilder arguments = cline_utils::ArgvBuilder::split("tool --diag.probe.rate=2.5 --diag.probe.name=p7 --mesh.nx=64 --diag.verbose");
+   cline_utils::CommandLineParser cline(arguments.argc(), arguments.argv());
+   add_plasma_options(cline, p);
+   cline.parse_command_line();
+
+   REQUIRE("diag.probe.name = \"p7\"\ndiag.probe.rate = 2.5\ndiag.verbose = true\n" == cline.format_options("diag"));
+   REQUIRE("mesh.nx = 64\nmesh.ny = 32\n" == cline.format_options("mesh"));
+   REQUIRE("diag.probe.rate = 2.5\n" == cline.format_options("diag.probe.rate"));
+
+   REQUIRE(2 == cline.reset_options("diag.probe"));
+   REQUIRE(1.0 == p.diag.probe.rate);
+   REQUIRE("probe" == p.diag.probe.name);
+   REQUIRE(p.diag.verbose);
+   REQUIRE(64 == p.mesh.nx);
+
+   REQUIRE(8 == cline.reset_options(""));
+   REQUIRE(32 == p.mesh.nx);
+   REQUIRE(false == p.diag.verbose);
+
+   REQUIRE_THROWS_WITH(cline.reset_options("diag.pro"), Catch::Matchers::ContainsSubstring("No options in namespace 'diag.pro'"));
+   REQUIRE_THROWS_WITH(cline.format_options("nope"), Catch::Matchers::ContainsSubstring("format_options(...)"));
+}
+
+/************************************************************************/
+/*
+* \brief Hundreds of namespaced options need no hand picked values
+* 
+*/
+TEST_CASE("Many Namespaced Options","[MUSTPASS]")
+{
+   const size_t groups = 40, per_group = 25;
+   std::vector<double> values(groups * per_group, 0.0);
+   std::vector<std::string> names;
+   std::string command_line = "tool";
+   for(size_t g = 0; g < groups; ++g)
+   {
+      for(size_t i = 0; i < per_group; ++i)
+      {
+         names.push_back("component" + std::to_string(g) + ".param" + std::to_string(i));
+         if(0 == (g + i) % 7)
+         {
+            command_line += " --" + names.back() + "=" + std::to_string(g * 1000 + i);
+         }
+      }
+   }
+
+   cline_utils::ArgvBuilder arguments = cline_utils::ArgvBuilder::split(command_line);
+   cline_utils::CommandLineParser cline(arguments.argc(), arguments.argv());
+   for(size_t k = 0; k < names.size(); ++k)
+   {
+      cline.add_option(cline_utils::make_option(names[k].c_str(), cline.allocate_option_val(), values[k], " Generated"));
+   }
+   cline.parse_command_line();
+
+   for(size_t g = 0; g < groups; ++g)
+   {
+      for(size_t i = 0; i < per_group; ++i)
+      {
+         REQUIRE(((0 == (g + i) % 7) ? double(g * 1000 + i) : 0.0) == values[g * per_group + i]);
+      }
+   }
+   REQUIRE(per_group == cline.reset_options("component3"));
+   REQUIRE(0.0 == values[3 * per_group + 4]);
+}
+
+/************************************************************************/
+/*
+* \brief Enumeration members may name their values with an inline enum_table
+* 
+*/
+TEST_CASE("Namespaced Inline Enum Table","[MUSTPASS]")
+{
+   enum class scheme : int16_t
+   {
+      explicit_euler = -1,
+      implicit_euler = 2
+   };
+   struct stepper_params
+   {
+      scheme method = scheme::explicit_euler;
+   };
+
+   stepper_params s;
+   cline_utils::ArgvBuilder arguments = cline_utils::ArgvBuilder::split("tool --stepper.method=implicit");
+   cline_utils::CommandLineParser cline(arguments.argc(), arguments.argv());
+   cline_utils::option_namespace<stepper_params>(cline, "stepper", s)
+      .option("method", &stepper_params::method,
+              cline_utils::enum_table::of<scheme>({{"explicit", scheme::explicit_euler}, {"implicit", scheme::implicit_euler}}), " Time stepping scheme");
+   cline.parse_command_line();
+
+   REQUIRE(scheme::implicit_euler == s.method);
+   REQUIRE("stepper.method = implicit\n" == cline.format_options("stepper"));
+   REQUIRE(1 == cline.reset_options("stepper"));
+   REQUIRE(scheme::explicit_euler == s.method);
+}
+
+/************************************************************************/
+/*
+* \brief Errors about long only options name them instead of printing val
+* 
+*/
+TEST_CASE("Required Namespaced Option","[MUSTPASS]")
+{
+   solver_params s;
+   cline_utils::ArgvBuilder arguments = cline_utils::ArgvBuilder::split("tool --solver.max_iter=5");
+   cline_utils::CommandLineParser cline(arguments.argc(), arguments.argv());
+   cline_utils::option_namespace<solver_params>(cline, "solver", s)
+      .option("tol", &solver_params::tol, " Solver tolerance", required_option)
+      .option("max_iter", &solver_params::max_iter, " Iteration limit");
+
+   REQUIRE_THROWS_WITH(cline.parse_command_line(), Catch::Matchers::ContainsSubstring("Missing required option in command line args: --solver.tol\n"));
+}
+
+/************************************************************************/
+/*
+* \brief Driver function for Catch2 tests. Not clear to me how to use
+*        Catch::Session().run() with LONG command line arguments... 
+*        so quick hack using globals
+*
+*     @param[in] int argc: Integer variable storing number of command line arguments (including executable name)    
+*     @param[in] char **argv: Array of character pointers listing all the arguments    
+*     @return int: Success status
+* 
+*/
+int runCatchTests(int argc, char* const argv[])
+{
+   //std::cout << "-- BEGIN runCatchTests --" << std::endl;
+
+   // Owned, NULL terminated copy of the arguments in one allocation
+   cline_utils::ArgvBuilder arguments(argc, argv);
+   _G_argc = arguments.argc();
+   _G_argv = arguments.argv();
+
+   // Creat the command line parser
+   _G_cline = new cline_utils::CommandLineParser(_G_argc, _G_argv);
+
+   // Call potential tests
+   int result = Catch::Session().run();
+
+   // Clean up memory
+   delete _G_cline;
+
+   //std::cout << "-- END runCatchTests --" << std::endl;
+
+   // Return to main
+   return result;
+}
+
+/************************************************************************/
+/*
+* \brief Main function not built into Catch2...
+*
+*     @return int.
+* 
+*/
+int main(int argc, char* const argv[])
+{
+   return runCatchTests(argc, argv);
+}
\ No newline at end of file
@@ -0,0 +1,208 @@
+// -----------------------------------------------------------------------
+//
+//                    test_optlonger_numeric_array.cpp V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#include <iostream>
+
+#define CATCH_CONFIG_RUNNER
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_session.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "cline_utils.h"
+
+// Cheesy global test variables to make things quicker.
+int _G_argc;
+char** _G_argv; //std::vector<std::string> Gargv;
+cline_utils::CommandLineParser *_G_cline;   
+
+/************************************************************************/
+/*
+* \brief Write text into a file
+* 
+*/
+static void write_file(const std::string &filename, const std::string &text)
+{
+   std::ofstream out(filename);
+   out << text;
+}
+
+/************************************************************************/
+/*
+* \brief Array options read inline lists and "@file" arguments
+* 
+*/
+TEST_CASE("Numeric Array Option","[MUSTPASS]")
+{
+   char directory[] = "/tmp/cline_array_XXXXXX";
+   REQUIRE(NULL != mkdtemp(directory));
+   const std::string dir(directory);
+   write_file(dir + "/profile.csv", "0.5,1e3\n-2;+4\n\n  7.25\t8\r\n");
+   write_file(dir + "/empty.csv", "");
+   write_file(dir + "/bad.csv", "1,2,3\n4,five,6\n");
+
+   std::vector<double> profile, weights;
+   cline_utils::ArgvBuilder arguments{"tool", "--profile=@" + dir + "/profile.csv", "-w", "1, 2 ,3"};
+   cline_utils::CommandLineParser cline(arguments.argc(), arguments.argv());
+   cline.add_options({cline_utils::make_option("profile", 'p', profile, " Profile values"),
+                      cline_utils::make_option("weights", 'w', weights, " Weights")});
+   cline.parse_command_line();
+   REQUIRE((std::vector<double>{0.5, 1000, -2, 4, 7.25, 8} == profile));
+   REQUIRE((std::vector<double>{1, 2, 3} == weights));
+   REQUIRE(std::string::npos != cline.format_input_summary(cline_utils::summary_json).find("\"type\":\"double_array\",\"required\":false,\"argument\":true,\"source\":\"command_line\",\"value\":[1,2,3]"));
+   REQUIRE(std::string::npos != cline.format_input_summary(cline_utils::summary_csv).find(",1;2;3,"));
+
+   // Snapshots restore the whole array
+   std::vector<char> snapshot = cline.serialize_snapshot();
+   profile.clear();
+   cline.load_snapshot(snapshot);
+   REQUIRE(6 == profile.size());
+   REQUIRE(8 == profile[5]);
+
+   // An empty file is an empty array
+   cline_utils::ArgvBuilder empty_arguments{"tool", "-p", "@" + dir + "/empty.csv"};
+   cline_utils::CommandLineParser empty(empty_arguments.argc(), empty_arguments.argv());
+   empty.add_options({cline_utils::make_option("profile", 'p', profile, " Profile values")});
+   empty.parse_command_line();
+   REQUIRE(profile.empty());
+
+   // Errors name the line and the text, missing files are reported
+   cline_utils::ArgvBuilder bad_arguments{"tool", "-p", "@" + dir + "/bad.csv"};
+   cline_utils::CommandLineParser bad(bad_arguments.argc(), bad_arguments.argv());
+   bad.add_options({cline_utils::make_option("profile", 'p', profile, " Profile values")});
+   REQUIRE_THROWS_WITH(bad.parse_command_line(), Catch::Matchers::ContainsSubstring("line 2: 'five' is not a number"));
+
+   cline_utils::ArgvBuilder missing_arguments{"tool", "-p", "@" + dir + "/missing.csv"};
+   cline_utils::CommandLineParser missing(missing_arguments.argc(), missing_arguments.argv());
+   missing.add_options({cline_utils::make_option("profile", 'p', profile, " Profile values")});
+   REQUIRE_THROWS_WITH(missing.parse_command_line(), Catch::Matchers::ContainsSubstring("cannot be opened"));
+
+   cline_utils::ArgvBuilder inline_arguments{"tool", "-w", "1,2,x3"};
+   cline_utils::CommandLineParser inline_bad(inline_arguments.argc(), inline_arguments.argv());
+   inline_bad.add_options({cline_utils::make_option("weights", 'w', weights, " Weights")});
+   REQUIRE_THROWS_WITH(inline_bad.parse_command_line(), Catch::Matchers::ContainsSubstring("'x3' is not a number"));
+
+   // "@file" arguments are inputs of the config cache: editing one is a miss
+   auto parse_cached = [&]()
+      {
+         cline_utils::ArgvBuilder cached_arguments{"tool", "-p", "@" + dir + "/profile.csv"};
+         cline_utils::CommandLineParser cached(cached_arguments.argc(), cached_arguments.argv());
+         cached.add_options({cline_utils::make_option("profile", 'p', profile, " Profile values")});
+         cached.set_config_cache(dir + "/cache");
+         profile.clear(); // The cache key covers the values before the parse
+         cached.parse_command_line();
+         return(cached.loaded_from_config_cache());
+      };
+   auto date_back = [&]()
+      {
+         struct timespec times[2];
+         clock_gettime(CLOCK_REALTIME, &times[0]);
+         times[0].tv_sec -= 60;
+         times[1] = times[0];
+         REQUIRE(0 == utimensat(AT_FDCWD, (dir + "/profile.csv").c_str(), times, 0));
+      };
+   date_back();
+   REQUIRE(false == parse_cached());
+   REQUIRE(true == parse_cached());
+   REQUIRE(6 == profile.size());
+   write_file(dir + "/profile.csv", "9 10");
+   date_back();
+   REQUIRE(false == parse_cached());
+   REQUIRE((std::vector<double>{9, 10} == profile));
+
+   REQUIRE(0 == system(("rm -rf " + dir).c_str()));
+}
+
+/************************************************************************/
+/*
+* \brief Chunked parallel conversion matches a sequential one
+* 
+*/
+TEST_CASE("Numeric Array Chunks","[MUSTPASS]")
+{
+   const size_t count = 2000000;
+   std::string text;
+   std::vector<double> expected;
+   expected.reserve(count);
+   for(size_t i = 0; i < count; ++i)
+   {
+      const double value = (double(i % 1000) - 500.0) / 8.0 + double(i / 1000);
+      expected.push_back(value);
+      char buffer[32];
+      int length = snprintf(buffer, sizeof(buffer), "%.17g", value);
+      text.append(buffer, length);
+      text += (0 == (i + 1) % 8) ? '\n' : ',';
+   }
+
+   // Small chunks put boundaries inside numbers, which must be moved to separators
+   for(size_t min_chunk : {size_t(1) << 20, size_t(4093), size_t(1)})
+   {
+      std::vector<double> values;
+      auto start = std::chrono::steady_clock::now();
+      cline_utils::numeric_array_error error = cline_utils::numeric_array_parser(text.data(), text.size(), min_chunk).parse(values);
+      double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      std::cout << "Parsed " << values.size() << " values (" << text.size() / 1048576.0 << " MB) in " << seconds << " s" << std::endl;
+      REQUIRE(false == error.failed());
+      REQUIRE(expected == values);
+   }
+
+   // The first error in text order wins, whichever chunk finds it
+   const size_t first = text.find_first_of("0123456789", text.size() / 2);
+   text[first] = '#';
+   text[text.find_first_of("0123456789", text.size() - 8)] = '#';
+   std::vector<double> values;
+   cline_utils::numeric_array_error error = cline_utils::numeric_array_parser(text.data(), text.size(), 4096).parse(values);
+   REQUIRE(error.failed());
+   REQUIRE(size_t(1 + std::count(text.begin(), text.begin() + first, '\n')) == error.line);
+   REQUIRE(values.empty());
+}
+/************************************************************************/
+/*
+* \brief Driver function for Catch2 tests. Not clear to me how to use
+*        Catch::Session().run() with LONG command line arguments... 
+*        so quick hack using globals
+*
+*     @param[in] int argc: Integer variable storing number of command line arguments (including executable name)    
+*     @param[in] char **argv: Array of character pointers listing all the arguments    
+*     @return int: Success status
+* 
+*/
+int runCatchTests(int argc, char* const argv[])
+{
+   //std::cout << "-- BEGIN runCatchTests --" << std::endl;
+
+   // Owned, NULL terminated copy of the arguments in one allocation
+   cline_utils::ArgvBuilder arguments(argc, argv);
+   _G_argc = arguments.argc();
+   _G_argv = arguments.argv();
+
+   // Creat the command line parser
+   _G_cline = new cline_utils::CommandLineParser(_G_argc, _G_argv);
+
+   // Call potential tests
+   int result = Catch::Session().run();
+
+   // Clean up memory
+   delete _G_cline;
+
+   //std::cout << "-- END runCatchTests --" << std::endl;
+
+   // Return to main
+   return result;
+}
+
+/************************************************************************/
+/*
+* \brief Main function not built into Catch2...
+*
+*     @return int.
+* 
+*/
+int main(int argc, char* const argv[])
+{
+   return runCatchTests(argc, argv);
+}
\ No newline at end of file
@@ -0,0 +1,227 @@
+// -----------------------------------------------------------------------
+//
+//                       test_optlonger_paths.cpp V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#include <iostream>
+
+#define CATCH_CONFIG_RUNNER
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_session.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "cline_utils.h"
+
+// Cheesy global test variables to make things quicker.
+int _G_argc;
+char** _G_argv; //std::vector<std::string> Gargv;
+cline_utils::CommandLineParser *_G_cline;   
+
+typedef cline_utils::option_constraint oc;
+
+struct path_values
+{
+   std::string input;
+   std::vector<std::string> includes;
+   std::string tool;
+};
+
+/************************************************************************/
+/*
+* \brief Create an empty file
+* 
+*/
+static void touch(const std::string &filename, mode_t mode = 0644)
+{
+   std::ofstream out(filename);
+   out.close();
+   chmod(filename.c_str(), mode);
+}
+
+/************************************************************************/
+/*
+* \brief Message of the exception thrown by the parse, empty if none
+* 
+*/
+static std::string parse_error(cline_utils::CommandLineParser &cline)
+{
+   try
+   {
+      cline.parse_command_line();
+   }
+   catch(const cline_utils::cline_exception &e)
+   {
+      return(e.what());
+   }
+   return(std::string());
+}
+
+static void add_path_options(cline_utils::CommandLineParser &cline, path_values &v)
+{
+   std::vector<cline_utils::option_longer> longer_options = 
+      {
+         cline_utils::make_option("input", 'i', v.input, " Input file", required_option, {oc::path(oc::path_file | oc::path_readable)}),
+         cline_utils::make_option("include", 'I', v.includes, " Include directory, repeatable", optional_option, {oc::path(oc::path_directory)}),
+         cline_utils::make_option("tool", 't', v.tool, " Helper program", optional_option, {oc::path(oc::path_executable)}),
+      };
+   cline.add_options(longer_options);
+   cline.set_positional_arity(0);
+   cline.set_positional_path_checks(oc::path_file);
+}
+
+/************************************************************************/
+/*
+* \brief Single, repeated and positional path options
+* 
+*/
+TEST_CASE("Path Options","[MUSTPASS]")
+{
+   char directory[] = "/tmp/cline_paths_XXXXXX";
+   REQUIRE(NULL != mkdtemp(directory));
+   const std::string dir(directory);
+   mkdir((dir + "/inc1").c_str(), 0700);
+   mkdir((dir + "/inc2").c_str(), 0700);
+   touch(dir + "/data.txt");
+   touch(dir + "/run.sh", 0755);
+
+   {
+      path_values v;
+      cline_utils::ArgvBuilder arguments = cline_utils::ArgvBuilder::split(
+         "tool -i " + dir + "/data.txt -I " + dir + "/inc1 --include=" + dir + "/inc2 -t " + dir + "/run.sh " + dir + "/data.txt");
+      cline_utils::CommandLineParser cline(arguments.argc(), arguments.argv());
+      add_path_options(cline, v);
+      cline.parse_command_line();
+      REQUIRE(dir + "/data.txt" == v.input);
+      REQUIRE((std::vector<std::string>{dir + "/inc1", dir + "/inc2"} == v.includes));
+      REQUIRE(1 == cline.get_positional_arguments().size());
+
+      // Repeated options in the other outputs
+      std::string json = cline.format_input_summary(cline_utils::summary_json);
+      REQUIRE(std::string::npos != json.find("\"type\":\"string_list\""));
+      REQUIRE(std::string::npos != json.find("\"value\":[\"" + dir + "/inc1\",\"" + dir + "/inc2\"]"));
+
+      std::vector<char> record = cline.serialize_snapshot();
+      v.includes.clear();
+      cline.load_snapshot(record.data(), record.size());
+      REQUIRE((std::vector<std::string>{dir + "/inc1", dir + "/inc2"} == v.includes));
+
+      int fd = cline.publish_shared_config();
+      {
+         cline_utils::shared_config_view view = cline_utils::shared_config_view::attach(fd);
+         REQUIRE((std::vector<std::string>{dir + "/inc1", dir + "/inc2"} == view.get<std::vector<std::string>>("include")));
+      }
+      close(fd);
+
+      // Re-parse sees a changed list
+      cline_utils::ArgvBuilder next = cline_utils::ArgvBuilder::split("tool -i " + dir + "/data.txt -I " + dir + "/inc2");
+      REQUIRE((std::vector<int>{'I', 't'} == cline.reparse_command_line(next.argc(), next.argv())));
+      REQUIRE((std::vector<std::string>{dir + "/inc2"} == v.includes));
+   }
+
+   // Every failure is reported in one exception
+   {
+      path_values v;
+      cline_utils::ArgvBuilder arguments = cline_utils::ArgvBuilder::split(
+         "tool -i " + dir + "/inc1 -I " + dir + "/data.txt -I " + dir + "/missing -t " + dir + "/data.txt " + dir + "/gone.txt");
+      cline_utils::CommandLineParser cline(arguments.argc(), arguments.argv());
+      add_path_options(cline, v);
+      std::string what = parse_error(cline);
+      REQUIRE(std::string::npos != what.find("5 constraint violation(s)"));
+      REQUIRE(std::string::npos != what.find("--input (-i): '" + dir + "/inc1' is not a regular file"));
+      REQUIRE(std::string::npos != what.find("--include (-I): '" + dir + "/data.txt' is not a directory"));
+      REQUIRE(std::string::npos != what.find("--include (-I): '" + dir + "/missing': No such file or directory"));
+      REQUIRE(std::string::npos != what.find("--tool (-t): '" + dir + "/data.txt' is not executable"));
+      REQUIRE(std::string::npos != what.find("positional argument: '" + dir + "/gone.txt': No such file or directory"));
+   }
+
+   for(const char *name : {"data.txt", "run.sh"}) unlink((dir + "/" + name).c_str());
+   rmdir((dir + "/inc1").c_str());
+   rmdir((dir + "/inc2").c_str());
+   rmdir(directory);
+}
+
+/************************************************************************/
+/*
+* \brief Thousands of positional paths are checked in one parallel batch and
+*        the report stays short
+* 
+*/
+TEST_CASE("Bulk Path Validation","[MUSTPASS]")
+{
+   char directory[] = "/tmp/cline_paths_XXXXXX";
+   REQUIRE(NULL != mkdtemp(directory));
+   const std::string dir(directory);
+
+   const size_t files = 20000, missing = 500;
+   cline_utils::ArgvBuilder arguments{"tool", "-i", dir + "/0"};
+   for(size_t i = 0; i < files; ++i)
+   {
+      const std::string name = dir + "/" + std::to_string(i);
+      if(i >= missing) touch(name);
+      arguments.push_back(name);
+   }
+
+   path_values v;
+   cline_utils::CommandLineParser cline(arguments.argc(), arguments.argv());
+   add_path_options(cline, v);
+
+   auto start = std::chrono::steady_clock::now();
+   std::string what = parse_error(cline);
+   double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   std::cout << "Validated " << files + 1 << " paths in " << seconds << " s" << std::endl;
+   REQUIRE(std::string::npos != what.find(std::to_string(missing + 1) + " constraint violation(s)"));
+   REQUIRE(std::string::npos != what.find("positional argument: ... and " + std::to_string(missing - 10) + " more path(s)"));
+
+   for(size_t i = missing; i < files; ++i) unlink((dir + "/" + std::to_string(i)).c_str());
+   rmdir(directory);
+}
+
+/************************************************************************/
+/*
+* \brief Driver function for Catch2 tests. Not clear to me how to use
+*        Catch::Session().run() with LONG command line arguments... 
+*        so quick hack using globals
+*
+*     @param[in] int argc: Integer variable storing number of command line arguments (including executable name)    
+*     @param[in] char **argv: Array of character pointers listing all the arguments    
+*     @return int: Success status
+* 
+*/
+int runCatchTests(int argc, char* const argv[])
+{
+   //std::cout << "-- BEGIN runCatchTests --" << std::endl;
+
+   // Owned, NULL terminated copy of the arguments in one allocation
+   cline_utils::ArgvBuilder arguments(argc, argv);
+   _G_argc = arguments.argc();
+   _G_argv = arguments.argv();
+
+   // Creat the command line parser
+   _G_cline = new cline_utils::CommandLineParser(_G_argc, _G_argv);
+
+   // Call potential tests
+   int result = Catch::Session().run();
+
+   // Clean up memory
+   delete _G_cline;
+
+   //std::cout << "-- END runCatchTests --" << std::endl;
+
+   // Return to main
+   return result;
+}
+
+/************************************************************************/
+/*
+* \brief Main function not built into Catch2...
+*
+*     @return int.
+* 
+*/
+int main(int argc, char* const argv[])
+{
+   return runCatchTests(argc, argv);
+}
\ No newline at end of file
@@ -0,0 +1,252 @@
+// -----------------------------------------------------------------------
+//
+//                        test_optlonger_pmr.cpp V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#include <iostream>
+#include <cstdlib>
+#include <fstream>
+#include <unistd.h>
+#include <new>
+#include <memory_resource>
+
+#define CATCH_CONFIG_RUNNER
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_session.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "cline_utils.h"
+
+// Cheesy global test variables to make things quicker.
+int _G_argc;
+char** _G_argv; //std::vector<std::string> Gargv;
+cline_utils::CommandLineParser *_G_cline;   
+
+// Every global operator new call is counted. GCC cannot tell these are a
+// matching pair and warns about malloc/free behind new/delete.
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+static size_t _G_new_calls = 0;
+
+void *operator new(size_t size)
+{
+   ++_G_new_calls;
+   void *ptr = malloc((0 == size) ? 1 : size);
+   if(NULL == ptr) throw std::bad_alloc();
+   return(ptr);
+}
+
+void operator delete(void *ptr) noexcept
+{
+   free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+   free(ptr);
+}
+
+// std::pmr::new_delete_resource() allocates through the aligned forms
+void *operator new(size_t size, std::align_val_t alignment)
+{
+   ++_G_new_calls;
+   void *ptr = aligned_alloc(size_t(alignment), (size + size_t(alignment) - 1) / size_t(alignment) * size_t(alignment));
+   if(NULL == ptr) throw std::bad_alloc();
+   return(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept
+{
+   free(ptr);
+}
+
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept
+{
+   free(ptr);
+}
+
+/************************************************************************/
+/*
+* \brief Once warmed up, parsing again takes all its memory from the memory
+*        resource given to the parser and never calls the global operator new
+* 
+*/
+TEST_CASE("Steady State Parse Without Global Allocation","[MUSTPASS]")
+{
+   double parameter1D = std::nan("1"),
+          parameter2D = 3.14;
+
+   int helpFlag    = 0,
+       parameter3I = 100,
+       verboseFlag = 0,
+       quietFlag   = 0;
+
+   std::string parameter4S("");
+
+   std::vector<cline_utils::option_longer> longer_options = 
+      {
+         {"help"     , no_argument      , NULL, 'h', optional_option, typeid(helpFlag).name()          , &helpFlag   , " Optional help option that must be h"},
+         {"longName1", required_argument, NULL, 'a', required_option, typeid(parameter1D).name()       , &parameter1D, " Required option with required double argument [physical units]"},
+         {"longName2", required_argument, NULL, 'b', required_option, typeid(parameter2D).name()       , &parameter2D, " Required option with required double argument []"},
+         {"longName3", required_argument, NULL, 'c', optional_option, typeid(parameter3I).name()       , &parameter3I, " Optional option with a required integer arugment if used",
+          {cline_utils::option_constraint::between(0, 10)}},
+         {"longName4", required_argument, NULL, 'd', required_option, typeid(parameter4S.data()).name(), &parameter4S, " Required option with required string argument"},
+         {"verbose"  , no_argument      , NULL, 'v', optional_option, typeid(verboseFlag).name()       , &verboseFlag, " Verbose output"},
+         {"quiet"    , no_argument      , NULL, 'q', optional_option, typeid(quietFlag).name()         , &quietFlag  , " No output"},
+      };
+
+   static char buffer[1 << 20];
+   std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+   std::pmr::unsynchronized_pool_resource pool(&arena);
+
+   size_t new_calls = 0;
+   {
+      cline_utils::CommandLineParser cline(_G_argc, _G_argv, longer_options, &pool);
+      cline.add_option_group(cline_utils::group_at_most_one, {'v', 'q'});
+      cline.set_positional_arity(0, 4);
+
+      // Warm up: default values are captured and the bound string is sized
+      cline.parse_command_line();
+
+      const size_t before = _G_new_calls;
+      for(int i = 0; i < 100; ++i)
+      {
+         cline.parse_command_line();
+      }
+      new_calls = _G_new_calls - before;
+   }
+
+   REQUIRE(0 == new_calls);
+   REQUIRE(4 == parameter2D);
+   REQUIRE(3 == parameter3I);
+   REQUIRE(1 == verboseFlag);
+   REQUIRE("a_file_name_longer_than_the_small_string_buffer.txt" == parameter4S);
+
+   // Everything the parser held goes back to the arena at once
+   arena.release();
+}
+
+/************************************************************************/
+/*
+* \brief Config files and their includes are read and parsed in the memory
+*        resource too
+* 
+*/
+TEST_CASE("Steady State Parse Of Config Files Without Global Allocation","[MUSTPASS]")
+{
+   double parameter1D = std::nan("1"),
+          parameter2D = 3.14;
+
+   int helpFlag    = 0,
+       parameter3I = 100,
+       verboseFlag = 0;
+
+   std::string parameter4S("");
+
+   std::vector<cline_utils::option_longer> longer_options = 
+      {
+         {"help"     , no_argument      , NULL, 'h', optional_option, typeid(helpFlag).name()          , &helpFlag   , " Optional help option that must be h"},
+         {"longName1", required_argument, NULL, 'a', required_option, typeid(parameter1D).name()       , &parameter1D, " Required option with required double argument [physical units]"},
+         {"longName2", required_argument, NULL, 'b', required_option, typeid(parameter2D).name()       , &parameter2D, " Required option with required double argument []"},
+         {"longName3", required_argument, NULL, 'c', optional_option, typeid(parameter3I).name()       , &parameter3I, " Optional option with a required integer arugment if used"},
+         {"longName4", required_argument, NULL, 'd', required_option, typeid(parameter4S.data()).name(), &parameter4S, " Required option with required string argument"},
+         {"verbose"  , no_argument      , NULL, 'v', optional_option, typeid(verboseFlag).name()       , &verboseFlag, " Verbose output"},
+      };
+
+   char dir_template[] = "/tmp/cline_pmr_XXXXXX";
+   REQUIRE(NULL != mkdtemp(dir_template));
+   const std::string dir(dir_template);
+   {
+      std::ofstream out(dir + "/site.conf");
+      out << "# Site defaults\nlongName1 = 7\n@include \"extra.conf\"\n";
+   }
+   {
+      std::ofstream out(dir + "/extra.conf");
+      out << "longName2 = 9\nlongName3 = \"2\"\n";
+   }
+
+   static char buffer[1 << 20];
+   std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+   std::pmr::unsynchronized_pool_resource pool(&arena);
+
+   size_t new_calls = 0;
+   cline_utils::file_batch::backend_kind backend;
+   {
+      cline_utils::CommandLineParser cline(_G_argc, _G_argv, longer_options, &pool);
+      cline.set_positional_arity(0, 4);
+      cline.set_config_file(dir + "/site.conf");
+
+      cline.parse_command_line();
+
+      const size_t before = _G_new_calls;
+      for(int i = 0; i < 100; ++i)
+      {
+         cline.parse_command_line();
+      }
+      new_calls = _G_new_calls - before;
+      backend = cline.get_config_backend();
+   }
+
+   // The thread pool fallback (no io_uring) queues its reads on the global heap
+   if(cline_utils::file_batch::backend_io_uring == backend)
+   {
+      REQUIRE(0 == new_calls);
+   }
+   REQUIRE(4 == parameter2D);
+   REQUIRE(3 == parameter3I);
+   REQUIRE(5 == parameter1D);
+
+   unlink((dir + "/extra.conf").c_str());
+   unlink((dir + "/site.conf").c_str());
+   rmdir(dir.c_str());
+   arena.release();
+}
+
+/************************************************************************/
+/*
+* \brief Driver function for Catch2 tests. Not clear to me how to use
+*        Catch::Session().run() with LONG command line arguments... 
+*        so quick hack using globals
+*
+*     @param[in] int argc: Integer variable storing number of command line arguments (including executable name)    
+*     @param[in] char **argv: Array of character pointers listing all the arguments    
+*     @return int: Success status
+* 
+*/
+int runCatchTests(int argc, char* const argv[])
+{
+   //std::cout << "-- BEGIN runCatchTests --" << std::endl;
+
+   // Owned, NULL terminated copy of the arguments in one allocation
+   cline_utils::ArgvBuilder arguments(argc, argv);
+   _G_argc = arguments.argc();
+   _G_argv = arguments.argv();
+
+   // Creat the command line parser
+   _G_cline = new cline_utils::CommandLineParser(_G_argc, _G_argv);
+
+   // Call potential tests
+   int result = Catch::Session().run();
+
+   // Clean up memory
+   delete _G_cline;
+
+   //std::cout << "-- END runCatchTests --" << std::endl;
+
+   // Return to main
+   return result;
+}
+
+/************************************************************************/
+/*
+* \brief Main function not built into Catch2...
+*
+*     @return int.
+* 
+*/
+int main(int argc, char* const argv[])
+{
+   return runCatchTests(argc, argv);
+}
\ No newline at end of file
@@ -0,0 +1,168 @@
+// -----------------------------------------------------------------------
+//
+//                        test_optlonger_positional.cpp V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#include <iostream>
+
+#define CATCH_CONFIG_RUNNER
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_session.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "cline_utils.h"
+
+// Cheesy global test variables to make things quicker.
+int _G_argc;
+char** _G_argv; //std::vector<std::string> Gargv;
+cline_utils::CommandLineParser *_G_cline;   
+
+/************************************************************************/
+/*
+* \brief Positional arguments after the options are viewed in place in argv
+* 
+*/
+TEST_CASE("Positional Arguments","[MUSTPASS]")
+{
+   double parameter1D = std::nan("1"),
+          parameter2D = 3.14;
+
+   int helpFlag    = 0,
+       parameter3I = 100;
+
+   std::string parameter4S("");
+
+   std::vector<cline_utils::option_longer> longer_options = 
+      {
+         {"help"     , no_argument      , NULL, 'h', optional_option, typeid(helpFlag).name()          , &helpFlag   , " Optional help option that must be h"},
+         {"longName1", required_argument, NULL, 'a', required_option, typeid(parameter1D).name()       , &parameter1D, " Required option with required double argument [physical units]"},
+         {"longName2", required_argument, NULL, 'b', required_option, typeid(parameter2D).name()       , &parameter2D, " Required option with required double argument []"},
+         {"longName3", required_argument, NULL, 'c', optional_option, typeid(parameter3I).name()       , &parameter3I, " Optional option with a required integer arugment if used"},
+         {"longName4", required_argument, NULL, 'd', required_option, typeid(parameter4S.data()).name(), &parameter4S, " Required option with required string argument"},
+      };
+
+   _G_cline->add_options(longer_options);
+
+   // Rejected unless enabled
+   REQUIRE_THROWS_WITH(_G_cline->parse_command_line(), Catch::Matchers::ContainsSubstring("Arguments with no corresponding option: a.h5"));
+
+   _G_cline->set_positional_arity(2, 5);
+   _G_cline->parse_command_line();
+   REQUIRE(4 == parameter2D);
+   REQUIRE("hello.txt" == parameter4S);
+
+   const cline_utils::positional_view &files = _G_cline->get_positional_arguments();
+   REQUIRE(4 == files.size());
+   REQUIRE(_G_argv + 6 == files.data()); // No copy, straight into argv
+   REQUIRE(std::string("a.h5") == files[0]);
+   REQUIRE(std::string("b.h5") == files[1]);
+   REQUIRE(17 == files.as<int>(2));
+   REQUIRE(17u == files.as<uint8_t>(2));
+   REQUIRE(2.5 == files.as<double>(3));
+   REQUIRE("a.h5" == files.as<std::string>(0));
+   REQUIRE_THROWS_WITH(files.as<int>(0), Catch::Matchers::ContainsSubstring("Positional argument 0 'a.h5'"));
+   REQUIRE_THROWS_WITH(files.as<int>(3), Catch::Matchers::ContainsSubstring("not an integer"));
+   REQUIRE_THROWS(files.as<int>(4));
+
+   size_t count = 0;
+   for(const char *file : files)
+   {
+      count += (NULL != file);
+   }
+   REQUIRE(4 == count);
+
+   _G_cline->set_positional_arity(5, 6);
+   REQUIRE_THROWS_WITH(_G_cline->parse_command_line(), Catch::Matchers::ContainsSubstring("Expected at least 5 positional argument(s), got 4"));
+   _G_cline->set_positional_arity(0, 3);
+   REQUIRE_THROWS_WITH(_G_cline->parse_command_line(), Catch::Matchers::ContainsSubstring("no corresponding option: 2.5"));
+
+   _G_cline->delete_all_options();
+}
+
+/************************************************************************/
+/*
+* \brief Positionals mixed with options and after "--" keep their order and
+*        argv is not reordered
+* 
+*/
+TEST_CASE("Interleaved Positional Arguments","[MUSTPASS]")
+{
+   int verboseFlag = 0,
+       parameter3I = 100;
+
+   std::vector<cline_utils::option_longer> longer_options = 
+      {
+         {"verbose"  , no_argument      , NULL, 'v', optional_option, typeid(verboseFlag).name(), &verboseFlag, " Verbose output"},
+         {"longName3", required_argument, NULL, 'c', optional_option, typeid(parameter3I).name(), &parameter3I, " Optional option with a required integer arugment if used"},
+      };
+
+   const char *arguments[] = {"reducer", "first.h5", "-v", "second.h5", "-c", "7", "--", "-third.h5", NULL};
+   char *argv[9];
+   for(int i = 0; i < 9; ++i) argv[i] = (char *)arguments[i];
+
+   cline_utils::CommandLineParser cline(8, argv, longer_options);
+   cline.set_positional_arity(1);
+   cline.parse_command_line();
+
+   const cline_utils::positional_view &files = cline.get_positional_arguments();
+   REQUIRE(3 == files.size());
+   REQUIRE(arguments[1] == files[0]);
+   REQUIRE(arguments[3] == files[1]);
+   REQUIRE(arguments[7] == files[2]);
+   REQUIRE(1 == verboseFlag);
+   REQUIRE(7 == parameter3I);
+   for(int i = 0; i < 8; ++i)
+   {
+      REQUIRE(arguments[i] == argv[i]);
+   }
+}
+
+/************************************************************************/
+/*
+* \brief Driver function for Catch2 tests. Not clear to me how to use
+*        Catch::Session().run() with LONG command line arguments... 
+*        so quick hack using globals
+*
+*     @param[in] int argc: Integer variable storing number of command line arguments (including executable name)    
+*     @param[in] char **argv: Array of character pointers listing all the arguments    
+*     @return int: Success status
+* 
+*/
+int runCatchTests(int argc, char* const argv[])
+{
+   //std::cout << "-- BEGIN runCatchTests --" << std::endl;
+
+   // Owned, NULL terminated copy of the arguments in one allocation
+   cline_utils::ArgvBuilder arguments(argc, argv);
+   _G_argc = arguments.argc();
+   _G_argv = arguments.argv();
+
+   // Creat the command line parser
+   _G_cline = new cline_utils::CommandLineParser(_G_argc, _G_argv);
+
+   // Call potential tests
+   int result = Catch::Session().run();
+
+   // Clean up memory
+   delete _G_cline;
+
+   //std::cout << "-- END runCatchTests --" << std::endl;
+
+   // Return to main
+   return result;
+}
+
+/************************************************************************/
+/*
+* \brief Main function not built into Catch2...
+*
+*     @return int.
+* 
+*/
+int main(int argc, char* const argv[])
+{
+   return runCatchTests(argc, argv);
+}
\ No newline at end of file
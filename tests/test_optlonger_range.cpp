@@ -0,0 +1,126 @@
+// -----------------------------------------------------------------------
+//
+//                        test_optlonger_range.cpp V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#include <iostream>
+
+#define CATCH_CONFIG_RUNNER
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_session.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "cline_utils.h"
+
+// Cheesy global test variables to make things quicker.
+int _G_argc;
+char** _G_argv; //std::vector<std::string> Gargv;
+cline_utils::CommandLineParser *_G_cline;   
+
+/************************************************************************/
+/*
+* \brief Range valued options for parameter scans
+* 
+*/
+TEST_CASE("Range Options","[Range]")
+{
+   cline_utils::range density, angle, charge;
+
+   int helpFlag = 0;
+
+   std::vector<cline_utils::option_longer> longer_options = 
+      {
+         {"help"   , no_argument      , NULL, 'h', optional_option, typeid(helpFlag).name()          , &helpFlag, " Optional help option that must be h"},
+         {"density", required_argument, NULL, 'n', required_option, typeid(cline_utils::range).name(), &density , " Density scan [m^-3]"},
+         {"angle"  , required_argument, NULL, 'a', required_option, typeid(cline_utils::range).name(), &angle   , " Angle scan [degrees]"},
+         {"charge" , required_argument, NULL, 'z', optional_option, typeid(cline_utils::range).name(), &charge  , " Charge states"},
+      };
+
+   _G_cline->add_options(longer_options);
+   REQUIRE_NOTHROW(_G_cline->parse_command_line());
+
+   REQUIRE(400 == density.size());
+   REQUIRE(1e15 == density[0]);
+   REQUIRE(1e18 == density[399]);
+   REQUIRE(std::fabs(density[133] / density[132] - std::pow(1e3, 1.0 / 399)) < 1e-12);
+
+   REQUIRE(721 == angle.size());
+   REQUIRE(0.0 == angle[0]);
+   REQUIRE(180.0 == angle[360]);
+   REQUIRE(360.0 == angle[720]);
+
+   REQUIRE(3 == charge.size());
+   REQUIRE(5.0 == charge[2]);
+   REQUIRE_THROWS(charge.at(3));
+
+   // A million point sweep is a handful of parameters, not a million doubles
+   cline_utils::range sweep = cline_utils::range::parse("0:1:lin:1000001");
+   REQUIRE(1000001 == sweep.size());
+   REQUIRE(0.5 == sweep[500000]);
+   REQUIRE(sweep.get_list().empty());
+
+   REQUIRE_THROWS_WITH(cline_utils::range::parse("0:-1:10"), Catch::Matchers::ContainsSubstring("Step does not reach stop value"));
+   REQUIRE_THROWS_WITH(cline_utils::range::parse("0:10:log:5"), Catch::Matchers::ContainsSubstring("Logarithmic range limits"));
+   REQUIRE_THROWS_WITH(cline_utils::range::parse("1,x,3"), Catch::Matchers::ContainsSubstring("Invalid number"));
+
+   // Ranges survive a snapshot round trip by their parameters
+   std::vector<char> record = _G_cline->serialize_snapshot();
+   density = cline_utils::range();
+   charge = cline_utils::range();
+   REQUIRE_NOTHROW(_G_cline->load_snapshot(record));
+   REQUIRE(400 == density.size());
+   REQUIRE(1e18 == density[399]);
+   REQUIRE(2.0 == charge[1]);
+
+   _G_cline->delete_all_options();
+}
+
+/************************************************************************/
+/*
+* \brief Driver function for Catch2 tests. Not clear to me how to use
+*        Catch::Session().run() with LONG command line arguments... 
+*        so quick hack using globals
+*
+*     @param[in] int argc: Integer variable storing number of command line arguments (including executable name)    
+*     @param[in] char **argv: Array of character pointers listing all the arguments    
+*     @return int: Success status
+* 
+*/
+int runCatchTests(int argc, char* const argv[])
+{
+   //std::cout << "-- BEGIN runCatchTests --" << std::endl;
+
+   // Owned, NULL terminated copy of the arguments in one allocation
+   cline_utils::ArgvBuilder arguments(argc, argv);
+   _G_argc = arguments.argc();
+   _G_argv = arguments.argv();
+
+   // Creat the command line parser
+   _G_cline = new cline_utils::CommandLineParser(_G_argc, _G_argv);
+
+   // Call potential tests
+   int result = Catch::Session().run();
+
+   // Clean up memory
+   delete _G_cline;
+
+   //std::cout << "-- END runCatchTests --" << std::endl;
+
+   // Return to main
+   return result;
+}
+
+/************************************************************************/
+/*
+* \brief Main function not built into Catch2...
+*
+*     @return int.
+* 
+*/
+int main(int argc, char* const argv[])
+{
+   return runCatchTests(argc, argv);
+}
\ No newline at end of file
@@ -0,0 +1,159 @@
+// -----------------------------------------------------------------------
+//
+//                        test_optlonger_reparse.cpp V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#include <iostream>
+
+#define CATCH_CONFIG_RUNNER
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_session.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "cline_utils.h"
+
+// Cheesy global test variables to make things quicker.
+int _G_argc;
+char** _G_argv; //std::vector<std::string> Gargv;
+cline_utils::CommandLineParser *_G_cline;   
+
+/************************************************************************/
+/*
+* \brief Re-parsing converts only what changed and reports it
+* 
+*/
+TEST_CASE("Incremental Reparse","[MUSTPASS]")
+{
+   double parameter1D = std::nan("1"),
+          parameter2D = 3.14;
+
+   int verboseFlag = 0,
+       parameter3I = 100;
+
+   std::string parameter4S("");
+   int64_t samples = 10;
+
+   typedef cline_utils::option_constraint oc;
+
+   std::vector<cline_utils::option_longer> longer_options = 
+      {
+         {"verbose"  , no_argument      , NULL, 'v', optional_option, typeid(verboseFlag).name()       , &verboseFlag, " Verbose output"},
+         {"longName1", required_argument, NULL, 'a', required_option, typeid(parameter1D).name()       , &parameter1D, " Required option with required double argument [physical units]"},
+         {"longName2", required_argument, NULL, 'b', required_option, typeid(parameter2D).name()       , &parameter2D, " Required option with required double argument []",
+          {oc::positive()}},
+         {"longName3", required_argument, NULL, 'c', optional_option, typeid(parameter3I).name()       , &parameter3I, " Optional option with a required integer arugment if used"},
+         {"longName4", required_argument, NULL, 'd', required_option, typeid(parameter4S.data()).name(), &parameter4S, " Required option with required string argument"},
+         cline_utils::make_option("samples", 's', samples, " Number of samples"),
+      };
+
+   _G_cline->add_options(longer_options);
+   _G_cline->parse_command_line();
+   REQUIRE(4 == parameter2D);
+   REQUIRE(5 == parameter1D);
+   REQUIRE("hello.txt" == parameter4S);
+   REQUIRE(100 == parameter3I);
+
+   // Same tokens in another order: nothing to do. A bound variable changed
+   // behind the parser's back shows that nothing was rewritten.
+   cline_utils::ArgvBuilder same = cline_utils::ArgvBuilder::split("tool -d hello.txt --longName1=5 -b 4");
+   parameter4S = "untouched";
+   REQUIRE(_G_cline->reparse_command_line(same.argc(), same.argv()).empty());
+   REQUIRE("untouched" == parameter4S);
+   parameter4S = "hello.txt";
+
+   // One value changes, two options are added
+   cline_utils::ArgvBuilder next = cline_utils::ArgvBuilder::split("tool -b 4 --longName1=6 -d hello.txt -c 7 -v");
+   std::vector<int> changed = _G_cline->reparse_command_line(next.argc(), next.argv());
+   REQUIRE((std::vector<int>{'v', 'a', 'c'} == changed));
+   REQUIRE(6 == parameter1D);
+   REQUIRE(7 == parameter3I);
+   REQUIRE(1 == verboseFlag);
+   REQUIRE(cline_utils::source_command_line == _G_cline->get_option_source('c'));
+
+   // Options dropped from the command line get their defaults back
+   cline_utils::ArgvBuilder fewer = cline_utils::ArgvBuilder::split("tool -b 4 --longName1=6 -d hello.txt --samples=5000000000");
+   changed = _G_cline->reparse_command_line(fewer.argc(), fewer.argv());
+   REQUIRE((std::vector<int>{'v', 'c', 's'} == changed));
+   REQUIRE(0 == verboseFlag);
+   REQUIRE(100 == parameter3I);
+   REQUIRE(5000000000 == samples);
+   REQUIRE(cline_utils::source_default == _G_cline->get_option_source('c'));
+
+   // Invalid command lines leave the previous parse in effect
+   cline_utils::ArgvBuilder invalid = cline_utils::ArgvBuilder::split("tool -b -4 --longName1=7 -d other.txt");
+   REQUIRE_THROWS_WITH(_G_cline->reparse_command_line(invalid.argc(), invalid.argv()), Catch::Matchers::ContainsSubstring("1 constraint violation(s)"));
+   REQUIRE(6 == parameter1D);
+   REQUIRE(4 == parameter2D);
+   REQUIRE("hello.txt" == parameter4S);
+
+   cline_utils::ArgvBuilder overflow = cline_utils::ArgvBuilder::split("tool -b 4 --longName1=7 -d hello.txt --samples=9223372036854775808");
+   REQUIRE_THROWS_WITH(_G_cline->reparse_command_line(overflow.argc(), overflow.argv()), Catch::Matchers::ContainsSubstring("out of range"));
+   REQUIRE(6 == parameter1D);
+
+   cline_utils::ArgvBuilder missing = cline_utils::ArgvBuilder::split("tool -b 4 --longName1=7");
+   REQUIRE_THROWS_WITH(_G_cline->reparse_command_line(missing.argc(), missing.argv()), Catch::Matchers::ContainsSubstring("Missing required option"));
+   REQUIRE(cline_utils::source_command_line == _G_cline->get_option_source('d'));
+
+   // Still diffed against the last good parse
+   changed = _G_cline->reparse_command_line(fewer.argc(), fewer.argv());
+   REQUIRE(changed.empty());
+
+   // Cross constraints see the new values, and a violation rolls them back
+   _G_cline->add_cross_constraint([&]{ return parameter1D < 10; }, "longName1 must be below 10");
+   cline_utils::ArgvBuilder large = cline_utils::ArgvBuilder::split("tool -b 4 --longName1=12 -d hello.txt");
+   REQUIRE_THROWS_WITH(_G_cline->reparse_command_line(large.argc(), large.argv()), Catch::Matchers::ContainsSubstring("longName1 must be below 10"));
+   REQUIRE(6 == parameter1D);
+   REQUIRE(5000000000 == samples);
+
+   _G_cline->delete_all_options();
+}
+
+/************************************************************************/
+/*
+* \brief Driver function for Catch2 tests. Not clear to me how to use
+*        Catch::Session().run() with LONG command line arguments... 
+*        so quick hack using globals
+*
+*     @param[in] int argc: Integer variable storing number of command line arguments (including executable name)    
+*     @param[in] char **argv: Array of character pointers listing all the arguments    
+*     @return int: Success status
+* 
+*/
+int runCatchTests(int argc, char* const argv[])
+{
+   //std::cout << "-- BEGIN runCatchTests --" << std::endl;
+
+   // Owned, NULL terminated copy of the arguments in one allocation
+   cline_utils::ArgvBuilder arguments(argc, argv);
+   _G_argc = arguments.argc();
+   _G_argv = arguments.argv();
+
+   // Creat the command line parser
+   _G_cline = new cline_utils::CommandLineParser(_G_argc, _G_argv);
+
+   // Call potential tests
+   int result = Catch::Session().run();
+
+   // Clean up memory
+   delete _G_cline;
+
+   //std::cout << "-- END runCatchTests --" << std::endl;
+
+   // Return to main
+   return result;
+}
+
+/************************************************************************/
+/*
+* \brief Main function not built into Catch2...
+*
+*     @return int.
+* 
+*/
+int main(int argc, char* const argv[])
+{
+   return runCatchTests(argc, argv);
+}
\ No newline at end of file
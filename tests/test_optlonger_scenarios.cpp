@@ -0,0 +1,217 @@
+// -----------------------------------------------------------------------
+//
+//                        test_optlonger_scenarios.cpp V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#include <iostream>
+
+#define CATCH_CONFIG_RUNNER
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_session.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "cline_scenario.h"
+
+// Cheesy global test variables to make things quicker.
+int _G_argc;
+char** _G_argv; //std::vector<std::string> Gargv;
+cline_utils::CommandLineParser *_G_cline;   
+
+/************************************************************************/
+/*
+* \brief Bound variables of the scenario schema, defaults included
+* 
+*/
+struct scenario_values
+{
+   double parameter1D = std::nan("1"),
+          parameter2D = 3.14;
+
+   int helpFlag    = 0,
+       parameter3I = 100;
+
+   std::string parameter4S;
+};
+
+static void add_scenario_options(cline_utils::CommandLineParser &cline, scenario_values &v)
+{
+   cline.add_options(
+      {
+         {"help"     , no_argument      , NULL, 'h', optional_option, typeid(v.helpFlag).name()          , &v.helpFlag   , " Optional help option that must be h"},
+         {"longName1", required_argument, NULL, 'a', required_option, typeid(v.parameter1D).name()       , &v.parameter1D, " Required option with required double argument [physical units]"},
+         {"longName2", required_argument, NULL, 'b', required_option, typeid(v.parameter2D).name()       , &v.parameter2D, " Required option with required double argument []"},
+         {"longName3", required_argument, NULL, 'c', optional_option, typeid(v.parameter3I).name()       , &v.parameter3I, " Optional option with a required integer arugment if used"},
+         {"longName4", required_argument, NULL, 'd', required_option, typeid(v.parameter4S.data()).name(), &v.parameter4S, " Required option with required string argument"},
+      });
+}
+
+/************************************************************************/
+/*
+* \brief Argument vectors are one owned allocation that survives growth
+* 
+*/
+TEST_CASE("Argv Builder","[MUSTPASS]")
+{
+   cline_utils::ArgvBuilder args = cline_utils::ArgvBuilder::split("tool -b 4 --longName4='two words' \"say \\\"hi\\\"\" a\\ b ''");
+   REQUIRE(7 == args.argc());
+   REQUIRE(std::string("tool") == args[0]);
+   REQUIRE(std::string("--longName4=two words") == args[3]);
+   REQUIRE(std::string("say \"hi\"") == args[4]);
+   REQUIRE(std::string("a b") == args[5]);
+   REQUIRE(std::string("") == args[6]);
+   REQUIRE(NULL == args.argv()[7]);
+
+   // Grow well past the first block: everything stays in one allocation
+   for(int i = 0; i < 1000; ++i)
+   {
+      args.push_back("argument_" + std::to_string(i));
+   }
+   char **argv = args.argv();
+   const char *first = (const char *)argv;
+   const char *last = first + args.memory_usage();
+   REQUIRE(1007 == args.argc());
+   REQUIRE(std::string("argument_999") == argv[1006]);
+   REQUIRE(NULL == argv[1007]);
+   for(int i = 0; i < args.argc(); ++i)
+   {
+      REQUIRE(first < argv[i]);
+      REQUIRE(argv[i] < last);
+   }
+
+   // Copies are deep
+   cline_utils::ArgvBuilder copy(args.argc(), argv);
+   REQUIRE(std::string(args[3]) == copy[3]);
+   REQUIRE(args[3] != copy[3]);
+
+   size_t capacity = args.memory_usage();
+   args.clear();
+   REQUIRE(0 == args.argc());
+   REQUIRE(capacity == args.memory_usage());
+
+   // Appending one of its own arguments survives the block moving
+   cline_utils::ArgvBuilder self{"tool", "--longName4=two words"};
+   for(int i = 0; i < 64; ++i)
+   {
+      self.push_back(self.argv()[self.argc() - 1]);
+   }
+   REQUIRE(66 == self.argc());
+   for(int i = 1; i < self.argc(); ++i)
+   {
+      REQUIRE(std::string("--longName4=two words") == self[i]);
+   }
+
+   REQUIRE_THROWS_WITH(cline_utils::ArgvBuilder::split("tool 'open"), Catch::Matchers::ContainsSubstring("Unterminated quote"));
+}
+
+/************************************************************************/
+/*
+* \brief Table driven rows run against fresh parsers in this process
+* 
+*/
+TEST_CASE("Scenario Runner","[MUSTPASS]")
+{
+   cline_utils::ScenarioRunner<scenario_values> runner(add_scenario_options);
+
+   runner.expect_pass("all options", "-b 4 --longName1=5 -c 3 -d 'hello world.txt'",
+      [](cline_utils::CommandLineParser &, const scenario_values &v)
+      {
+         return((5 == v.parameter1D && 3 == v.parameter3I && "hello world.txt" == v.parameter4S) ? "" : "wrong values");
+      });
+   runner.expect_pass("defaults untouched", "-b 4 --longName1=5 -d x",
+      [](cline_utils::CommandLineParser &, const scenario_values &v)
+      {
+         return((100 == v.parameter3I) ? "" : "defaults leaked from an earlier row");
+      });
+
+   std::istringstream table(
+      "# Same schema as the hardcoded argv tests\n"
+      "pass | -b 4 --longName1=5 -d 'hello.txt'\n"
+      "\n"
+      "fail Missing required option | -b 4 --longName1=5\n"
+      "fail Missing argument for option: c | -b 4 --longName1=5 -d x -c\n"
+      "fail Unrecognized option | -b 4 --longName1=5 -d x --nope\n"
+      "fail Arguments with no corresponding option | -b 4 --longName1=5 -d x stray.h5\n"
+      "fail Help Option Selected | -h\n");
+   REQUIRE(6 == runner.load_table(table, "inline"));
+
+   // Thousands of rows in one process
+   for(int i = 0; i < 2000; ++i)
+   {
+      const int expected = i;
+      runner.expect_pass("generated " + std::to_string(i), "-b 4 --longName1=5 -d x -c " + std::to_string(i),
+         [expected](cline_utils::CommandLineParser &, const scenario_values &v)
+         {
+            return((expected == v.parameter3I) ? "" : "got " + std::to_string(v.parameter3I));
+         });
+   }
+
+   cline_utils::scenario_report report = runner.run();
+   report.print(std::cout);
+   REQUIRE(report.ok());
+   REQUIRE(2008 == report.run);
+   REQUIRE(2008 == report.passed);
+
+   // Wrong expectations are reported, not thrown
+   cline_utils::ScenarioRunner<scenario_values> broken(add_scenario_options);
+   broken.expect_pass("missing", "-b 4");
+   broken.expect_error("parses", "-b 4 --longName1=5 -d x", "anything");
+   broken.expect_error("other error", "-b 4 --longName1=5", "Unrecognized");
+   cline_utils::scenario_report failed = broken.run();
+   REQUIRE(3 == failed.failures.size());
+   REQUIRE_THAT(failed.failures[0].detail, Catch::Matchers::ContainsSubstring("unexpected error"));
+   REQUIRE_THAT(failed.failures[1].detail, Catch::Matchers::ContainsSubstring("parsed, expected an error"));
+   REQUIRE_THAT(failed.failures[2].detail, Catch::Matchers::ContainsSubstring("error does not contain 'Unrecognized'"));
+
+   std::istringstream bad("maybe | -b 4\n");
+   REQUIRE_THROWS_WITH(broken.load_table(bad), Catch::Matchers::ContainsSubstring("table:1: Unknown expectation 'maybe'"));
+}
+
+/************************************************************************/
+/*
+* \brief Driver function for Catch2 tests. Not clear to me how to use
+*        Catch::Session().run() with LONG command line arguments... 
+*        so quick hack using globals
+*
+*     @param[in] int argc: Integer variable storing number of command line arguments (including executable name)    
+*     @param[in] char **argv: Array of character pointers listing all the arguments    
+*     @return int: Success status
+* 
+*/
+int runCatchTests(int argc, char* const argv[])
+{
+   //std::cout << "-- BEGIN runCatchTests --" << std::endl;
+
+   // Owned, NULL terminated copy of the arguments in one allocation
+   cline_utils::ArgvBuilder arguments(argc, argv);
+   _G_argc = arguments.argc();
+   _G_argv = arguments.argv();
+
+   // Creat the command line parser
+   _G_cline = new cline_utils::CommandLineParser(_G_argc, _G_argv);
+
+   // Call potential tests
+   int result = Catch::Session().run();
+
+   // Clean up memory
+   delete _G_cline;
+
+   //std::cout << "-- END runCatchTests --" << std::endl;
+
+   // Return to main
+   return result;
+}
+
+/************************************************************************/
+/*
+* \brief Main function not built into Catch2...
+*
+*     @return int.
+* 
+*/
+int main(int argc, char* const argv[])
+{
+   return runCatchTests(argc, argv);
+}
\ No newline at end of file
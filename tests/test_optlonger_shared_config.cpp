@@ -0,0 +1,198 @@
+// -----------------------------------------------------------------------
+//
+//                        test_optlonger_shared_config.cpp V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#include <iostream>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define CATCH_CONFIG_RUNNER
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_session.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "cline_utils.h"
+
+// Cheesy global test variables to make things quicker.
+int _G_argc;
+char** _G_argv; //std::vector<std::string> Gargv;
+cline_utils::CommandLineParser *_G_cline;   
+
+/************************************************************************/
+/*
+* \brief Values published to a sealed memfd are read in place by a forked
+*        worker that never parses
+* 
+*/
+TEST_CASE("Shared Configuration","[MUSTPASS]")
+{
+   double parameter1D = std::nan("1"),
+          parameter2D = 3.14;
+
+   int helpFlag    = 0,
+       parameter3I = 100;
+
+   std::string parameter4S("");
+   cline_utils::range density, charge;
+
+   std::vector<cline_utils::option_longer> longer_options = 
+      {
+         {"help"     , no_argument      , NULL, 'h', optional_option, typeid(helpFlag).name()          , &helpFlag   , " Optional help option that must be h"},
+         {"longName1", required_argument, NULL, 'a', required_option, typeid(parameter1D).name()       , &parameter1D, " Required option with required double argument [physical units]"},
+         {"longName2", required_argument, NULL, 'b', required_option, typeid(parameter2D).name()       , &parameter2D, " Required option with required double argument []"},
+         {"longName3", required_argument, NULL, 'c', optional_option, typeid(parameter3I).name()       , &parameter3I, " Optional option with a required integer arugment if used"},
+         {"longName4", required_argument, NULL, 'd', required_option, typeid(parameter4S.data()).name(), &parameter4S, " Required option with required string argument"},
+         {"density"  , required_argument, NULL, 'n', required_option, typeid(cline_utils::range).name(), &density    , " Density scan [m^-3]"},
+         {"charge"   , required_argument, NULL, 'z', optional_option, typeid(cline_utils::range).name(), &charge     , " Charge states"},
+      };
+
+   _G_cline->add_options(longer_options);
+   _G_cline->parse_command_line();
+
+   int fd = _G_cline->publish_shared_config();
+   REQUIRE(0 <= fd);
+
+   // Sealed: no writes, no writable mappings
+   REQUIRE(-1 == write(fd, "x", 1));
+   REQUIRE(MAP_FAILED == mmap(NULL, 64, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+
+   pid_t child = fork();
+   REQUIRE(0 <= child);
+   if(0 == child)
+   {
+      // Worker: attach and check without touching the parser
+      int failures = 0;
+      try
+      {
+         cline_utils::shared_config_view config = cline_utils::shared_config_view::attach(fd);
+         failures += (7 != config.size());
+         failures += (4 != config.get<double>("longName2"));
+         failures += (5 != config.get<double>("longName1"));
+         failures += (3 != config.get<int>("longName3"));
+         failures += ("hello.txt" != config.get<std::string_view>("longName4"));
+         failures += (cline_utils::source_command_line != config.source(config.find("longName4")));
+         failures += (cline_utils::source_default != config.source(config.find("help")));
+         failures += (4 != config.get<cline_utils::range>("density").size());
+         failures += (1e18 != config.get<cline_utils::range>("density")[3]);
+         failures += (5.0 != config.get<cline_utils::range>("charge")[2]);
+         failures += (std::string::npos != config.find("missing"));
+         try { config.get<int>("longName4"); ++failures; } catch(const cline_utils::cline_exception &) {}
+      }
+      catch(...)
+      {
+         failures += 100;
+      }
+      _exit(failures);
+   }
+
+   int status = -1;
+   REQUIRE(child == waitpid(child, &status, 0));
+   REQUIRE(WIFEXITED(status));
+   REQUIRE(0 == WEXITSTATUS(status));
+
+   // A corrupt header is rejected by attach(); a corrupt slot or entry is
+   // rejected when find(), name() or get() reads it
+   struct stat info;
+   REQUIRE(0 == fstat(fd, &info));
+   std::vector<char> segment(info.st_size);
+   REQUIRE(ssize_t(segment.size()) == pread(fd, segment.data(), segment.size(), 0));
+   auto attach_corrupt = [&](const std::function<void(cline_utils::shared_config_header &, uint32_t *, cline_utils::shared_config_entry *)> &corrupt)
+      {
+         std::vector<char> copy = segment;
+         cline_utils::shared_config_header &h = *(cline_utils::shared_config_header *)copy.data();
+         corrupt(h, (uint32_t *)(copy.data() + h.slots_offset), (cline_utils::shared_config_entry *)(copy.data() + h.entries_offset));
+         int copy_fd = memfd_create("cline_corrupt", MFD_CLOEXEC);
+         REQUIRE(ssize_t(copy.size()) == write(copy_fd, copy.data(), copy.size()));
+         std::string error;
+         try
+         {
+            cline_utils::shared_config_view config = cline_utils::shared_config_view::attach(copy_fd);
+            for(size_t index = 0; index < config.size(); ++index)
+            {
+               config.find(config.name(index));
+            }
+            config.get<std::string_view>(size_t(4));
+         }
+         catch(const cline_utils::cline_exception &e)
+         {
+            error = e.what();
+         }
+         close(copy_fd);
+         return(error);
+      };
+   REQUIRE("" == attach_corrupt([](cline_utils::shared_config_header &, uint32_t *, cline_utils::shared_config_entry *) {}));
+   REQUIRE(std::string::npos != attach_corrupt([](cline_utils::shared_config_header &h, uint32_t *, cline_utils::shared_config_entry *)
+      { h.slot_count = 0; }).find("Invalid shared configuration hash slots"));
+   REQUIRE(std::string::npos != attach_corrupt([](cline_utils::shared_config_header &h, uint32_t *, cline_utils::shared_config_entry *)
+      { h.slot_count -= 1; }).find("Invalid shared configuration hash slots"));
+   REQUIRE(std::string::npos != attach_corrupt([](cline_utils::shared_config_header &h, uint32_t *slots, cline_utils::shared_config_entry *)
+      { std::fill(slots, slots + h.slot_count, h.option_count + 1); }).find("Invalid shared configuration hash slots"));
+   // Probing stops after slot_count slots even when none is empty
+   REQUIRE("" == attach_corrupt([](cline_utils::shared_config_header &h, uint32_t *slots, cline_utils::shared_config_entry *)
+      { std::fill(slots, slots + h.slot_count, 1); }));
+   REQUIRE(std::string::npos != attach_corrupt([](cline_utils::shared_config_header &h, uint32_t *, cline_utils::shared_config_entry *entries)
+      { entries[2].name_offset = h.total_size - 1; }).find("entry 2 out of bounds"));
+   REQUIRE(std::string::npos != attach_corrupt([](cline_utils::shared_config_header &, uint32_t *, cline_utils::shared_config_entry *entries)
+      { entries[4].value.text.length = UINT64_MAX; }).find("entry 4 out of bounds"));
+
+   // Anything else is rejected
+   int pipe_fds[2];
+   REQUIRE(0 == pipe(pipe_fds));
+   REQUIRE_THROWS_WITH(cline_utils::shared_config_view::attach(pipe_fds[0]), Catch::Matchers::ContainsSubstring("Not a shared configuration"));
+   close(pipe_fds[0]);
+   close(pipe_fds[1]);
+   close(fd);
+
+   _G_cline->delete_all_options();
+}
+
+/************************************************************************/
+/*
+* \brief Driver function for Catch2 tests. Not clear to me how to use
+*        Catch::Session().run() with LONG command line arguments... 
+*        so quick hack using globals
+*
+*     @param[in] int argc: Integer variable storing number of command line arguments (including executable name)    
+*     @param[in] char **argv: Array of character pointers listing all the arguments    
+*     @return int: Success status
+* 
+*/
+int runCatchTests(int argc, char* const argv[])
+{
+   //std::cout << "-- BEGIN runCatchTests --" << std::endl;
+
+   // Owned, NULL terminated copy of the arguments in one allocation
+   cline_utils::ArgvBuilder arguments(argc, argv);
+   _G_argc = arguments.argc();
+   _G_argv = arguments.argv();
+
+   // Creat the command line parser
+   _G_cline = new cline_utils::CommandLineParser(_G_argc, _G_argv);
+
+   // Call potential tests
+   int result = Catch::Session().run();
+
+   // Clean up memory
+   delete _G_cline;
+
+   //std::cout << "-- END runCatchTests --" << std::endl;
+
+   // Return to main
+   return result;
+}
+
+/************************************************************************/
+/*
+* \brief Main function not built into Catch2...
+*
+*     @return int.
+* 
+*/
+int main(int argc, char* const argv[])
+{
+   return runCatchTests(argc, argv);
+}
\ No newline at end of file
@@ -0,0 +1,139 @@
+// -----------------------------------------------------------------------
+//
+//                       test_optlonger_snapshot.cpp V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#include <iostream>
+
+#define CATCH_CONFIG_RUNNER
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_session.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "cline_utils.h"
+
+// Cheesy global test variables to make things quicker.
+int _G_argc;
+char** _G_argv; //std::vector<std::string> Gargv;
+cline_utils::CommandLineParser *_G_cline;   
+
+/************************************************************************/
+/*
+* \brief Round trip the parsed configuration through a binary snapshot.
+* 
+*/
+TEST_CASE("Snapshot Round Trip","[Snapshot]")
+{
+   double parameter1D = std::nan("1"),
+          parameter2D = 3.14;
+
+   int helpFlag    = 0,
+       parameter3I = 100;
+
+   std::string parameter4S("");
+
+   std::vector<cline_utils::option_longer> longer_options = 
+      {
+         {"help"     , no_argument      , NULL, 'h', optional_option, typeid(helpFlag).name()          , &helpFlag   , " Optional help option that must be h"},
+         {"longName1", required_argument, NULL, 'a', required_option, typeid(parameter1D).name()       , &parameter1D, " Required option with required double argument [physical units]"},
+         {"longName2", required_argument, NULL, 'b', required_option, typeid(parameter2D).name()       , &parameter2D, " Required option with required double argument []"},
+         {"longName3", required_argument, NULL, 'c', optional_option, typeid(parameter3I).name()       , &parameter3I, " Optional option with a required integer arugment if used"},
+         {"longName4", required_argument, NULL, 'd', required_option, typeid(parameter4S.data()).name(), &parameter4S, " Required option with required string argument"},
+      };
+
+   _G_cline->add_options(longer_options);
+   REQUIRE_NOTHROW(_G_cline->parse_command_line());
+
+   std::vector<char> record = _G_cline->serialize_snapshot();
+
+   // Clobber the bound variables, then restore them from the record
+   parameter1D = 0.0;
+   parameter2D = 0.0;
+   parameter3I = 0;
+   parameter4S = "clobbered";
+
+   REQUIRE_NOTHROW(_G_cline->load_snapshot(record));
+   REQUIRE(5.0 == parameter1D);
+   REQUIRE(4.0 == parameter2D);
+   REQUIRE(3 == parameter3I);
+   REQUIRE("hello.txt" == parameter4S);
+   REQUIRE(cline_utils::source_command_line == _G_cline->get_option_source('a'));
+   REQUIRE(cline_utils::source_default == _G_cline->get_option_source('h'));
+
+   // A record that fails part way leaves every variable as it was
+   {
+      std::vector<cline_utils::option_longer> renamed = longer_options;
+      renamed.back().name = "otherName4";
+      cline_utils::ArgvBuilder arguments{"snapshot"};
+      cline_utils::CommandLineParser other(arguments.argc(), arguments.argv());
+      other.add_options(renamed);
+      parameter1D = 0.0;
+      parameter3I = 0;
+      REQUIRE_THROWS_WITH(other.load_snapshot(record), Catch::Matchers::ContainsSubstring("Record does not match configured option: longName4"));
+      REQUIRE(0.0 == parameter1D);
+      REQUIRE(0 == parameter3I);
+      REQUIRE("hello.txt" == parameter4S);
+      REQUIRE(cline_utils::source_default == other.get_option_source('a'));
+      REQUIRE_NOTHROW(_G_cline->load_snapshot(record));
+   }
+
+   // Any corruption must be detected by the checksum
+   record[record.size() / 2] ^= 0x5A;
+   REQUIRE_THROWS_WITH(_G_cline->load_snapshot(record), Catch::Matchers::ContainsSubstring("Checksum mismatch"));
+
+   // Truncated records must never be read past their end
+   record.resize(12);
+   REQUIRE_THROWS(_G_cline->load_snapshot(record));
+
+   _G_cline->delete_all_options();
+}
+
+/************************************************************************/
+/*
+* \brief Driver function for Catch2 tests. Not clear to me how to use
+*        Catch::Session().run() with LONG command line arguments... 
+*        so quick hack using globals
+*
+*     @param[in] int argc: Integer variable storing number of command line arguments (including executable name)    
+*     @param[in] char **argv: Array of character pointers listing all the arguments    
+*     @return int: Success status
+* 
+*/
+int runCatchTests(int argc, char* const argv[])
+{
+   //std::cout << "-- BEGIN runCatchTests --" << std::endl;
+
+   // Owned, NULL terminated copy of the arguments in one allocation
+   cline_utils::ArgvBuilder arguments(argc, argv);
+   _G_argc = arguments.argc();
+   _G_argv = arguments.argv();
+
+   // Creat the command line parser
+   _G_cline = new cline_utils::CommandLineParser(_G_argc, _G_argv);
+
+   // Call potential tests
+   int result = Catch::Session().run();
+
+   // Clean up memory
+   delete _G_cline;
+
+   //std::cout << "-- END runCatchTests --" << std::endl;
+
+   // Return to main
+   return result;
+}
+
+/************************************************************************/
+/*
+* \brief Main function not built into Catch2...
+*
+*     @return int.
+* 
+*/
+int main(int argc, char* const argv[])
+{
+   return runCatchTests(argc, argv);
+}
\ No newline at end of file
@@ -0,0 +1,221 @@
+// -----------------------------------------------------------------------
+//
+//                        test_optlonger_stream.cpp V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <unistd.h>
+
+#define CATCH_CONFIG_RUNNER
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_session.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "cline_utils.h"
+
+// Cheesy global test variables to make things quicker.
+int _G_argc;
+char** _G_argv; //std::vector<std::string> Gargv;
+cline_utils::CommandLineParser *_G_cline;   
+
+/************************************************************************/
+/*
+* \brief Options and positionals arrive in command line order, converted, and
+*        the bound variables are left alone
+* 
+*/
+TEST_CASE("Streaming Parse","[MUSTPASS]")
+{
+   double parameter1D = std::nan("1"),
+          parameter2D = 3.14;
+
+   int helpFlag    = 0,
+       parameter3I = 100,
+       verboseFlag = 0;
+
+   std::string parameter4S("");
+
+   std::vector<cline_utils::option_longer> longer_options = 
+      {
+         {"help"     , no_argument      , NULL, 'h', optional_option, typeid(helpFlag).name()          , &helpFlag   , " Optional help option that must be h"},
+         {"longName1", required_argument, NULL, 'a', required_option, typeid(parameter1D).name()       , &parameter1D, " Required option with required double argument [physical units]"},
+         {"longName2", required_argument, NULL, 'b', required_option, typeid(parameter2D).name()       , &parameter2D, " Required option with required double argument []"},
+         {"longName3", required_argument, NULL, 'c', optional_option, typeid(parameter3I).name()       , &parameter3I, " Optional option with a required integer arugment if used"},
+         {"longName4", required_argument, NULL, 'd', required_option, typeid(parameter4S.data()).name(), &parameter4S, " Required option with required string argument"},
+         {"verbose"  , no_argument      , NULL, 'v', optional_option, typeid(verboseFlag).name()       , &verboseFlag, " Verbose output"},
+      };
+
+   _G_cline->add_options(longer_options);
+   _G_cline->set_positional_arity(1);
+
+   std::vector<std::string> seen;
+   uint64_t events = _G_cline->stream_command_line([&seen](const cline_utils::parse_event &event)
+      {
+         if(cline_utils::parse_event::event_positional == event.kind)
+         {
+            seen.push_back("pos:" + std::string(event.text));
+         }
+         else if('b' == event.val || 'a' == event.val)
+         {
+            seen.push_back(std::string(event.name) + "=" + std::to_string(event.get<double>()));
+         }
+         else if('c' == event.val || 'v' == event.val)
+         {
+            seen.push_back(std::string(event.name) + "=" + std::to_string(event.get<int>()));
+         }
+         else
+         {
+            seen.push_back(std::string(event.name) + "=" + event.get<std::string>());
+         }
+         return(true);
+      });
+
+   std::vector<std::string> expected = {"longName2=4.000000", "longName1=5.000000", "verbose=1", "longName4=hello.txt",
+                                        "pos:a.h5", "longName3=7", "pos:-b.h5"};
+   REQUIRE(expected.size() == events);
+   REQUIRE(expected == seen);
+
+   // Nothing was written to the bound variables
+   REQUIRE(3.14 == parameter2D);
+   REQUIRE(100 == parameter3I);
+   REQUIRE(0 == verboseFlag);
+
+   // Stop early
+   size_t calls = 0;
+   _G_cline->stream_command_line([&calls](const cline_utils::parse_event &) { return(++calls < 2); });
+   REQUIRE(2 == calls);
+
+   _G_cline->delete_all_options();
+}
+
+/************************************************************************/
+/*
+* \brief Response files are tokenized as they are read, nested ones included
+* 
+*/
+TEST_CASE("Streaming Response Files","[MUSTPASS]")
+{
+   int verboseFlag = 0,
+       parameter3I = 100;
+
+   std::vector<cline_utils::option_longer> longer_options = 
+      {
+         {"verbose"  , no_argument      , NULL, 'v', optional_option, typeid(verboseFlag).name(), &verboseFlag, " Verbose output"},
+         {"longName3", required_argument, NULL, 'c', optional_option, typeid(parameter3I).name(), &parameter3I, " Optional option with a required integer arugment if used"},
+      };
+
+   char directory[] = "/tmp/cline_stream_XXXXXX";
+   REQUIRE(NULL != mkdtemp(directory));
+   std::string outer = std::string(directory) + "/outer.rsp";
+   std::string inner = std::string(directory) + "/inner.rsp";
+   {
+      std::ofstream out(inner);
+      for(int i = 0; i < 10000; ++i)
+      {
+         out << "file_" << i << ".h5\n";
+      }
+   }
+   {
+      std::ofstream out(outer);
+      out << "-c 12 \"name with spaces.h5\"\n@" << inner << "\n  -v";
+   }
+
+   std::string at_outer = "@" + outer;
+   const char *arguments[] = {"ingest", at_outer.c_str(), "last.h5", NULL};
+   cline_utils::CommandLineParser cline(3, (char **)arguments, longer_options);
+   cline.set_positional_arity(0);
+
+   std::vector<std::string> firsts;
+   uint64_t positionals = 0, options = 0;
+   cline.stream_command_line([&](const cline_utils::parse_event &event)
+      {
+         if(cline_utils::parse_event::event_option == event.kind)
+         {
+            ++options;
+            if('c' == event.val) REQUIRE(12 == event.get<int>());
+         }
+         else if(positionals++ < 2)
+         {
+            firsts.push_back(std::string(event.text));
+         }
+         return(true);
+      });
+
+   REQUIRE(2 == options);
+   REQUIRE(10002 == positionals);
+   REQUIRE("name with spaces.h5" == firsts[0]);
+   REQUIRE("file_0.h5" == firsts[1]);
+
+   const char *missing[] = {"ingest", "@/nonexistent/cline.rsp", NULL};
+   cline_utils::CommandLineParser broken(2, (char **)missing, longer_options);
+   REQUIRE_THROWS_WITH(broken.stream_command_line([](const cline_utils::parse_event &) { return(true); }),
+                       Catch::Matchers::ContainsSubstring("Unable to open response file"));
+
+   // After "--" an @name is delivered as it is, not read
+   const char *literal[] = {"ingest", "--", "@/nonexistent/cline.rsp", NULL};
+   cline_utils::CommandLineParser after_dashes(3, (char **)literal, longer_options);
+   after_dashes.set_positional_arity(0);
+   std::vector<std::string> delivered;
+   after_dashes.stream_command_line([&](const cline_utils::parse_event &event)
+      {
+         delivered.push_back(std::string(event.text));
+         return(true);
+      });
+   REQUIRE(1 == delivered.size());
+   REQUIRE("@/nonexistent/cline.rsp" == delivered[0]);
+
+   unlink(inner.c_str());
+   unlink(outer.c_str());
+   rmdir(directory);
+}
+
+/************************************************************************/
+/*
+* \brief Driver function for Catch2 tests. Not clear to me how to use
+*        Catch::Session().run() with LONG command line arguments... 
+*        so quick hack using globals
+*
+*     @param[in] int argc: Integer variable storing number of command line arguments (including executable name)    
+*     @param[in] char **argv: Array of character pointers listing all the arguments    
+*     @return int: Success status
+* 
+*/
+int runCatchTests(int argc, char* const argv[])
+{
+   //std::cout << "-- BEGIN runCatchTests --" << std::endl;
+
+   // Owned, NULL terminated copy of the arguments in one allocation
+   cline_utils::ArgvBuilder arguments(argc, argv);
+   _G_argc = arguments.argc();
+   _G_argv = arguments.argv();
+
+   // Creat the command line parser
+   _G_cline = new cline_utils::CommandLineParser(_G_argc, _G_argv);
+
+   // Call potential tests
+   int result = Catch::Session().run();
+
+   // Clean up memory
+   delete _G_cline;
+
+   //std::cout << "-- END runCatchTests --" << std::endl;
+
+   // Return to main
+   return result;
+}
+
+/************************************************************************/
+/*
+* \brief Main function not built into Catch2...
+*
+*     @return int.
+* 
+*/
+int main(int argc, char* const argv[])
+{
+   return runCatchTests(argc, argv);
+}
\ No newline at end of file
@@ -0,0 +1,138 @@
+// -----------------------------------------------------------------------
+//
+//                      test_optlonger_summary.cpp V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#include <iostream>
+
+#define CATCH_CONFIG_RUNNER
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_session.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "cline_utils.h"
+
+// Cheesy global test variables to make things quicker.
+int _G_argc;
+char** _G_argv; //std::vector<std::string> Gargv;
+cline_utils::CommandLineParser *_G_cline;   
+
+/************************************************************************/
+/*
+* \brief JSON and CSV summaries of the resolved options
+* 
+*/
+TEST_CASE("Machine Readable Summary","[MUSTPASS]")
+{
+   double parameter1D = std::nan("1"),
+          parameter2D = 0.1;
+
+   int verboseFlag = 0,
+       parameter3I = 100;
+
+   std::string parameter4S("");
+   uint64_t samples = 18446744073709551615ull;
+   bool dry_run = false;
+   std::chrono::milliseconds timeout(250);
+
+   std::vector<cline_utils::option_longer> longer_options = 
+      {
+         {"verbose"  , no_argument      , NULL, 'v', optional_option, typeid(verboseFlag).name()       , &verboseFlag, " Verbose output"},
+         {"longName1", required_argument, NULL, 'a', required_option, typeid(parameter1D).name()       , &parameter1D, " Required option with required double argument [physical units]"},
+         {"longName2", required_argument, NULL, 'b', optional_option, typeid(parameter2D).name()       , &parameter2D, " Scale, as a \"fraction\", of the input"},
+         {"longName3", required_argument, NULL, 'c', optional_option, typeid(parameter3I).name()       , &parameter3I, " Optional option with a required integer arugment if used"},
+         {"longName4", required_argument, NULL, 'd', required_option, typeid(parameter4S.data()).name(), &parameter4S, " Required option with required string argument"},
+         cline_utils::make_option("samples", 's', samples, " Number of samples"),
+         cline_utils::make_option("dry-run", 1000, dry_run, " Do nothing"),
+         cline_utils::make_option("timeout", 't', timeout, " Give up after"),
+      };
+
+   _G_cline->add_options(longer_options);
+   _G_cline->parse_command_line();
+   REQUIRE(1.0 / 3.0 == parameter1D);
+
+   std::string json = _G_cline->format_input_summary(cline_utils::summary_json);
+   REQUIRE(0 == json.find("{\"options\":[{\"name\":\"verbose\",\"char\":\"v\",\"type\":\"int\",\"required\":false,\"argument\":false,"
+                          "\"source\":\"default\",\"value\":0,\"description\":\"Verbose output\"},"));
+   // Shortest text that reads back to the same double
+   REQUIRE(std::string::npos != json.find("\"source\":\"command_line\",\"value\":0.3333333333333333,"));
+   REQUIRE(std::string::npos != json.find("\"value\":0.1,\"description\":\"Scale, as a \\\"fraction\\\", of the input\"}"));
+   REQUIRE(std::string::npos != json.find("\"value\":\"hello, world.txt\""));
+   REQUIRE(std::string::npos != json.find("\"value\":18446744073709551615,"));
+   REQUIRE(std::string::npos != json.find("{\"name\":\"dry-run\",\"char\":null,\"type\":\"bool\",\"required\":false,\"argument\":false,\"source\":\"default\",\"value\":false,"));
+   REQUIRE(std::string::npos != json.find("\"type\":\"duration\",\"required\":false,\"argument\":true,\"source\":\"default\",\"value\":\"250ms\","));
+   REQUIRE(std::string::npos != json.find("],\"positional\":[]}\n"));
+
+   std::string csv = _G_cline->format_input_summary(cline_utils::summary_csv);
+   REQUIRE(0 == csv.find("name,char,type,required,argument,source,value,description\r\n"
+                         "verbose,v,int,false,false,default,0,Verbose output\r\n"
+                         "longName1,a,double,true,true,command_line,0.3333333333333333,Required option with required double argument [physical units]\r\n"
+                         "longName2,b,double,false,true,default,0.1,\"Scale, as a \"\"fraction\"\", of the input\"\r\n"));
+   REQUIRE(std::string::npos != csv.find("longName4,d,string,true,true,command_line,\"hello, world.txt\",Required"));
+
+   // NaN is not JSON, CSV keeps the text
+   parameter2D = std::nan("1");
+   REQUIRE(std::string::npos != _G_cline->format_input_summary(cline_utils::summary_json).find("\"value\":null,\"description\":\"Scale"));
+   REQUIRE(std::string::npos != _G_cline->format_input_summary(cline_utils::summary_csv).find("default,nan,"));
+
+   // One write through a pipe delivers the whole document
+   int fds[2];
+   REQUIRE(0 == pipe(fds));
+   _G_cline->write_input_summary(cline_utils::summary_csv, fds[1]);
+   close(fds[1]);
+   std::string piped;
+   char buffer[4096];
+   for(ssize_t n; 0 < (n = read(fds[0], buffer, sizeof(buffer)));) piped.append(buffer, n);
+   close(fds[0]);
+   REQUIRE(_G_cline->format_input_summary(cline_utils::summary_csv) == piped);
+}
+
+/************************************************************************/
+/*
+* \brief Driver function for Catch2 tests. Not clear to me how to use
+*        Catch::Session().run() with LONG command line arguments... 
+*        so quick hack using globals
+*
+*     @param[in] int argc: Integer variable storing number of command line arguments (including executable name)    
+*     @param[in] char **argv: Array of character pointers listing all the arguments    
+*     @return int: Success status
+* 
+*/
+int runCatchTests(int argc, char* const argv[])
+{
+   //std::cout << "-- BEGIN runCatchTests --" << std::endl;
+
+   // Owned, NULL terminated copy of the arguments in one allocation
+   cline_utils::ArgvBuilder arguments(argc, argv);
+   _G_argc = arguments.argc();
+   _G_argv = arguments.argv();
+
+   // Creat the command line parser
+   _G_cline = new cline_utils::CommandLineParser(_G_argc, _G_argv);
+
+   // Call potential tests
+   int result = Catch::Session().run();
+
+   // Clean up memory
+   delete _G_cline;
+
+   //std::cout << "-- END runCatchTests --" << std::endl;
+
+   // Return to main
+   return result;
+}
+
+/************************************************************************/
+/*
+* \brief Main function not built into Catch2...
+*
+*     @return int.
+* 
+*/
+int main(int argc, char* const argv[])
+{
+   return runCatchTests(argc, argv);
+}
\ No newline at end of file
@@ -0,0 +1,145 @@
+// -----------------------------------------------------------------------
+//
+//                        test_optlonger_sweep.cpp V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#include <iostream>
+
+#define CATCH_CONFIG_RUNNER
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_session.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "cline_utils.h"
+
+// Cheesy global test variables to make things quicker.
+int _G_argc;
+char** _G_argv; //std::vector<std::string> Gargv;
+cline_utils::CommandLineParser *_G_cline;   
+
+/************************************************************************/
+/*
+* \brief Sharded Cartesian product of range options
+* 
+*/
+TEST_CASE("Sharded Sweep","[Sweep]")
+{
+   cline_utils::range density, angle, charge;
+   cline_utils::shard_spec shard;
+
+   int helpFlag = 0;
+
+   std::vector<cline_utils::option_longer> longer_options = 
+      {
+         {"help"   , no_argument      , NULL, 'h', optional_option, typeid(helpFlag).name()          , &helpFlag, " Optional help option that must be h"},
+         {"density", required_argument, NULL, 'n', required_option, typeid(cline_utils::range).name(), &density , " Density scan [m^-3]"},
+         {"angle"  , required_argument, NULL, 'a', required_option, typeid(cline_utils::range).name(), &angle   , " Angle scan [degrees]"},
+         {"charge" , required_argument, NULL, 'z', optional_option, typeid(cline_utils::range).name(), &charge  , " Charge states"},
+      };
+
+   _G_cline->add_options(longer_options);
+   _G_cline->add_shard_option(shard);
+   REQUIRE_NOTHROW(_G_cline->parse_command_line());
+
+   REQUIRE(1 == shard.index);
+   REQUIRE(3 == shard.count);
+   REQUIRE(24 == _G_cline->sweep_size());
+
+   // Every configuration is visited exactly once across all shards, in order
+   std::vector<int> visits(24, 0);
+   for(uint64_t worker = 0; worker < 3; ++worker)
+   {
+      shard.index = worker;
+      _G_cline->begin_sweep();
+      REQUIRE(8 == _G_cline->get_shard_end() - _G_cline->get_shard_begin());
+
+      while(_G_cline->next_sweep_point())
+      {
+         uint64_t k = _G_cline->get_sweep_index();
+         ++visits[k];
+         REQUIRE(density.current() == density[k / 6]);
+         REQUIRE(angle.current() == angle[(k / 2) % 3]);
+         REQUIRE(charge.current() == charge[k % 2]);
+      }
+   }
+   REQUIRE(std::count(visits.begin(), visits.end(), 1) == 24);
+
+   // 10^9 configurations over 1000 workers: only the last shard is decoded
+   density = cline_utils::range::parse("0:999:lin:1000");
+   angle = cline_utils::range::parse("0:999:lin:1000");
+   charge = cline_utils::range::parse("0:999:lin:1000");
+   shard = cline_utils::shard_spec::parse("999/1000");
+   _G_cline->begin_sweep();
+   REQUIRE(1000000000 == _G_cline->sweep_size());
+   REQUIRE(999000000 == _G_cline->get_shard_begin());
+   REQUIRE(1000000000 == _G_cline->get_shard_end());
+   REQUIRE(_G_cline->next_sweep_point());
+   REQUIRE(999.0 == density.current());
+   REQUIRE(0.0 == angle.current());
+   REQUIRE(0.0 == charge.current());
+
+   // Uneven split: shard sizes differ by at most one
+   charge = cline_utils::range::parse("1,2,3,4,5,6,7");
+   density = cline_utils::range();
+   angle = cline_utils::range();
+   shard = cline_utils::shard_spec::parse("2/3");
+   _G_cline->begin_sweep();
+   REQUIRE(5 == _G_cline->get_shard_begin());
+   REQUIRE(7 == _G_cline->get_shard_end());
+
+   REQUIRE_THROWS(cline_utils::shard_spec::parse("3/3"));
+   REQUIRE_THROWS(cline_utils::shard_spec::parse("1/0"));
+   REQUIRE_THROWS(cline_utils::shard_spec::parse("-1/2"));
+
+   _G_cline->delete_all_options();
+}
+
+/************************************************************************/
+/*
+* \brief Driver function for Catch2 tests. Not clear to me how to use
+*        Catch::Session().run() with LONG command line arguments... 
+*        so quick hack using globals
+*
+*     @param[in] int argc: Integer variable storing number of command line arguments (including executable name)    
+*     @param[in] char **argv: Array of character pointers listing all the arguments    
+*     @return int: Success status
+* 
+*/
+int runCatchTests(int argc, char* const argv[])
+{
+   //std::cout << "-- BEGIN runCatchTests --" << std::endl;
+
+   // Owned, NULL terminated copy of the arguments in one allocation
+   cline_utils::ArgvBuilder arguments(argc, argv);
+   _G_argc = arguments.argc();
+   _G_argv = arguments.argv();
+
+   // Creat the command line parser
+   _G_cline = new cline_utils::CommandLineParser(_G_argc, _G_argv);
+
+   // Call potential tests
+   int result = Catch::Session().run();
+
+   // Clean up memory
+   delete _G_cline;
+
+   //std::cout << "-- END runCatchTests --" << std::endl;
+
+   // Return to main
+   return result;
+}
+
+/************************************************************************/
+/*
+* \brief Main function not built into Catch2...
+*
+*     @return int.
+* 
+*/
+int main(int argc, char* const argv[])
+{
+   return runCatchTests(argc, argv);
+}
\ No newline at end of file
@@ -0,0 +1,314 @@
+// -----------------------------------------------------------------------
+//
+//                        test_optlonger_types.cpp  V 0.01
+//
+//                        (c) Brian Lynch February, 2015
+//
+// -----------------------------------------------------------------------
+
+#include <iostream>
+
+#define CATCH_CONFIG_RUNNER
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_session.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "cline_utils.h"
+
+// Cheesy global test variables to make things quicker.
+int _G_argc;
+char** _G_argv; //std::vector<std::string> Gargv;
+cline_utils::CommandLineParser *_G_cline;   
+
+enum class precision_mode : uint8_t
+{
+   fast  = 1,
+   exact = 7
+};
+
+static const cline_utils::enum_table precision_modes =
+   cline_utils::enum_table::of<precision_mode>({{"fast", precision_mode::fast}, {"exact", precision_mode::exact}});
+
+/************************************************************************/
+/*
+* \brief 64 bit integers, bool, enumerations and durations bound through
+*        make_option() convert exactly and show up in snapshots
+* 
+*/
+TEST_CASE("Numeric Type Coverage","[MUSTPASS]")
+{
+   double parameter1D = std::nan("1"),
+          parameter2D = 3.14;
+
+   std::string parameter4S("");
+
+   int64_t samples = 0;
+   uint64_t offset = 0;
+   float scale = 1.0f;
+   bool verbose = false;
+   precision_mode mode = precision_mode::fast;
+   std::chrono::milliseconds timeout(250);
+
+   typedef cline_utils::option_constraint oc;
+
+   std::vector<cline_utils::option_longer> longer_options = 
+      {
+         {"longName1", required_argument, NULL, 'a', required_option, typeid(parameter1D).name()       , &parameter1D, " Required option with required double argument [physical units]"},
+         {"longName2", required_argument, NULL, 'b', required_option, typeid(parameter2D).name()       , &parameter2D, " Required option with required double argument []"},
+         {"longName4", required_argument, NULL, 'd', required_option, typeid(parameter4S.data()).name(), &parameter4S, " Required option with required string argument"},
+         cline_utils::make_option("samples", 's', samples, " Number of samples", optional_option, {oc::positive()}),
+         cline_utils::make_option("offset" , 'o', offset , " Byte offset"),
+         cline_utils::make_option("scale"  , 'x', scale  , " Scale factor"),
+         cline_utils::make_option("verbose", 'v', verbose, " Verbose output"),
+         cline_utils::make_option("mode"   , 'm', mode   , precision_modes, " Precision mode"),
+         cline_utils::make_option("timeout", 't', timeout, " Time limit"),
+      };
+
+   _G_cline->add_options(longer_options);
+   _G_cline->parse_command_line();
+
+   REQUIRE(5000000000 == samples);
+   REQUIRE(UINT64_MAX == offset);
+   REQUIRE(2.5f == scale);
+   REQUIRE(true == verbose);
+   REQUIRE(precision_mode::exact == mode);
+   REQUIRE(1500 == timeout.count());
+
+   // The values round trip through the binary snapshot
+   std::vector<char> record = _G_cline->serialize_snapshot();
+   samples = 1;
+   offset = 2;
+   verbose = false;
+   mode = precision_mode::fast;
+   timeout = std::chrono::milliseconds(3);
+   _G_cline->load_snapshot(record);
+   REQUIRE(5000000000 == samples);
+   REQUIRE(UINT64_MAX == offset);
+   REQUIRE(true == verbose);
+   REQUIRE(precision_mode::exact == mode);
+   REQUIRE(1500 == timeout.count());
+
+   // ... and the published snapshot, by value
+   _G_cline->publish_snapshot();
+   cline_utils::snapshot_reader reader = _G_cline->register_snapshot_reader();
+   {
+      auto snapshot = reader.read();
+      REQUIRE(5000000000 == snapshot->get<int64_t>("samples"));
+      REQUIRE(UINT64_MAX == snapshot->get<size_t>("offset"));
+      REQUIRE(true == snapshot->get<bool>("verbose"));
+      REQUIRE(precision_mode::exact == snapshot->get<precision_mode>("mode"));
+      REQUIRE(std::chrono::milliseconds(1500) == snapshot->get<std::chrono::milliseconds>("timeout"));
+      REQUIRE_THROWS(snapshot->get<std::chrono::seconds>("timeout"));
+      REQUIRE_THROWS(snapshot->get<uint64_t>("samples"));
+   }
+
+   _G_cline->delete_all_options();
+}
+
+/************************************************************************/
+/*
+* \brief Values that do not fit the option type are errors, not wrapped
+* 
+*/
+TEST_CASE("Overflow Safe Conversion","[MUSTPASS]")
+{
+   int count = 0;
+   int64_t samples = 0;
+   uint64_t offset = 0;
+   float scale = 1.0f;
+   double weight = 0.0;
+   bool verbose = false;
+   precision_mode mode = precision_mode::fast;
+   std::chrono::seconds timeout(1);
+
+   std::vector<cline_utils::option_longer> longer_options = 
+      {
+         {"count" , required_argument, NULL, 'c', optional_option, typeid(count).name() , &count , " Count"},
+         {"weight", required_argument, NULL, 'w', optional_option, typeid(weight).name(), &weight, " Weight"},
+         cline_utils::make_option("samples", 's', samples, " Number of samples"),
+         cline_utils::make_option("offset" , 'o', offset , " Byte offset"),
+         cline_utils::make_option("scale"  , 'x', scale  , " Scale factor"),
+         cline_utils::make_option("verbose", 'v', verbose, " Verbose output"),
+         cline_utils::make_option("mode"   , 'm', mode   , precision_modes, " Precision mode"),
+         cline_utils::make_option("timeout", 't', timeout, " Time limit"),
+      };
+
+   auto parse = [&](const char *argument)
+      {
+         const char *arguments[] = {"types", argument, NULL};
+         cline_utils::CommandLineParser cline(2, (char **)arguments, longer_options);
+         cline.parse_command_line();
+      };
+
+   REQUIRE_THROWS_WITH(parse("--count=99999999999"), Catch::Matchers::ContainsSubstring("Invalid value for --count (-c): '99999999999' out of range"));
+   REQUIRE_THROWS_WITH(parse("--samples=9223372036854775808"), Catch::Matchers::ContainsSubstring("out of range"));
+   REQUIRE_THROWS_WITH(parse("--offset=-1"), Catch::Matchers::ContainsSubstring("not an integer"));
+   REQUIRE_THROWS_WITH(parse("--offset=18446744073709551616"), Catch::Matchers::ContainsSubstring("out of range"));
+   REQUIRE_THROWS_WITH(parse("--samples=12abc"), Catch::Matchers::ContainsSubstring("not an integer"));
+   REQUIRE_THROWS_WITH(parse("--scale=1e39"), Catch::Matchers::ContainsSubstring("out of range of float"));
+   REQUIRE_THROWS_WITH(parse("--scale=1.5xyz"), Catch::Matchers::ContainsSubstring("Invalid value for --scale (-x): '1.5xyz' not a number"));
+   REQUIRE_THROWS_WITH(parse("--scale=abc"), Catch::Matchers::ContainsSubstring("not a number"));
+   REQUIRE_THROWS_WITH(parse("--weight=1e309"), Catch::Matchers::ContainsSubstring("out of range of double"));
+   REQUIRE_THROWS_WITH(parse("--mode=slow"), Catch::Matchers::ContainsSubstring("not one of: fast exact"));
+   REQUIRE_THROWS_WITH(parse("--timeout=1500ms"), Catch::Matchers::ContainsSubstring("not a whole number"));
+   REQUIRE_THROWS_WITH(parse("--timeout=3fortnights"), Catch::Matchers::ContainsSubstring("unknown duration unit"));
+   REQUIRE_THROWS_WITH(parse("--timeout=9223372036854775807min"), Catch::Matchers::ContainsSubstring("out of range"));
+
+   // The extremes themselves are fine
+   REQUIRE_NOTHROW(parse("--samples=-9223372036854775808"));
+   REQUIRE(INT64_MIN == samples);
+   REQUIRE_NOTHROW(parse("--count=-2147483648"));
+   REQUIRE(INT_MIN == count);
+   REQUIRE_NOTHROW(parse("--offset=0xFFFFFFFFFFFFFFFF"));
+   REQUIRE(UINT64_MAX == offset);
+   REQUIRE_NOTHROW(parse("--timeout=2h"));
+   REQUIRE(7200 == timeout.count());
+   REQUIRE_NOTHROW(parse("-v"));
+   REQUIRE(true == verbose);
+
+   REQUIRE_NOTHROW(parse("--scale=2.5"));
+   REQUIRE(2.5f == scale);
+
+   // Historical markers for text that is not a number at all, and trailing
+   // text ignored, for double and int only
+   REQUIRE_NOTHROW(parse("--count=abc"));
+   REQUIRE(INT_MIN == count);
+   REQUIRE_NOTHROW(parse("--weight=1.5xyz"));
+   REQUIRE(1.5 == weight);
+}
+
+/************************************************************************/
+/*
+* \brief Streaming parse and shared configuration carry the new types
+* 
+*/
+TEST_CASE("Typed Events And Shared Values","[MUSTPASS]")
+{
+   uint64_t offset = 0;
+   bool verbose = false;
+   precision_mode mode = precision_mode::fast;
+   std::chrono::microseconds timeout(5);
+   typedef std::chrono::duration<int64_t, std::pico> picoseconds;
+   typedef std::chrono::duration<int64_t, std::femto> femtoseconds;
+   picoseconds jitter(7);
+
+   std::vector<cline_utils::option_longer> longer_options = 
+      {
+         cline_utils::make_option("offset" , 'o', offset , " Byte offset"),
+         cline_utils::make_option("verbose", 'v', verbose, " Verbose output"),
+         cline_utils::make_option("mode"   , 'm', mode   , precision_modes, " Precision mode"),
+         cline_utils::make_option("timeout", 't', timeout, " Time limit"),
+         cline_utils::make_option("jitter" , 'j', jitter , " Clock jitter"),
+      };
+
+   const char *arguments[] = {"types", "-v", "--offset=42", "--mode", "exact", "--timeout=2ms", "--jitter=3ns", NULL};
+   cline_utils::CommandLineParser cline(7, (char **)arguments, longer_options);
+
+   uint64_t events = cline.stream_command_line([&](const cline_utils::parse_event &event)
+      {
+         if('o' == event.val) REQUIRE(42 == event.get<uint64_t>());
+         if('v' == event.val) REQUIRE(true == event.get<bool>());
+         if('m' == event.val) REQUIRE(precision_mode::exact == event.get<precision_mode>());
+         if('t' == event.val) REQUIRE(2000 == event.get<std::chrono::microseconds>().count());
+         return(true);
+      });
+   REQUIRE(5 == events);
+
+   cline.parse_command_line();
+   int fd = cline.publish_shared_config();
+   REQUIRE(0 <= fd);
+   {
+      cline_utils::shared_config_view config = cline_utils::shared_config_view::attach(fd);
+      REQUIRE(42 == config.get<uint64_t>("offset"));
+      REQUIRE(true == config.get<bool>("verbose"));
+      REQUIRE(precision_mode::exact == config.get<precision_mode>("mode"));
+      REQUIRE(2000 == config.get<std::chrono::microseconds>("timeout").count());
+      // The period of sub-nanosecond units does not fit 32 bits
+      REQUIRE(3000 == config.get<picoseconds>("jitter").count());
+      REQUIRE_THROWS(config.get<femtoseconds>("jitter"));
+      REQUIRE_THROWS(config.get<double>("offset"));
+      REQUIRE_THROWS(config.get<std::chrono::milliseconds>("timeout"));
+   }
+   close(fd);
+}
+
+/************************************************************************/
+/*
+* \brief An enum_table built inside the make_option() call is copied, so it
+*        is still there when the defaults are captured and values printed
+* 
+*/
+TEST_CASE("Inline Enum Table","[MUSTPASS]")
+{
+   precision_mode mode = precision_mode::fast;
+   precision_mode fallback = precision_mode::exact;
+
+   std::vector<cline_utils::option_longer> longer_options = 
+      {
+         cline_utils::make_option("mode", 'm', mode, cline_utils::enum_table::of<precision_mode>({{"fast", precision_mode::fast}, {"exact", precision_mode::exact}}),
+                                  " Precision mode"),
+      };
+
+   cline_utils::ArgvBuilder arguments{"types", "--mode", "exact"};
+   cline_utils::CommandLineParser cline(arguments.argc(), arguments.argv());
+   cline.add_options(longer_options);
+   longer_options.clear();
+   cline.add_option(cline_utils::make_option("fallback", 'f', fallback, cline_utils::enum_table::of<precision_mode>({{"fast", precision_mode::fast}, {"exact", precision_mode::exact}}),
+                                             " Fallback mode"));
+   cline.parse_command_line();
+
+   REQUIRE(precision_mode::exact == mode);
+   REQUIRE(precision_mode::exact == fallback);
+   REQUIRE(std::string::npos != cline.format_input_summary(cline_utils::summary_csv).find(",exact,"));
+   REQUIRE("fallback = exact\nmode = exact\n" == cline.format_options(""));
+   REQUIRE(2 == cline.reset_options(""));
+   REQUIRE(precision_mode::fast == mode);
+   REQUIRE(precision_mode::exact == fallback);
+}
+
+/************************************************************************/
+/*
+* \brief Driver function for Catch2 tests. Not clear to me how to use
+*        Catch::Session().run() with LONG command line arguments... 
+*        so quick hack using globals
+*
+*     @param[in] int argc: Integer variable storing number of command line arguments (including executable name)    
+*     @param[in] char **argv: Array of character pointers listing all the arguments    
+*     @return int: Success status
+* 
+*/
+int runCatchTests(int argc, char* const argv[])
+{
+   //std::cout << "-- BEGIN runCatchTests --" << std::endl;
+
+   // Owned, NULL terminated copy of the arguments in one allocation
+   cline_utils::ArgvBuilder arguments(argc, argv);
+   _G_argc = arguments.argc();
+   _G_argv = arguments.argv();
+
+   // Creat the command line parser
+   _G_cline = new cline_utils::CommandLineParser(_G_argc, _G_argv);
+
+   // Call potential tests
+   int result = Catch::Session().run();
+
+   // Clean up memory
+   delete _G_cline;
+
+   //std::cout << "-- END runCatchTests --" << std::endl;
+
+   // Return to main
+   return result;
+}
+
+/************************************************************************/
+/*
+* \brief Main function not built into Catch2...
+*
+*     @return int.
+* 
+*/
+int main(int argc, char* const argv[])
+{
+   return runCatchTests(argc, argv);
+}
\ No newline at end of file